@@ -0,0 +1,85 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef LEVIATHAN_BASE_ALIGNED_ALLOCATOR_H_
+#define LEVIATHAN_BASE_ALIGNED_ALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include "leviathan/base/config.h"
+
+namespace leviathan::memory
+{
+    /**
+     * @brief Standard allocator that aligns every allocation to `Alignment` bytes.
+     *
+     * Used for buffers that are scanned with vector loads or that must not share a cache line
+     * with neighbouring data. Defaults to the cache line size.
+     */
+    template <typename T, std::size_t Alignment = LEVIATHAN_CACHE_LINE_SIZE>
+    class AlignedAllocator
+    {
+        static_assert(Alignment >= alignof(T), "Alignment must not be weaker than the alignment of T.");
+        static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two.");
+
+    public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template <typename U>
+        constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+        {
+        }
+
+        [[nodiscard]] T* allocate(const std::size_t n)
+        {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+        }
+
+        void deallocate(T* p, const std::size_t n) noexcept
+        {
+            ::operator delete(p, n * sizeof(T), std::align_val_t{Alignment});
+        }
+
+        template <typename U>
+        friend constexpr bool operator==(const AlignedAllocator&, const AlignedAllocator<U, Alignment>&) noexcept
+        {
+            return true;
+        }
+    };
+
+    /**
+     * @brief A std::vector whose buffer starts on a cache line boundary.
+     */
+    template <typename T>
+    using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+}
+
+#endif // LEVIATHAN_BASE_ALIGNED_ALLOCATOR_H_
@@ -0,0 +1,50 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <numeric>
+#include "leviathan/base/aligned_allocator.h"
+
+TEST(AlignedAllocatorTest, BufferStartsOnCacheLine) {
+    for (size_t size = 1; size < 100; size += 7) {
+        leviathan::memory::AlignedVector<double> values(size);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(values.data()) % LEVIATHAN_CACHE_LINE_SIZE, 0U);
+    }
+}
+
+TEST(AlignedAllocatorTest, HonorsCustomAlignment) {
+    std::vector<char, leviathan::memory::AlignedAllocator<char, 256>> bytes(3);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(bytes.data()) % 256, 0U);
+}
+
+TEST(AlignedAllocatorTest, BehavesLikeAVector) {
+    leviathan::memory::AlignedVector<int> values;
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(i);
+    }
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(values.data()) % LEVIATHAN_CACHE_LINE_SIZE, 0U);
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 999 * 1000 / 2);
+
+    const leviathan::memory::AlignedVector<int> copy = values;
+    EXPECT_EQ(copy, values);
+}
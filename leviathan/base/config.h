@@ -106,6 +106,31 @@
     #define LEVIATHAN_UNLIKELY(x) (x)
 #endif
 
+// Cache Line Size
+// Used to pad data shared between threads and avoid false sharing.
+#ifndef LEVIATHAN_CACHE_LINE_SIZE
+    #define LEVIATHAN_CACHE_LINE_SIZE 64
+#endif
+
+// Target Architecture
+#if defined(__x86_64__) || defined(_M_X64) || defined(_M_AMD64)
+    #define LEVIATHAN_ARCH_X86_64 1
+#else
+    #define LEVIATHAN_ARCH_X86_64 0
+#endif
+
+// Per-function instruction set targets
+// Lets a single function use AVX2/AVX-512 intrinsics without compiling the whole translation
+// unit for that instruction set; callers must check CPU support at runtime first.
+// MSVC accepts the intrinsics without any annotation.
+#if LEVIATHAN_ARCH_X86_64 && (defined(__GNUC__) || defined(__clang__))
+    #define LEVIATHAN_TARGET_AVX2 __attribute__((target("avx2")))
+    #define LEVIATHAN_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+    #define LEVIATHAN_TARGET_AVX2
+    #define LEVIATHAN_TARGET_AVX512
+#endif
+
 #if !defined(LEVIATHAN_SYMBOL_EXPORT) && !defined(LEVIATHAN_SYMBOL_IMPORT) && !defined(LEVIATHAN_SYMBOL_LOCAL)
     #if defined(_WIN32) || defined(__CYGWIN__)
         #define LEVIATHAN_SYMBOL_EXPORT __declspec(dllexport)
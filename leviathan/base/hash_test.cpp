@@ -0,0 +1,40 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <unordered_set>
+#include "leviathan/base/hash.h"
+
+TEST(HashTest, MatchesSplitMix64) {
+    // The first outputs of the reference splitmix64 generator seeded with 0.
+    EXPECT_EQ(leviathan::hash::mix64(leviathan::hash::kGoldenGamma), 0xe220a8397b1dcdafULL);
+    EXPECT_EQ(leviathan::hash::mix64(2 * leviathan::hash::kGoldenGamma), 0x6e789e6aa1b965f4ULL);
+    static_assert(leviathan::hash::mix64(0) == 0);
+}
+
+TEST(HashTest, DistinctInputsGiveDistinctOutputs) {
+    std::unordered_set<std::uint64_t> seen;
+    for (std::uint64_t x = 0; x < 10000; ++x) {
+        EXPECT_TRUE(seen.insert(leviathan::hash::mix64(x)).second);
+    }
+}
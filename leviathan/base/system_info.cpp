@@ -20,6 +20,16 @@
 // WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "leviathan/base/system_info.h"
+#include "leviathan/base/config.h"
+
+#if LEVIATHAN_ARCH_X86_64
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -120,5 +130,90 @@ namespace leviathan::system
         return 0;
     }
 
+#endif
+
+#if LEVIATHAN_ARCH_X86_64
+
+    namespace
+    {
+        void cpuid(const int leaf, const int subleaf, unsigned (&regs)[4])
+        {
+#if defined(_MSC_VER)
+            int out[4];
+            __cpuidex(out, leaf, subleaf);
+            for (int i = 0; i < 4; ++i)
+            {
+                regs[i] = static_cast<unsigned>(out[i]);
+            }
+#else
+            __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+        }
+
+        unsigned long long xgetbv0()
+        {
+#if defined(_MSC_VER)
+            return _xgetbv(0);
+#else
+            unsigned eax = 0;
+            unsigned edx = 0;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+        }
+
+        SimdLevel detect_simd_level()
+        {
+            unsigned regs[4];
+            cpuid(0, 0, regs);
+            if (regs[0] < 7)
+            {
+                return SimdLevel::kScalar;
+            }
+
+            // The OS must save the vector registers on context switches (OSXSAVE + XCR0).
+            cpuid(1, 0, regs);
+            constexpr unsigned kOsxsave = 1u << 27;
+            constexpr unsigned kAvx = 1u << 28;
+            if ((regs[2] & kOsxsave) == 0 || (regs[2] & kAvx) == 0)
+            {
+                return SimdLevel::kScalar;
+            }
+            const unsigned long long xcr0 = xgetbv0();
+            constexpr unsigned long long kYmmState = 0x6;
+            constexpr unsigned long long kZmmState = 0xE6;
+            if ((xcr0 & kYmmState) != kYmmState)
+            {
+                return SimdLevel::kScalar;
+            }
+
+            cpuid(7, 0, regs);
+            constexpr unsigned kAvx2 = 1u << 5;
+            constexpr unsigned kAvx512F = 1u << 16;
+            if ((regs[1] & kAvx512F) != 0 && (xcr0 & kZmmState) == kZmmState)
+            {
+                return SimdLevel::kAvx512;
+            }
+            if ((regs[1] & kAvx2) != 0)
+            {
+                return SimdLevel::kAvx2;
+            }
+            return SimdLevel::kScalar;
+        }
+    }
+
+    SimdLevel get_simd_level()
+    {
+        static const SimdLevel level = detect_simd_level();
+        return level;
+    }
+
+#else
+
+    SimdLevel get_simd_level()
+    {
+        return SimdLevel::kScalar;
+    }
+
 #endif
 } // namespace kalix::system
\ No newline at end of file
@@ -32,6 +32,23 @@ namespace leviathan::system
      * @return The memory usage in bytes, or 0 if the system call fails.
      */
     [[nodiscard]] size_t get_process_memory_usage();
+
+    /**
+     * @brief The widest x86 vector instruction set usable on this machine.
+     */
+    enum class SimdLevel
+    {
+        kScalar,
+        kAvx2,
+        kAvx512,
+    };
+
+    /**
+     * @brief Returns the widest vector instruction set supported by both the CPU and the OS.
+     *
+     * The result is detected once and cached. Always kScalar on non-x86-64 targets.
+     */
+    [[nodiscard]] SimdLevel get_simd_level();
 }
 
 #endif // LEVIATHAN_BASE_SYSTEM_INFO_H_
\ No newline at end of file
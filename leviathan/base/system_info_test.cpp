@@ -22,6 +22,7 @@
 #include <gtest/gtest.h>
 #include <vector>
 #include <algorithm>
+#include "leviathan/base/config.h"
 #include "leviathan/base/system_info.h"
 
 TEST(SystemInfoTest, ReturnsNonZeroMemoryUsage) {
@@ -59,4 +60,12 @@ TEST(SystemInfoTest, DetectsMemoryIncrease) {
     // overhead from the vector class and GTest internals makes it fuzzy.
     EXPECT_GE(spiked_memory, initial_memory)
         << "Memory usage did not increase after allocating 10MB.";
-}
\ No newline at end of file
+}
+
+TEST(SystemInfoTest, SimdLevelIsStable) {
+    const leviathan::system::SimdLevel level = leviathan::system::get_simd_level();
+    EXPECT_EQ(leviathan::system::get_simd_level(), level);
+#if !LEVIATHAN_ARCH_X86_64
+    EXPECT_EQ(level, leviathan::system::SimdLevel::kScalar);
+#endif
+}
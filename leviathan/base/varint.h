@@ -0,0 +1,109 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef LEVIATHAN_BASE_VARINT_H_
+#define LEVIATHAN_BASE_VARINT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace leviathan::varint
+{
+    /**
+     * @brief The longest encoding of a 64-bit value.
+     */
+    inline constexpr std::size_t kMaxBytes = 10;
+
+    /**
+     * @brief Maps signed values to unsigned ones so that small magnitudes stay small (0, -1, 1, -2, ...).
+     */
+    [[nodiscard]] constexpr std::uint64_t zigzag_encode(const std::int64_t value) noexcept
+    {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    /**
+     * @brief Inverse of zigzag_encode().
+     */
+    [[nodiscard]] constexpr std::int64_t zigzag_decode(const std::uint64_t value) noexcept
+    {
+        return static_cast<std::int64_t>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    /**
+     * @brief Returns the number of bytes encode() writes for `value`.
+     */
+    [[nodiscard]] constexpr std::size_t encoded_size(std::uint64_t value) noexcept
+    {
+        std::size_t size = 1;
+        for (; value >= 0x80; value >>= 7)
+        {
+            ++size;
+        }
+        return size;
+    }
+
+    /**
+     * @brief Writes `value` as a LEB128 varint, seven bits per byte, low bits first.
+     *
+     * The caller guarantees room for encoded_size(value) bytes at `out`.
+     *
+     * @return The number of bytes written.
+     */
+    inline std::size_t encode(std::uint64_t value, std::byte* out) noexcept
+    {
+        std::size_t size = 0;
+        for (; value >= 0x80; value >>= 7)
+        {
+            out[size++] = static_cast<std::byte>(value | 0x80);
+        }
+        out[size++] = static_cast<std::byte>(value);
+        return size;
+    }
+
+    /**
+     * @brief Reads a varint from [cursor, end) and advances `cursor` past it.
+     *
+     * @return false if the input ends inside the varint or the varint is longer than kMaxBytes.
+     */
+    [[nodiscard]] inline bool decode(const std::byte*& cursor, const std::byte* const end,
+                                     std::uint64_t& value) noexcept
+    {
+        const std::size_t limit = end - cursor < static_cast<std::ptrdiff_t>(kMaxBytes)
+                                      ? static_cast<std::size_t>(end - cursor)
+                                      : kMaxBytes;
+        value = 0;
+        for (std::size_t i = 0; i < limit; ++i)
+        {
+            const auto byte = static_cast<std::uint64_t>(cursor[i]);
+            value |= (byte & 0x7f) << (7 * i);
+            if ((byte & 0x80) == 0)
+            {
+                cursor += i + 1;
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+#endif // LEVIATHAN_BASE_VARINT_H_
@@ -0,0 +1,78 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "leviathan/base/varint.h"
+
+TEST(VarintTest, ZigzagKeepsSmallMagnitudesSmall) {
+    static_assert(leviathan::varint::zigzag_encode(0) == 0);
+    static_assert(leviathan::varint::zigzag_encode(-1) == 1);
+    static_assert(leviathan::varint::zigzag_encode(1) == 2);
+    static_assert(leviathan::varint::zigzag_encode(-2) == 3);
+    for (const std::int64_t value : {std::int64_t{0}, std::int64_t{-1}, std::int64_t{12345}, std::int64_t{-98765},
+                                     std::numeric_limits<std::int64_t>::min(),
+                                     std::numeric_limits<std::int64_t>::max()}) {
+        EXPECT_EQ(leviathan::varint::zigzag_decode(leviathan::varint::zigzag_encode(value)), value);
+    }
+}
+
+TEST(VarintTest, RoundTrip) {
+    const std::vector<std::uint64_t> values = {0, 1, 127, 128, 300, 16383, 16384, 1ULL << 35,
+                                               std::numeric_limits<std::uint64_t>::max()};
+    std::vector<std::byte> buffer(values.size() * leviathan::varint::kMaxBytes);
+    std::size_t written = 0;
+    for (const std::uint64_t value : values) {
+        const std::size_t size = leviathan::varint::encode(value, buffer.data() + written);
+        EXPECT_EQ(size, leviathan::varint::encoded_size(value));
+        written += size;
+    }
+    EXPECT_EQ(leviathan::varint::encoded_size(127), 1u);
+    EXPECT_EQ(leviathan::varint::encoded_size(128), 2u);
+    EXPECT_EQ(leviathan::varint::encoded_size(std::numeric_limits<std::uint64_t>::max()),
+              leviathan::varint::kMaxBytes);
+
+    const std::byte* cursor = buffer.data();
+    for (const std::uint64_t value : values) {
+        std::uint64_t decoded = 0;
+        ASSERT_TRUE(leviathan::varint::decode(cursor, buffer.data() + written, decoded));
+        EXPECT_EQ(decoded, value);
+    }
+    EXPECT_EQ(cursor, buffer.data() + written);
+}
+
+TEST(VarintTest, DecodeRejectsTruncatedAndOverlongInput) {
+    const std::array<std::byte, 2> truncated = {std::byte{0x80}, std::byte{0x80}};
+    const std::byte* cursor = truncated.data();
+    std::uint64_t value = 0;
+    EXPECT_FALSE(leviathan::varint::decode(cursor, truncated.data() + truncated.size(), value));
+    EXPECT_EQ(cursor, truncated.data());
+
+    std::array<std::byte, 11> overlong{};
+    overlong.fill(std::byte{0x80});
+    cursor = overlong.data();
+    EXPECT_FALSE(leviathan::varint::decode(cursor, overlong.data() + overlong.size(), value));
+}
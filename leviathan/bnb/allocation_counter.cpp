@@ -0,0 +1,164 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "leviathan/bnb/allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+namespace
+{
+    std::atomic<std::uint64_t> g_allocated_bytes{0};
+    std::atomic<std::uint64_t> g_allocation_count{0};
+
+    void* counted_allocate(std::size_t size) noexcept
+    {
+        g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+        g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void* counted_allocate_aligned(std::size_t size, const std::align_val_t alignment) noexcept
+    {
+        g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+        g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+        const auto align = static_cast<std::size_t>(alignment);
+        const std::size_t rounded = (size + align - 1) / align * align;
+#if defined(_MSC_VER)
+        return _aligned_malloc(rounded == 0 ? align : rounded, align);
+#else
+        return std::aligned_alloc(align, rounded == 0 ? align : rounded);
+#endif
+    }
+
+    void counted_free_aligned(void* ptr) noexcept
+    {
+#if defined(_MSC_VER)
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+
+    [[noreturn]] void out_of_memory() noexcept
+    {
+        std::abort();
+    }
+}
+
+namespace leviathan::bnb::testing
+{
+    std::uint64_t allocated_bytes() noexcept
+    {
+        return g_allocated_bytes.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t allocation_count() noexcept
+    {
+        return g_allocation_count.load(std::memory_order_relaxed);
+    }
+}
+
+// The project builds without exceptions, so allocation failure aborts instead of throwing.
+
+void* operator new(const std::size_t size)
+{
+    void* ptr = counted_allocate(size);
+    if (ptr == nullptr)
+    {
+        out_of_memory();
+    }
+    return ptr;
+}
+
+void* operator new[](const std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_allocate(size);
+}
+
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_allocate(size);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment)
+{
+    void* ptr = counted_allocate_aligned(size, alignment);
+    if (ptr == nullptr)
+    {
+        out_of_memory();
+    }
+    return ptr;
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::align_val_t) noexcept
+{
+    counted_free_aligned(ptr);
+}
+
+void operator delete[](void* ptr, const std::align_val_t) noexcept
+{
+    counted_free_aligned(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, const std::align_val_t) noexcept
+{
+    counted_free_aligned(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, const std::align_val_t) noexcept
+{
+    counted_free_aligned(ptr);
+}
@@ -0,0 +1,39 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_ALLOCATION_COUNTER_H_
+#define LEVIATHAN_BNB_ALLOCATION_COUNTER_H_
+
+#include <cstdint>
+
+namespace leviathan::bnb::testing
+{
+    /// \brief Returns the number of bytes requested from the global operator new so far.
+    ///
+    /// Linking allocation_counter.cpp replaces the global allocation functions with counting
+    /// versions; the counter is shared by all threads and never decreases.
+    [[nodiscard]] std::uint64_t allocated_bytes() noexcept;
+
+    /// \brief Returns the number of calls to the global operator new so far.
+    [[nodiscard]] std::uint64_t allocation_count() noexcept;
+}
+
+#endif // LEVIATHAN_BNB_ALLOCATION_COUNTER_H_
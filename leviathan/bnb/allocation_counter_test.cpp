@@ -0,0 +1,72 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "leviathan/bnb/allocation_counter.h"
+
+using leviathan::bnb::testing::allocated_bytes;
+using leviathan::bnb::testing::allocation_count;
+
+TEST(AllocationCounterTest, CountsVectorGrowth)
+{
+    const uint64_t bytes = allocated_bytes();
+    const uint64_t count = allocation_count();
+
+    std::vector<int64_t> values;
+    values.reserve(1000);
+    ASSERT_NE(values.data(), nullptr);
+
+    EXPECT_GE(allocated_bytes() - bytes, 1000 * sizeof(int64_t));
+    EXPECT_GE(allocation_count() - count, 1u);
+}
+
+TEST(AllocationCounterTest, CountsOverAlignedAllocations)
+{
+    struct alignas(128) Aligned
+    {
+        char data[128];
+    };
+
+    const uint64_t bytes = allocated_bytes();
+    const auto ptr = std::make_unique<Aligned>();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr.get()) % 128, 0u);
+    EXPECT_GE(allocated_bytes() - bytes, sizeof(Aligned));
+}
+
+TEST(AllocationCounterTest, ReusingCapacityAllocatesNothing)
+{
+    std::vector<int64_t> values;
+    values.reserve(64);
+    const uint64_t bytes = allocated_bytes();
+
+    for (int round = 0; round < 10; ++round)
+    {
+        values.clear();
+        for (int64_t i = 0; i < 64; ++i)
+        {
+            values.push_back(i);
+        }
+    }
+    EXPECT_EQ(allocated_bytes(), bytes);
+}
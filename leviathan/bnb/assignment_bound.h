@@ -0,0 +1,527 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef LEVIATHAN_BNB_ASSIGNMENT_BOUND_H_
+#define LEVIATHAN_BNB_ASSIGNMENT_BOUND_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+#include "leviathan/bnb/problem.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/search_trail.h"
+#include "leviathan/bnb/shared_incumbent.h"
+
+namespace leviathan::bnb
+{
+    /// \brief The restoration entry recorded by AssignmentBound for every changed value.
+    ///
+    /// `field` selects which value `index` refers to; duals restore `old_dual`, matchings
+    /// restore `old_match`.
+    template <typename IndexType, typename CostType>
+    struct AssignmentBoundUndo
+    {
+        enum class Field : std::uint8_t
+        {
+            kValue,
+            kRowDual,
+            kColumnDual,
+            kRowMatch,
+            kColumnMatch,
+        };
+
+        Field field;
+        IndexType index;
+        CostType old_dual;
+        IndexType old_match;
+    };
+
+    /// \brief Assignment relaxation lower bound on the cost of the unassigned vessels.
+    ///
+    /// Every berth b offers one slot per position k = 0, 1, ... of the vessels still to be
+    /// served there. The k-th of them cannot start before `berth_free_times[b] + k * p_b`, where
+    /// p_b is the shortest processing time of any vessel on b, so matching each unassigned
+    /// vessel to a distinct slot at the cost of its earliest finish in that slot relaxes the
+    /// remaining schedule. Availability windows only delay vessels and are ignored. The bound
+    /// is the value of the dual solution of the minimum cost matching.
+    ///
+    /// Along a search path, berth free times only grow, so slot costs only grow and the dual
+    /// potentials stay feasible. apply_move therefore keeps them and only repairs what the
+    /// move broke: the slot of the assigned vessel is released and vessels whose slot on the
+    /// changed berth is no longer tight are unmatched, after which each of them is rematched
+    /// with one shortest augmenting path. Every changed dual and matching entry is recorded on
+    /// an internal SearchTrail, so backtrack_move restores the previous solution exactly.
+    ///
+    /// As a NodeBound, the bound re-solves the relaxation on the root of every search and then
+    /// follows the solver's moves with apply_move and backtrack_move, so each node only pays
+    /// for the repair.
+    ///
+    /// Weights must be non-negative.
+    template <typename TimeType, typename IndexType, typename CostType>
+    class AssignmentBound
+    {
+    public:
+        using problem_type = Problem<TimeType, IndexType, CostType>;
+        using state_type = SearchState<TimeType, IndexType, CostType>;
+        using undo_type = AssignmentBoundUndo<IndexType, CostType>;
+        using trail_type = SearchTrail<undo_type>;
+        using move_type = SearchMove<TimeType, IndexType, CostType>;
+        using search_undo_type = SearchUndo<TimeType, IndexType, CostType>;
+        using incumbent_type = SharedIncumbent<TimeType, IndexType, CostType>;
+
+        static constexpr IndexType kUnmatched = -1;
+
+        /// \brief Allocates the bound without solving it; reset() or bound_root() must come first.
+        ///
+        /// \param problem The problem instance. Must outlive the bound.
+        explicit AssignmentBound(const problem_type& problem)
+            : problem_(&problem),
+              num_vessels_(problem.num_vessels()),
+              num_columns_(problem.num_vessels() * problem.num_berths()),
+              trail_(4 * (problem.num_vessels() + num_columns_), problem.num_vessels())
+        {
+            DCHECK(num_vessels_ == 0 || problem.num_berths() > 0);
+
+            min_berth_processing_.assign(problem.num_berths(), 0);
+            for (size_t b = 0; b < problem.num_berths(); ++b)
+            {
+                TimeType shortest = std::numeric_limits<TimeType>::max();
+                for (size_t v = 0; v < num_vessels_; ++v)
+                {
+                    shortest = std::min(shortest, problem.processing_time(static_cast<IndexType>(v),
+                                                                          static_cast<IndexType>(b)));
+                }
+                min_berth_processing_[b] = num_vessels_ == 0 ? TimeType{0} : shortest;
+            }
+
+            row_duals_.assign(num_vessels_, 0);
+            column_duals_.assign(num_columns_, 0);
+            column_of_row_.assign(num_vessels_, kUnmatched);
+            row_of_column_.assign(num_columns_, kUnmatched);
+            shortest_.resize(num_columns_);
+            path_.resize(num_columns_);
+            remaining_.resize(num_columns_);
+            visited_rows_.reserve(num_vessels_);
+            visited_columns_.reserve(num_columns_);
+            pending_columns_.reserve(num_columns_);
+        }
+
+        /// \brief Solves the relaxation of `state` from scratch.
+        ///
+        /// \param problem The problem instance. Must outlive the bound.
+        /// \param state The state the bound starts from, usually the root.
+        AssignmentBound(const problem_type& problem, const state_type& state)
+            : AssignmentBound(problem)
+        {
+            reset(state);
+        }
+
+        // The bound owns its trail; copying would duplicate the undo history.
+        AssignmentBound(const AssignmentBound&) = delete;
+        AssignmentBound& operator=(const AssignmentBound&) = delete;
+
+        AssignmentBound(AssignmentBound&&) = default;
+        AssignmentBound& operator=(AssignmentBound&&) = default;
+
+        /// \brief Drops the undo history and solves the relaxation of `state` from scratch.
+        void reset(const state_type& state)
+        {
+            DCHECK_EQ(state.berth_free_times.size(), problem_->num_berths());
+            DCHECK_EQ(state.vessel_assignments.size(), problem_->num_vessels());
+
+            trail_.clear();
+            std::ranges::fill(row_duals_, CostType{0});
+            std::ranges::fill(column_duals_, CostType{0});
+            std::ranges::fill(column_of_row_, kUnmatched);
+            std::ranges::fill(row_of_column_, kUnmatched);
+            state.for_each_unassigned([&](const IndexType v)
+            {
+                augment(state, v);
+            });
+            value_ = compute_value(state);
+        }
+
+        /// \brief Updates the bound after `state.apply_move` assigned `v_idx` to `b_idx`.
+        ///
+        /// Opens a new trail frame holding the undo entries of this update.
+        void apply_move(const state_type& state, const IndexType v_idx, const IndexType b_idx)
+        {
+            DCHECK(state.is_assigned(v_idx));
+            DCHECK_EQ(state.get_assigned_berth(v_idx), b_idx);
+
+            trail_.push_frame();
+            trail_.emplace(undo_type{undo_type::Field::kValue, 0, value_, kUnmatched});
+
+            // The assigned vessel leaves the relaxation and frees its slot.
+            const IndexType freed = column_of_row_[v_idx];
+            if (freed != kUnmatched)
+            {
+                unmatch(v_idx, freed);
+                release_column(state, freed);
+            }
+
+            // The slots of the berth got more expensive; matches that are no longer tight are undone.
+            const size_t first = static_cast<size_t>(b_idx) * num_vessels_;
+            for (size_t j = first; j < first + num_vessels_; ++j)
+            {
+                const IndexType row = row_of_column_[j];
+                if (row != kUnmatched && reduced_cost(state, row, j) > CostType{0})
+                {
+                    unmatch(row, static_cast<IndexType>(j));
+                    release_column(state, j);
+                }
+            }
+
+            for (size_t v = 0; v < num_vessels_; ++v)
+            {
+                const auto row = static_cast<IndexType>(v);
+                if (!state.is_assigned(row) && column_of_row_[v] == kUnmatched)
+                {
+                    augment(state, row);
+                }
+            }
+            value_ = compute_value(state);
+        }
+
+        /// \brief Reverts the most recent apply_move.
+        LEVIATHAN_FORCE_INLINE void backtrack_move()
+        {
+            trail_.backtrack([this](const undo_type& undo)
+            {
+                restore(undo);
+            });
+        }
+
+        /// \brief Returns the lower bound on the cost still to be added by the unassigned vessels.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType value() const noexcept
+        {
+            return value_;
+        }
+
+        /// \brief Returns `state.current_objective` plus value().
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType lower_bound(const state_type& state) const noexcept
+        {
+            return state.current_objective + value_;
+        }
+
+        /// \name NodeBound hooks
+        /// @{
+
+        /// \brief Re-solves the relaxation for the root of a search.
+        CostType bound_root(const state_type& state, const incumbent_type&)
+        {
+            reset(state);
+            return lower_bound(state);
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType bound_node(const state_type& state, const CostType) const noexcept
+        {
+            return lower_bound(state);
+        }
+
+        LEVIATHAN_FORCE_INLINE void notify_apply(const state_type& state, const move_type& move)
+        {
+            apply_move(state, move.vessel, move.berth);
+        }
+
+        LEVIATHAN_FORCE_INLINE void notify_backtrack(const state_type&, const search_undo_type&)
+        {
+            backtrack_move();
+        }
+
+        /// @}
+
+        /// \brief Returns the slot (berth * num_vessels + position) matched to an unassigned vessel.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE IndexType matched_slot(const IndexType v_idx) const
+        {
+            DCHECK_GE(v_idx, 0);
+            DCHECK_LT(static_cast<size_t>(v_idx), num_vessels_);
+            return column_of_row_[v_idx];
+        }
+
+        /// \brief Returns the undo trail of the bound.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const trail_type& trail() const noexcept
+        {
+            return trail_;
+        }
+
+        /// \brief Returns the total bytes allocated (capacity) by the bound.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_t allocated_memory_bytes() const noexcept
+        {
+            return trail_.allocated_memory_bytes() +
+                (row_duals_.capacity() + column_duals_.capacity() + shortest_.capacity()) * sizeof(CostType) +
+                (column_of_row_.capacity() + row_of_column_.capacity() + path_.capacity() +
+                    visited_rows_.capacity() + visited_columns_.capacity()) * sizeof(IndexType) +
+                (remaining_.capacity() + pending_columns_.capacity()) * sizeof(size_t) +
+                min_berth_processing_.capacity() * sizeof(TimeType);
+        }
+
+    private:
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType slot_cost(const state_type& state, const IndexType row,
+                                                                const size_t column) const
+        {
+            const size_t berth = column / num_vessels_;
+            const size_t position = column % num_vessels_;
+            const TimeType earliest = state.berth_free_times[berth] +
+                static_cast<TimeType>(position) * min_berth_processing_[berth];
+            const TimeType start = std::max(earliest, problem_->ready_time(row));
+            return problem_->cost(row, start + problem_->processing_time(row, static_cast<IndexType>(berth)));
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType reduced_cost(const state_type& state, const IndexType row,
+                                                                   const size_t column) const
+        {
+            return slot_cost(state, row, column) - row_duals_[row] - column_duals_[column];
+        }
+
+        LEVIATHAN_FORCE_INLINE void set_row_dual(const IndexType row, const CostType dual)
+        {
+            if (!trail_.empty())
+            {
+                trail_.emplace(undo_type{undo_type::Field::kRowDual, row, row_duals_[row], kUnmatched});
+            }
+            row_duals_[row] = dual;
+        }
+
+        LEVIATHAN_FORCE_INLINE void set_column_dual(const size_t column, const CostType dual)
+        {
+            if (!trail_.empty())
+            {
+                trail_.emplace(undo_type{undo_type::Field::kColumnDual, static_cast<IndexType>(column),
+                                         column_duals_[column], kUnmatched});
+            }
+            column_duals_[column] = dual;
+        }
+
+        LEVIATHAN_FORCE_INLINE void match(const IndexType row, const IndexType column)
+        {
+            if (!trail_.empty())
+            {
+                trail_.emplace(undo_type{undo_type::Field::kRowMatch, row, CostType{0}, column_of_row_[row]});
+                trail_.emplace(undo_type{undo_type::Field::kColumnMatch, column, CostType{0}, row_of_column_[column]});
+            }
+            column_of_row_[row] = column;
+            row_of_column_[column] = row;
+        }
+
+        LEVIATHAN_FORCE_INLINE void unmatch(const IndexType row, const IndexType column)
+        {
+            if (!trail_.empty())
+            {
+                trail_.emplace(undo_type{undo_type::Field::kRowMatch, row, CostType{0}, column});
+                trail_.emplace(undo_type{undo_type::Field::kColumnMatch, column, CostType{0}, row});
+            }
+            column_of_row_[row] = kUnmatched;
+            row_of_column_[column] = kUnmatched;
+        }
+
+        LEVIATHAN_FORCE_INLINE void restore(const undo_type& undo) noexcept
+        {
+            switch (undo.field)
+            {
+            case undo_type::Field::kValue:
+                value_ = undo.old_dual;
+                break;
+            case undo_type::Field::kRowDual:
+                row_duals_[undo.index] = undo.old_dual;
+                break;
+            case undo_type::Field::kColumnDual:
+                column_duals_[undo.index] = undo.old_dual;
+                break;
+            case undo_type::Field::kRowMatch:
+                column_of_row_[undo.index] = undo.old_match;
+                break;
+            case undo_type::Field::kColumnMatch:
+                row_of_column_[undo.index] = undo.old_match;
+                break;
+            }
+        }
+
+        /// \brief Restores the invariant that a free slot has a zero dual.
+        ///
+        /// Raising the dual of a slot may make it cheaper than the current match of some vessels.
+        /// Their duals are lowered to stay feasible, which in turn unmatches them and frees their
+        /// slots, so the repair cascades until no more slots are affected.
+        void release_column(const state_type& state, const size_t column)
+        {
+            pending_columns_.push_back(column);
+            while (!pending_columns_.empty())
+            {
+                const size_t j = pending_columns_.back();
+                pending_columns_.pop_back();
+                if (column_duals_[j] == CostType{0})
+                {
+                    continue;
+                }
+
+                set_column_dual(j, CostType{0});
+                for (size_t v = 0; v < num_vessels_; ++v)
+                {
+                    const auto row = static_cast<IndexType>(v);
+                    if (state.is_assigned(row))
+                    {
+                        continue;
+                    }
+                    const CostType cost = slot_cost(state, row, j);
+                    if (row_duals_[v] > cost)
+                    {
+                        set_row_dual(row, cost);
+                        const IndexType matched = column_of_row_[v];
+                        if (matched != kUnmatched)
+                        {
+                            unmatch(row, matched);
+                            pending_columns_.push_back(static_cast<size_t>(matched));
+                        }
+                    }
+                }
+            }
+        }
+
+        /// \brief Matches a free vessel along a shortest augmenting path (Dijkstra on reduced costs).
+        void augment(const state_type& state, const IndexType source)
+        {
+            constexpr CostType kInfinity = std::numeric_limits<CostType>::max();
+
+            for (size_t j = 0; j < num_columns_; ++j)
+            {
+                remaining_[j] = j;
+            }
+            std::fill(shortest_.begin(), shortest_.end(), kInfinity);
+            visited_rows_.clear();
+            visited_columns_.clear();
+
+            size_t num_remaining = num_columns_;
+            CostType distance = 0;
+            IndexType row = source;
+            IndexType sink = kUnmatched;
+            while (sink == kUnmatched)
+            {
+                DCHECK_GT(num_remaining, 0u);
+                visited_rows_.push_back(row);
+
+                size_t best = 0;
+                CostType lowest = kInfinity;
+                for (size_t i = 0; i < num_remaining; ++i)
+                {
+                    const size_t j = remaining_[i];
+                    const CostType candidate = distance + reduced_cost(state, row, j);
+                    if (candidate < shortest_[j])
+                    {
+                        path_[j] = row;
+                        shortest_[j] = candidate;
+                    }
+                    // On ties, prefer a free slot: it ends the path.
+                    if (shortest_[j] < lowest || (shortest_[j] == lowest && row_of_column_[j] == kUnmatched))
+                    {
+                        lowest = shortest_[j];
+                        best = i;
+                    }
+                }
+
+                distance = lowest;
+                const size_t column = remaining_[best];
+                remaining_[best] = remaining_[--num_remaining];
+                visited_columns_.push_back(static_cast<IndexType>(column));
+                if (row_of_column_[column] == kUnmatched)
+                {
+                    sink = static_cast<IndexType>(column);
+                }
+                else
+                {
+                    row = row_of_column_[column];
+                }
+            }
+
+            set_row_dual(source, row_duals_[source] + distance);
+            for (size_t i = 1; i < visited_rows_.size(); ++i)
+            {
+                const IndexType r = visited_rows_[i];
+                set_row_dual(r, row_duals_[r] + distance - shortest_[column_of_row_[r]]);
+            }
+            for (const IndexType column : visited_columns_)
+            {
+                if (shortest_[column] != distance)
+                {
+                    set_column_dual(column, column_duals_[column] - (distance - shortest_[column]));
+                }
+            }
+
+            IndexType column = sink;
+            while (true)
+            {
+                const IndexType r = path_[column];
+                const IndexType previous = column_of_row_[r];
+                match(r, column);
+                if (r == source)
+                {
+                    break;
+                }
+                column = previous;
+            }
+        }
+
+        [[nodiscard]] CostType compute_value(const state_type& state) const
+        {
+            CostType value = 0;
+            for (size_t v = 0; v < num_vessels_; ++v)
+            {
+                if (!state.is_assigned(static_cast<IndexType>(v)))
+                {
+                    value += row_duals_[v];
+                }
+            }
+            for (const CostType dual : column_duals_)
+            {
+                value += dual;
+            }
+            return value;
+        }
+
+        const problem_type* problem_;
+        size_t num_vessels_;
+        size_t num_columns_;
+        std::vector<TimeType> min_berth_processing_;
+
+        // Dual potentials and the matching between vessels (rows) and slots (columns).
+        std::vector<CostType> row_duals_;
+        std::vector<CostType> column_duals_;
+        std::vector<IndexType> column_of_row_;
+        std::vector<IndexType> row_of_column_;
+        CostType value_ = 0;
+
+        trail_type trail_;
+
+        // Scratch buffers of the augmenting path search, allocated once.
+        std::vector<CostType> shortest_;
+        std::vector<IndexType> path_;
+        std::vector<size_t> remaining_;
+        std::vector<IndexType> visited_rows_;
+        std::vector<IndexType> visited_columns_;
+        std::vector<size_t> pending_columns_;
+    };
+}
+
+#endif // LEVIATHAN_BNB_ASSIGNMENT_BOUND_H_
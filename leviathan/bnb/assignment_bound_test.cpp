@@ -0,0 +1,155 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <random>
+#include <vector>
+#include "leviathan/bnb/assignment_bound.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/search_trail.h"
+#include "leviathan/bnb/test_util.h"
+
+using namespace leviathan::bnb::testing;
+
+namespace
+{
+    using State = leviathan::bnb::SearchState<Time, Index, Cost>;
+    using Bound = leviathan::bnb::AssignmentBound<Time, Index, Cost>;
+    using Move = leviathan::bnb::SearchMove<Time, Index, Cost>;
+    using Trail = leviathan::bnb::SearchTrail<leviathan::bnb::SearchUndo<Time, Index, Cost>>;
+}
+
+TEST(AssignmentBoundTest, MatchesHandComputedRelaxation)
+{
+    // One berth with slots starting at 0 and 0 + 3 (shortest processing time). Either order
+    // costs 3 + 8 = 11, which the relaxation finds exactly.
+    const TestProblem problem({0, 0}, {1.0, 1.0}, {3, 5}, {{{0, 1000}}});
+    const State state(problem.num_berths(), problem.num_vessels());
+    const Bound bound(problem, state);
+
+    EXPECT_DOUBLE_EQ(bound.value(), 11.0);
+    EXPECT_NE(bound.matched_slot(0), Bound::kUnmatched);
+    EXPECT_NE(bound.matched_slot(1), Bound::kUnmatched);
+    EXPECT_NE(bound.matched_slot(0), bound.matched_slot(1));
+}
+
+TEST(AssignmentBoundTest, IncrementalUpdateMatchesFreshSolve)
+{
+    std::mt19937 rng(7);
+    for (uint32_t seed = 0; seed < 20; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 9, 3);
+        State state(problem.num_berths(), problem.num_vessels());
+        Bound bound(problem, state);
+        Trail trail;
+
+        while (const std::optional<Move> move = random_move(problem, state, rng))
+        {
+            leviathan::bnb::apply_decision(state, trail, *move);
+            bound.apply_move(state, move->vessel, move->berth);
+
+            const Bound fresh(problem, state);
+            EXPECT_NEAR(bound.value(), fresh.value(), 1e-9 * std::max(1.0, fresh.value()));
+        }
+        EXPECT_NEAR(bound.value(), 0.0, 1e-9);
+    }
+}
+
+TEST(AssignmentBoundTest, BacktrackRestoresBound)
+{
+    std::mt19937 rng(11);
+    const TestProblem problem = make_random_problem(3, 10, 3);
+    State state(problem.num_berths(), problem.num_vessels());
+    Bound bound(problem, state);
+    Trail trail;
+
+    std::vector<Cost> values = {bound.value()};
+    std::vector<Index> slots;
+    for (Index v = 0; v < static_cast<Index>(problem.num_vessels()); ++v)
+    {
+        slots.push_back(bound.matched_slot(v));
+    }
+
+    while (const std::optional<Move> move = random_move(problem, state, rng))
+    {
+        leviathan::bnb::apply_decision(state, trail, *move);
+        bound.apply_move(state, move->vessel, move->berth);
+        values.push_back(bound.value());
+    }
+    EXPECT_EQ(bound.trail().depth(), problem.num_vessels());
+
+    while (!trail.empty())
+    {
+        values.pop_back();
+        leviathan::bnb::backtrack_decision(state, trail);
+        bound.backtrack_move();
+        EXPECT_EQ(bound.value(), values.back());
+    }
+    EXPECT_TRUE(bound.trail().empty());
+    for (Index v = 0; v < static_cast<Index>(problem.num_vessels()); ++v)
+    {
+        EXPECT_EQ(bound.matched_slot(v), slots[v]);
+    }
+}
+
+TEST(AssignmentBoundTest, BoundIsBelowCompletionOptimum)
+{
+    std::mt19937 rng(5);
+    for (uint32_t seed = 0; seed < 15; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 6, 2);
+        State state(problem.num_berths(), problem.num_vessels());
+        Bound bound(problem, state);
+        Trail trail;
+
+        EXPECT_LE(bound.lower_bound(state), brute_force_optimum(problem) + 1e-9);
+        while (const std::optional<Move> move = random_move(problem, state, rng))
+        {
+            leviathan::bnb::apply_decision(state, trail, *move);
+            bound.apply_move(state, move->vessel, move->berth);
+            EXPECT_LE(bound.lower_bound(state), completion_optimum(problem, state) + 1e-9);
+        }
+    }
+}
+
+TEST(AssignmentBoundTest, IsAtLeastTheTrivialBound)
+{
+    // Every vessel costs at least weight * shortest processing time in any slot.
+    for (uint32_t seed = 0; seed < 10; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 12, 4);
+        const State state(problem.num_berths(), problem.num_vessels());
+        const Bound bound(problem, state);
+
+        Cost trivial = 0.0;
+        for (Index v = 0; v < static_cast<Index>(problem.num_vessels()); ++v)
+        {
+            trivial += problem.weight(v) * static_cast<Cost>(problem.min_processing_time(v));
+        }
+        EXPECT_GE(bound.value(), trivial - 1e-9);
+    }
+}
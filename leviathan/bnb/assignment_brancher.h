@@ -0,0 +1,341 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_ASSIGNMENT_BRANCHER_H_
+#define LEVIATHAN_BNB_ASSIGNMENT_BRANCHER_H_
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+#include "leviathan/bnb/problem.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_stack.h"
+#include "leviathan/bnb/search_state.h"
+
+namespace leviathan::bnb
+{
+    /// \brief Tuning knobs of the AssignmentBrancher.
+    struct AssignmentBrancherOptions
+    {
+        /// Drop children that leave an idle gap another vessel could fill (see AssignmentBrancher).
+        bool left_shift_dominance = false;
+        /// Branch on only one member of each group of interchangeable berths and vessels (see AssignmentBrancher).
+        bool symmetry_breaking = false;
+    };
+
+    /// \brief Reference brancher for the Berth Allocation Problem.
+    ///
+    /// Generates one child for every (unassigned vessel, berth) pair. Vessels are appended
+    /// to the end of the berth's sequence and started at the earliest time the berth's
+    /// timeline admits after both the vessel's ready time and the berth's free time.
+    /// Children are sorted by lower bound, so the most promising child comes first.
+    ///
+    /// The lower bound of a child is its objective. If the state maintains the remaining cost
+    /// bound (SearchState::enable_remaining_cost_bound), the bound of the other unassigned
+    /// vessels is added on top, which costs O(1) per child.
+    ///
+    /// If any unassigned vessel has no feasible berth left, the node is a dead end
+    /// and the frame is left empty.
+    ///
+    /// Every child already starts at its earliest feasible start, so the only way to left-shift
+    /// a vessel is to fill the idle gap before it. With `left_shift_dominance`, a child that puts
+    /// vessel v on berth b at time s is dropped while the frame is generated if some other vessel
+    /// u finishes on b strictly before s and b is a berth where u finishes earliest. Serving u in
+    /// that gap first leaves v's start unchanged, does not delay u compared to any berth it could
+    /// get later, and removing u from wherever a completion put it delays nobody. So the child
+    /// that serves u on b first reaches a schedule at least as good as any completion of the
+    /// dropped child. Along a berth the filler always starts earlier than the dropped child, so
+    /// chains of dropped children end at a kept one and an optimal schedule stays reachable.
+    /// Requires non-negative weights.
+    ///
+    /// With `symmetry_breaking`, berths with equal timelines and equal processing times for every
+    /// vessel, and vessels with equal ready times, weights and processing times, are grouped at
+    /// construction. Swapping two members of a group maps schedules onto schedules of equal cost,
+    /// so branching enforces a canonical order: a berth is skipped if the previous berth of its
+    /// group is free at the same time (so only the lowest-index one of a set of equally idle
+    /// berths takes a vessel), and a vessel is skipped until the previous vessel of its group is
+    /// assigned (so interchangeable vessels are assigned in index order). Each check compares one
+    /// precomputed predecessor and costs O(1) per child. Combined with the dominance above, every
+    /// dropped child points to a kept one with an earlier start, or the same start on a lower
+    /// berth, or the same start and berth with a lower vessel index, so the filters never exclude
+    /// each other's witnesses.
+    ///
+    /// \tparam StateType The state to branch on. SearchState, or FixedSearchState for small
+    ///         instances; states without a remaining cost bound use the objective alone.
+    template <typename TimeType, typename IndexType, typename CostType,
+              typename StateType = SearchState<TimeType, IndexType, CostType>>
+    class AssignmentBrancher
+    {
+    public:
+        using problem_type = Problem<TimeType, IndexType, CostType>;
+        using state_type = StateType;
+        using move_type = SearchMove<TimeType, IndexType, CostType>;
+        using stack_type = SearchStack<move_type>;
+
+        /// \brief Constructs a brancher over a problem instance.
+        ///
+        /// \param problem The problem instance. Must outlive the brancher.
+        /// \param options The dominance rules to apply.
+        explicit LEVIATHAN_FORCE_INLINE AssignmentBrancher(const problem_type& problem,
+                                                           const AssignmentBrancherOptions options = {})
+            : problem_(&problem),
+              options_(options)
+        {
+            if (options_.left_shift_dominance)
+            {
+                fill_limits_.resize(problem.num_berths());
+            }
+            if (options_.symmetry_breaking)
+            {
+                detect_symmetries();
+            }
+        }
+
+        /// \brief Appends the children of `state` to the current frame of `stack`.
+        void branch(const state_type& state, stack_type& stack) const
+        {
+            DCHECK_EQ(state.num_berths(), problem_->num_berths());
+            DCHECK_EQ(state.num_vessels(), problem_->num_vessels());
+
+            const auto num_berths = static_cast<IndexType>(problem_->num_berths());
+            const bool bounded = has_remaining_cost_bound(state);
+            const bool dominance = options_.left_shift_dominance;
+            const bool symmetry = options_.symmetry_breaking;
+            if (dominance)
+            {
+                std::ranges::fill(fill_limits_, kNoFiller);
+            }
+
+            const bool alive = state.for_each_unassigned([&](const IndexType v)
+            {
+                if (symmetry && previous_vessel_[v] != kNoPrevious && !state.is_assigned(previous_vessel_[v]))
+                {
+                    return true;
+                }
+
+                const TimeType ready = problem_->ready_time(v);
+                const auto processing_times = problem_->processing_times_row(v);
+                const CostType others = bounded ? remaining_cost_bound_without(state, v) : CostType{0};
+                const size_t first_child = stack.current_frame_size();
+
+                for (IndexType b = 0; b < num_berths; ++b)
+                {
+                    if (symmetry && previous_berth_[b] != kNoPrevious &&
+                        state.berth_free_times[previous_berth_[b]] == state.berth_free_times[b])
+                    {
+                        continue;
+                    }
+
+                    const TimeType duration = processing_times[b];
+                    const std::optional<TimeType> start = problem_->timeline(b).find_earliest_start(
+                        std::max(ready, state.berth_free_times[b]), duration);
+                    if (!start)
+                    {
+                        continue;
+                    }
+
+                    const TimeType finish = *start + duration;
+                    const CostType delta = problem_->cost(v, finish);
+                    stack.push(move_type{v, b, *start, finish, delta, state.current_objective + delta + others});
+                }
+
+                if (LEVIATHAN_UNLIKELY(stack.current_frame_size() == first_child))
+                {
+                    return false;
+                }
+                if (dominance)
+                {
+                    record_filler(stack.current_frame_entries().subspan(first_child));
+                }
+                return true;
+            });
+            if (LEVIATHAN_UNLIKELY(!alive))
+            {
+                // Some vessel can no longer be served; no completion of this node exists.
+                while (stack.current_frame_size() > 0)
+                {
+                    stack.pop_entry();
+                }
+                return;
+            }
+
+            if (dominance)
+            {
+                drop_dominated(stack);
+            }
+
+            std::ranges::sort(stack.current_frame_entries(), [](const move_type& a, const move_type& b)
+            {
+                if (a.lower_bound != b.lower_bound)
+                {
+                    return a.lower_bound < b.lower_bound;
+                }
+                if (a.vessel != b.vessel)
+                {
+                    return a.vessel < b.vessel;
+                }
+                return a.berth < b.berth;
+            });
+        }
+
+    private:
+        static constexpr TimeType kNoFiller = std::numeric_limits<TimeType>::max();
+        static constexpr IndexType kNoPrevious = -1;
+        static constexpr bool kMayBound = requires(const state_type& state)
+        {
+            state.has_remaining_cost_bound();
+        };
+
+        [[nodiscard]] static LEVIATHAN_FORCE_INLINE bool has_remaining_cost_bound(const state_type& state) noexcept
+        {
+            if constexpr (kMayBound)
+            {
+                return state.has_remaining_cost_bound();
+            }
+            return false;
+        }
+
+        /// \brief Returns the remaining cost bound of the unassigned vessels other than `v`.
+        [[nodiscard]] static LEVIATHAN_FORCE_INLINE CostType remaining_cost_bound_without(const state_type& state,
+                                                                                          const IndexType v)
+        {
+            if constexpr (kMayBound)
+            {
+                return state.remaining_cost_bound() - state.remaining_cost_term(v);
+            }
+            return CostType{0};
+        }
+
+        /// \brief Links every berth and vessel to the previous member of its interchangeability group.
+        void detect_symmetries()
+        {
+            const size_t num_vessels = problem_->num_vessels();
+            const size_t num_berths = problem_->num_berths();
+
+            const auto same_berth = [this, num_vessels](const IndexType a, const IndexType b)
+            {
+                const auto& ta = problem_->timeline(a);
+                const auto& tb = problem_->timeline(b);
+                if (!std::ranges::equal(ta, tb, [](const auto& x, const auto& y)
+                {
+                    return x.start_inclusive == y.start_inclusive && x.end_exclusive == y.end_exclusive;
+                }))
+                {
+                    return false;
+                }
+                for (size_t v = 0; v < num_vessels; ++v)
+                {
+                    if (problem_->processing_time(static_cast<IndexType>(v), a) !=
+                        problem_->processing_time(static_cast<IndexType>(v), b))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            };
+            const auto same_vessel = [this](const IndexType a, const IndexType b)
+            {
+                return problem_->ready_time(a) == problem_->ready_time(b) &&
+                    problem_->weight(a) == problem_->weight(b) &&
+                    std::ranges::equal(problem_->processing_times_row(a), problem_->processing_times_row(b));
+            };
+
+            previous_berth_.assign(num_berths, kNoPrevious);
+            link_groups(previous_berth_, same_berth);
+            previous_vessel_.assign(num_vessels, kNoPrevious);
+            link_groups(previous_vessel_, same_vessel);
+        }
+
+        /// \brief Sets `previous[i]` to the largest j < i that is equal to i, comparing against group leaders only.
+        template <typename Equal>
+        static void link_groups(std::vector<IndexType>& previous, const Equal& equal)
+        {
+            // Leader (first member) and last member of every group found so far.
+            std::vector<std::pair<IndexType, IndexType>> groups;
+            for (IndexType i = 0; i < static_cast<IndexType>(previous.size()); ++i)
+            {
+                const auto group = std::ranges::find_if(groups, [&](const auto& g)
+                {
+                    return equal(g.first, i);
+                });
+                if (group == groups.end())
+                {
+                    groups.emplace_back(i, i);
+                    continue;
+                }
+                previous[i] = group->second;
+                group->second = i;
+            }
+        }
+
+        /// \brief Registers a vessel's children as gap fillers for the berths where it finishes earliest.
+        LEVIATHAN_FORCE_INLINE void record_filler(const std::span<const move_type> children) const
+        {
+            TimeType earliest = kNoFiller;
+            for (const move_type& child : children)
+            {
+                earliest = std::min(earliest, child.finish_time);
+            }
+            for (const move_type& child : children)
+            {
+                if (child.finish_time == earliest)
+                {
+                    fill_limits_[child.berth] = std::min(fill_limits_[child.berth], earliest);
+                }
+            }
+        }
+
+        /// \brief Removes the children whose berth has a filler that finishes before they start.
+        ///
+        /// A vessel never fills its own gap, since its finish is not before its start.
+        LEVIATHAN_FORCE_INLINE void drop_dominated(stack_type& stack) const
+        {
+            const auto frame = stack.current_frame_entries();
+            size_t kept = 0;
+            for (const move_type& child : frame)
+            {
+                if (fill_limits_[child.berth] >= child.start_time)
+                {
+                    frame[kept++] = child;
+                }
+            }
+            for (size_t dropped = frame.size() - kept; dropped > 0; --dropped)
+            {
+                stack.pop_entry();
+            }
+        }
+
+        const problem_type* problem_;
+        AssignmentBrancherOptions options_;
+        // Per-berth scratch of branch(): the earliest finish of a vessel for which that berth is a best berth.
+        mutable std::vector<TimeType> fill_limits_;
+        // Previous member of the interchangeability group, or kNoPrevious.
+        std::vector<IndexType> previous_berth_;
+        std::vector<IndexType> previous_vessel_;
+    };
+}
+
+#endif // LEVIATHAN_BNB_ASSIGNMENT_BRANCHER_H_
@@ -0,0 +1,197 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "leviathan/bnb/assignment_brancher.h"
+
+using Time = int64_t;
+using Index = int32_t;
+using Cost = double;
+using TestProblem = leviathan::bnb::Problem<Time, Index, Cost>;
+using Timeline = leviathan::bnb::BerthTimeline<Time>;
+using Window = leviathan::bnb::AvailableWindow<Time>;
+using State = leviathan::bnb::SearchState<Time, Index, Cost>;
+using Move = leviathan::bnb::SearchMove<Time, Index, Cost>;
+using Brancher = leviathan::bnb::AssignmentBrancher<Time, Index, Cost>;
+
+TEST(AssignmentBrancherTest, GeneratesAllVesselBerthPairs)
+{
+    const TestProblem problem({0, 0}, {1.0, 1.0}, {10, 20, 30, 40}, {Timeline(0, 1000), Timeline(0, 1000)});
+    const Brancher brancher(problem);
+    State state(2, 2);
+    leviathan::bnb::SearchStack<Move> stack;
+
+    stack.push_frame();
+    brancher.branch(state, stack);
+
+    const auto frame = stack.current_frame_entries();
+    ASSERT_EQ(frame.size(), 4);
+
+    // Children are sorted by lower bound.
+    EXPECT_EQ(frame[0].vessel, 0);
+    EXPECT_EQ(frame[0].berth, 0);
+    EXPECT_EQ(frame[0].lower_bound, 10.0);
+    EXPECT_EQ(frame[3].vessel, 1);
+    EXPECT_EQ(frame[3].berth, 1);
+    EXPECT_EQ(frame[3].lower_bound, 40.0);
+}
+
+TEST(AssignmentBrancherTest, SkipsAssignedVessels)
+{
+    const TestProblem problem({0, 0}, {1.0, 1.0}, {10, 20, 30, 40}, {Timeline(0, 1000), Timeline(0, 1000)});
+    const Brancher brancher(problem);
+    State state(2, 2);
+    state.apply_move(0, 0, 0, 10, 10.0);
+    leviathan::bnb::SearchStack<Move> stack;
+
+    stack.push_frame();
+    brancher.branch(state, stack);
+
+    const auto frame = stack.current_frame_entries();
+    ASSERT_EQ(frame.size(), 2);
+    for (const Move& move : frame)
+    {
+        EXPECT_EQ(move.vessel, 1);
+    }
+    // Berth 0 is busy until 10, so vessel 1 finishes at 40 on either berth; ties keep berth order.
+    EXPECT_EQ(frame[0].berth, 0);
+    EXPECT_EQ(frame[0].start_time, 10);
+    EXPECT_EQ(frame[0].finish_time, 40);
+    EXPECT_EQ(frame[0].lower_bound, 50.0);
+    EXPECT_EQ(frame[1].berth, 1);
+    EXPECT_EQ(frame[1].start_time, 0);
+}
+
+TEST(AssignmentBrancherTest, RespectsTimelineWindows)
+{
+    // Berth 0 is closed in [5, 20): a 10 long service ready at 0 must start at 20.
+    const std::vector<Window> windows = {{0, 5}, {20, 1000}};
+    const TestProblem problem({0}, {2.0}, {10}, {Timeline(windows)});
+    const Brancher brancher(problem);
+    const State state(1, 1);
+    leviathan::bnb::SearchStack<Move> stack;
+
+    stack.push_frame();
+    brancher.branch(state, stack);
+
+    ASSERT_EQ(stack.current_frame_size(), 1);
+    EXPECT_EQ(stack.top().start_time, 20);
+    EXPECT_EQ(stack.top().finish_time, 30);
+    EXPECT_EQ(stack.top().cost_delta, 60.0);
+}
+
+TEST(AssignmentBrancherTest, DeadEndLeavesEmptyFrame)
+{
+    // Vessel 1 does not fit into the remaining window of the only berth.
+    const TestProblem problem({0, 0}, {1.0, 1.0}, {10, 50}, {Timeline(0, 40)});
+    const Brancher brancher(problem);
+    leviathan::bnb::SearchStack<Move> stack;
+
+    const State state(1, 2);
+    stack.push_frame();
+    brancher.branch(state, stack);
+    EXPECT_EQ(stack.current_frame_size(), 0);
+}
+
+TEST(AssignmentBrancherTest, LeftShiftDominanceDropsFillableGaps)
+{
+    // Vessel 1 arrives at 20. Vessel 0 finishes earliest on berth 1 (at 2), so leaving berth 1
+    // idle until 20 is dominated, while berth 0 (where vessel 0 would need until 5) is not.
+    const TestProblem problem({0, 20}, {1.0, 1.0}, {5, 2, 5, 5}, {Timeline(0, 1000), Timeline(0, 1000)});
+    const Brancher brancher(problem, {.left_shift_dominance = true});
+    const State state(2, 2);
+    leviathan::bnb::SearchStack<Move> stack;
+
+    stack.push_frame();
+    brancher.branch(state, stack);
+
+    const auto frame = stack.current_frame_entries();
+    ASSERT_EQ(frame.size(), 3);
+    EXPECT_EQ(frame[0].vessel, 0);
+    EXPECT_EQ(frame[0].berth, 1);
+    EXPECT_EQ(frame[1].vessel, 0);
+    EXPECT_EQ(frame[1].berth, 0);
+    EXPECT_EQ(frame[2].vessel, 1);
+    EXPECT_EQ(frame[2].berth, 0);
+
+    // Without the option every pair is a child.
+    const Brancher plain(problem);
+    stack.clear();
+    stack.push_frame();
+    plain.branch(state, stack);
+    EXPECT_EQ(stack.current_frame_size(), 4);
+}
+
+TEST(AssignmentBrancherTest, LeftShiftDominanceKeepsTouchingGaps)
+{
+    // Vessel 0 finishes exactly when vessel 1 could start: no idle time is wasted, both orders stay.
+    const TestProblem problem({0, 5}, {1.0, 1.0}, {5, 5}, {Timeline(0, 1000)});
+    const Brancher brancher(problem, {.left_shift_dominance = true});
+    const State state(1, 2);
+    leviathan::bnb::SearchStack<Move> stack;
+
+    stack.push_frame();
+    brancher.branch(state, stack);
+    EXPECT_EQ(stack.current_frame_size(), 2);
+}
+
+TEST(AssignmentBrancherTest, SymmetryBreakingUsesCanonicalOrder)
+{
+    // Three identical berths and three identical vessels: the root has a single canonical child.
+    const TestProblem problem({0, 0, 0}, {1.0, 1.0, 1.0}, std::vector<Time>(9, 10),
+                              {Timeline(0, 1000), Timeline(0, 1000), Timeline(0, 1000)});
+    const Brancher brancher(problem, {.symmetry_breaking = true});
+    State state(3, 3);
+    leviathan::bnb::SearchStack<Move> stack;
+
+    stack.push_frame();
+    brancher.branch(state, stack);
+    ASSERT_EQ(stack.current_frame_size(), 1);
+    EXPECT_EQ(stack.top().vessel, 0);
+    EXPECT_EQ(stack.top().berth, 0);
+
+    // Berth 0 is now busy, berths 1 and 2 are still interchangeable; only vessel 1 may go next.
+    state.apply_move(0, 0, 0, 10, 10.0);
+    stack.clear();
+    stack.push_frame();
+    brancher.branch(state, stack);
+    const auto frame = stack.current_frame_entries();
+    ASSERT_EQ(frame.size(), 2);
+    EXPECT_EQ(frame[0].vessel, 1);
+    EXPECT_EQ(frame[0].berth, 1);
+    EXPECT_EQ(frame[1].vessel, 1);
+    EXPECT_EQ(frame[1].berth, 0);
+}
+
+TEST(AssignmentBrancherTest, SymmetryBreakingKeepsDistinctBerthsAndVessels)
+{
+    // Berth 1 has a different timeline and vessel 1 a different weight: nothing is symmetric.
+    const std::vector<Window> windows = {{0, 5}, {20, 1000}};
+    const TestProblem problem({0, 0}, {1.0, 2.0}, {10, 10, 10, 10}, {Timeline(0, 1000), Timeline(windows)});
+    const Brancher brancher(problem, {.symmetry_breaking = true});
+    const State state(2, 2);
+    leviathan::bnb::SearchStack<Move> stack;
+
+    stack.push_frame();
+    brancher.branch(state, stack);
+    EXPECT_EQ(stack.current_frame_size(), 4);
+}
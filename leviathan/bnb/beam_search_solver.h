@@ -0,0 +1,366 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_BEAM_SEARCH_SOLVER_H_
+#define LEVIATHAN_BNB_BEAM_SEARCH_SOLVER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_stack.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/search_statistics.h"
+#include "leviathan/bnb/shared_incumbent.h"
+
+namespace leviathan::bnb
+{
+    /// \brief Tuning knobs of the BeamSearchSolver.
+    struct BeamSearchSolverOptions
+    {
+        /// Number of partial schedules kept per layer.
+        std::size_t width = 64;
+        /// Maximum number of nodes to create before the search stops; checked once per layer.
+        std::uint64_t node_limit = std::numeric_limits<std::uint64_t>::max();
+    };
+
+    /// \brief Ranks beam candidates by the lower bound the brancher stored in the move.
+    struct LowerBoundScore
+    {
+        template <typename TimeType, typename IndexType, typename CostType>
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType operator()(
+            const SearchState<TimeType, IndexType, CostType>&,
+            const SearchMove<TimeType, IndexType, CostType>& move) const noexcept
+        {
+            return move.lower_bound;
+        }
+    };
+
+    /// \brief Width-bounded breadth-first search over the branching model.
+    ///
+    /// Every layer holds at most `width` partial schedules. Each of them is expanded by the
+    /// brancher into its own SearchStack frame, children whose bound reaches the incumbent are
+    /// dropped, and the `width` children with the smallest score form the next layer. Complete
+    /// schedules of the last layer are offered to the incumbent.
+    ///
+    /// The states of a layer live in two pools of preallocated SearchState objects that swap
+    /// roles after each layer; a child is materialized by copy-assigning its parent (which
+    /// reuses the target's buffers) and applying the move. solve() first copies the root into
+    /// every slot of both pools, so the slots carry whatever optional structures the root
+    /// maintains (remaining cost bound, Zobrist hash, berth tree, unassigned set). That copy
+    /// allocates only while the slots are smaller than the root, e.g. on the first solve()
+    /// after enabling a structure. The stack and the candidate list are reserved for the
+    /// largest possible layer up front, so the layers themselves never allocate.
+    ///
+    /// Beam search is a heuristic. Only if no layer ever had to drop a child for lack of width
+    /// is the result proven optimal.
+    ///
+    /// \tparam BrancherType The branching rule, see the Brancher concept.
+    /// \tparam ScoreType Callable `(const State& parent, const Move& child) -> CostType`;
+    ///         smaller is better.
+    template <typename TimeType, typename IndexType, typename CostType, typename BrancherType,
+              typename ScoreType = LowerBoundScore>
+        requires Brancher<BrancherType, TimeType, IndexType, CostType> &&
+        std::invocable<const ScoreType&, const SearchState<TimeType, IndexType, CostType>&,
+                       const SearchMove<TimeType, IndexType, CostType>&>
+    class BeamSearchSolver
+    {
+    public:
+        using state_type = SearchState<TimeType, IndexType, CostType>;
+        using move_type = SearchMove<TimeType, IndexType, CostType>;
+        using stack_type = SearchStack<move_type>;
+        using incumbent_type = SharedIncumbent<TimeType, IndexType, CostType>;
+        using size_type = std::size_t;
+
+        static constexpr CostType kNoSolution = incumbent_type::kNoSolution;
+
+        /// \brief Constructs a solver for an instance of the given size.
+        ///
+        /// \param num_berths The number of berths of the instance.
+        /// \param num_vessels The number of vessels of the instance.
+        /// \param brancher The branching rule used to expand nodes.
+        /// \param options The beam width and search limits.
+        /// \param score The ranking of candidates within a layer.
+        BeamSearchSolver(const size_type num_berths, const size_type num_vessels, BrancherType brancher,
+                         const BeamSearchSolverOptions options = {}, ScoreType score = {})
+            : root_(num_berths, num_vessels),
+              brancher_(std::move(brancher)),
+              score_(std::move(score)),
+              options_(options),
+              current_(options.width, state_type(num_berths, num_vessels)),
+              next_(options.width, state_type(num_berths, num_vessels)),
+              owned_incumbent_(num_vessels),
+              best_assignments_(num_vessels, state_type::kUnassignedVessel),
+              best_start_times_(num_vessels, 0)
+        {
+            DCHECK_GT(options_.width, 0u);
+            const size_type max_children = options_.width * num_vessels * std::max<size_type>(num_berths, 1);
+            stack_.reserve(max_children, options_.width);
+            candidates_.reserve(max_children);
+        }
+
+        /// \brief Returns the root state. May be modified before solve() (e.g. initial berth free times).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE state_type& state() noexcept
+        {
+            return root_;
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const state_type& state() const noexcept
+        {
+            return root_;
+        }
+
+        /// \brief Resets the incumbent to an upper bound; only strictly better solutions will be reported.
+        ///
+        /// Must not be called while another solver searches with the same incumbent.
+        LEVIATHAN_FORCE_INLINE void set_upper_bound(const CostType upper_bound) noexcept
+        {
+            incumbent_->reset(upper_bound);
+            has_solution_ = false;
+        }
+
+        /// \brief Prunes against and publishes to an external incumbent instead of the owned one.
+        ///
+        /// \param incumbent The shared incumbent. Must outlive the solver.
+        LEVIATHAN_FORCE_INLINE void attach_incumbent(incumbent_type& incumbent) noexcept
+        {
+            incumbent_ = &incumbent;
+        }
+
+        /// \brief Returns the incumbent the solver prunes against.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE incumbent_type& incumbent() noexcept
+        {
+            return *incumbent_;
+        }
+
+        /// \brief Makes the search stop (as if a limit was hit) once `flag` becomes true.
+        ///
+        /// The flag is checked once per layer.
+        ///
+        /// \param flag The stop flag, usually raised by another thread. Must outlive the solver.
+        LEVIATHAN_FORCE_INLINE void attach_stop_flag(const std::atomic<bool>& flag) noexcept
+        {
+            stop_flag_ = &flag;
+        }
+
+        /// \brief Runs the beam from the root state, one layer per unassigned vessel.
+        SearchStatus solve()
+        {
+            statistics_ = {};
+            const auto root_unassigned = static_cast<size_type>(root_.num_unassigned());
+
+            for (state_type& state : current_)
+            {
+                state = root_;
+            }
+            for (state_type& state : next_)
+            {
+                state = root_;
+            }
+            size_type beam_size = 1;
+            bool truncated = false;
+
+            for (size_type layer = 0; layer < root_unassigned; ++layer)
+            {
+                if (LEVIATHAN_UNLIKELY(statistics_.nodes >= options_.node_limit ||
+                    stop_flag_->load(std::memory_order_relaxed)))
+                {
+                    return finish(false);
+                }
+
+                generate_candidates(beam_size);
+                if (candidates_.empty())
+                {
+                    return finish(!truncated);
+                }
+
+                if (candidates_.size() > options_.width)
+                {
+                    std::ranges::nth_element(candidates_, candidates_.begin() + options_.width, better);
+                    candidates_.resize(options_.width);
+                    truncated = true;
+                }
+
+                beam_size = candidates_.size();
+                for (size_type k = 0; k < beam_size; ++k)
+                {
+                    const Candidate& candidate = candidates_[k];
+                    const move_type& move = stack_.frame_entries(candidate.parent)[candidate.entry];
+                    state_type& child = next_[k];
+                    child = current_[candidate.parent];
+                    child.apply_move(move.vessel, move.berth, move.start_time, move.finish_time, move.cost_delta);
+                }
+                std::swap(current_, next_);
+
+                statistics_.nodes += beam_size;
+                statistics_.max_depth = layer + 1;
+                statistics_.max_open_nodes = std::max<std::uint64_t>(statistics_.max_open_nodes, beam_size);
+            }
+
+            for (size_type k = 0; k < beam_size; ++k)
+            {
+                record_solution(current_[k]);
+            }
+            return finish(!truncated);
+        }
+
+        /// \brief Returns true if this solver has found a solution.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool has_solution() const noexcept
+        {
+            return has_solution_;
+        }
+
+        /// \brief Returns the objective of the incumbent (or the upper bound if none was found).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType best_objective() const noexcept
+        {
+            return incumbent_->objective();
+        }
+
+        /// \brief Returns the berth of every vessel in the best solution found by this solver.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const IndexType> best_assignments() const noexcept
+        {
+            return best_assignments_;
+        }
+
+        /// \brief Returns the start time of every vessel in the best solution found by this solver.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const TimeType> best_start_times() const noexcept
+        {
+            return best_start_times_;
+        }
+
+        /// \brief Returns the counters of the last solve() call.
+        ///
+        /// `max_open_nodes` is the largest beam that was kept, `max_depth` the last layer reached.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const SearchStatistics& statistics() const noexcept
+        {
+            return statistics_;
+        }
+
+        /// \brief Returns the total bytes allocated by the stack and the candidate list.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type allocated_memory_bytes() const noexcept
+        {
+            return stack_.allocated_memory_bytes() + candidates_.capacity() * sizeof(Candidate);
+        }
+
+    private:
+        /// \brief A child of the current layer, identified by its frame and its offset within it.
+        struct Candidate
+        {
+            CostType score;
+            std::uint32_t parent;
+            std::uint32_t entry;
+        };
+
+        /// \brief Orders candidates by score; ties go to the earlier parent, then the earlier child.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE static bool better(const Candidate& a, const Candidate& b) noexcept
+        {
+            if (a.score != b.score)
+            {
+                return a.score < b.score;
+            }
+            if (a.parent != b.parent)
+            {
+                return a.parent < b.parent;
+            }
+            return a.entry < b.entry;
+        }
+
+        /// \brief Expands every state of the current layer into its own frame and lists the survivors.
+        LEVIATHAN_FORCE_INLINE void generate_candidates(const size_type beam_size)
+        {
+            stack_.clear();
+            candidates_.clear();
+            const CostType objective = incumbent_->objective();
+            for (size_type i = 0; i < beam_size; ++i)
+            {
+                const state_type& parent = current_[i];
+                stack_.fill_frame([this, &parent](stack_type& stack)
+                {
+                    brancher_.branch(parent, stack);
+                });
+
+                const std::span<const move_type> children = stack_.current_frame_entries();
+                for (size_type j = 0; j < children.size(); ++j)
+                {
+                    if (children[j].lower_bound >= objective)
+                    {
+                        ++statistics_.pruned;
+                        continue;
+                    }
+                    candidates_.push_back(Candidate{
+                        static_cast<CostType>(score_(parent, children[j])),
+                        static_cast<std::uint32_t>(i),
+                        static_cast<std::uint32_t>(j)
+                    });
+                }
+            }
+        }
+
+        LEVIATHAN_FORCE_INLINE void record_solution(const state_type& state)
+        {
+            if (!incumbent_->try_improve(state))
+            {
+                return;
+            }
+            std::ranges::copy(state.vessel_assignments, best_assignments_.begin());
+            std::ranges::copy(state.vessel_start_times, best_start_times_.begin());
+            has_solution_ = true;
+            ++statistics_.solutions;
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE SearchStatus finish(const bool exhausted) const noexcept
+        {
+            const bool has_incumbent = incumbent_->has_solution();
+            if (exhausted)
+            {
+                return has_incumbent ? SearchStatus::kOptimal : SearchStatus::kInfeasible;
+            }
+            return has_incumbent ? SearchStatus::kFeasible : SearchStatus::kLimitReached;
+        }
+
+        state_type root_;
+        stack_type stack_;
+        BrancherType brancher_;
+        ScoreType score_;
+        BeamSearchSolverOptions options_;
+        SearchStatistics statistics_;
+        std::vector<state_type> current_;
+        std::vector<state_type> next_;
+        std::vector<Candidate> candidates_;
+
+        incumbent_type owned_incumbent_;
+        incumbent_type* incumbent_ = &owned_incumbent_;
+        std::atomic<bool> never_stop_{false};
+        const std::atomic<bool>* stop_flag_ = &never_stop_;
+        bool has_solution_ = false;
+        std::vector<IndexType> best_assignments_;
+        std::vector<TimeType> best_start_times_;
+    };
+}
+
+#endif // LEVIATHAN_BNB_BEAM_SEARCH_SOLVER_H_
@@ -0,0 +1,145 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "leviathan/bnb/allocation_counter.h"
+#include "leviathan/bnb/assignment_brancher.h"
+#include "leviathan/bnb/beam_search_solver.h"
+#include "leviathan/bnb/depth_first_solver.h"
+#include "leviathan/bnb/test_util.h"
+
+using namespace leviathan::bnb::testing;
+using Brancher = leviathan::bnb::AssignmentBrancher<Time, Index, Cost>;
+using Solver = leviathan::bnb::BeamSearchSolver<Time, Index, Cost, Brancher>;
+using leviathan::bnb::SearchStatus;
+
+TEST(BeamSearchSolverTest, WideBeamIsExact)
+{
+    for (uint32_t seed = 0; seed < 10; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 5, 2);
+        Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.width = 4096});
+
+        ASSERT_EQ(solver.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(solver.best_objective(), brute_force_optimum(problem)) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(evaluate_schedule(problem, solver.best_assignments(), solver.best_start_times()),
+                         solver.best_objective()) << "seed " << seed;
+    }
+}
+
+TEST(BeamSearchSolverTest, WidthOneIsTheGreedyDive)
+{
+    const TestProblem problem = make_random_problem(42, 8, 3);
+    Solver beam(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.width = 1});
+    leviathan::bnb::DepthFirstSolver<Time, Index, Cost, Brancher> dfs(
+        problem.num_berths(), problem.num_vessels(), Brancher(problem), {.node_limit = problem.num_vessels()});
+
+    ASSERT_EQ(beam.solve(), SearchStatus::kFeasible);
+    ASSERT_EQ(dfs.solve(), SearchStatus::kFeasible);
+    EXPECT_DOUBLE_EQ(beam.best_objective(), dfs.best_objective());
+    EXPECT_EQ(beam.statistics().nodes, problem.num_vessels());
+    EXPECT_EQ(beam.statistics().max_open_nodes, 1u);
+}
+
+TEST(BeamSearchSolverTest, NarrowBeamFindsValidSchedules)
+{
+    for (uint32_t seed = 0; seed < 10; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 8, 3);
+        Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.width = 4});
+
+        const SearchStatus status = solver.solve();
+        if (status == SearchStatus::kLimitReached)
+        {
+            continue;
+        }
+        ASSERT_TRUE(status == SearchStatus::kFeasible || status == SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_LE(solver.statistics().max_open_nodes, 4u);
+        EXPECT_EQ(solver.statistics().max_depth, problem.num_vessels());
+        EXPECT_DOUBLE_EQ(evaluate_schedule(problem, solver.best_assignments(), solver.best_start_times()),
+                         solver.best_objective()) << "seed " << seed;
+    }
+}
+
+TEST(BeamSearchSolverTest, InfeasibleInstance)
+{
+    // Both vessels need 30 time units but the only berth is open for 50.
+    const TestProblem problem({0, 0}, {1.0, 1.0}, {30, 30}, {{0, 50}});
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+
+    EXPECT_EQ(solver.solve(), SearchStatus::kInfeasible);
+    EXPECT_FALSE(solver.has_solution());
+}
+
+TEST(BeamSearchSolverTest, NoAllocationWhileSearching)
+{
+    const TestProblem problem = make_random_problem(5, 10, 3);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.width = 8});
+    const size_t bytes = solver.allocated_memory_bytes();
+
+    ASSERT_NE(solver.solve(), SearchStatus::kLimitReached);
+    EXPECT_EQ(solver.allocated_memory_bytes(), bytes);
+}
+
+TEST(BeamSearchSolverTest, OnlySeedingTheLayersAllocates)
+{
+    const TestProblem problem = make_random_problem(5, 10, 3);
+    const auto configure = [&problem](Solver& solver)
+    {
+        solver.state().enable_remaining_cost_bound(problem.ready_times(), problem.weights(),
+                                                   problem.min_processing_times());
+        solver.state().enable_zobrist_hash();
+        solver.state().enable_unassigned_set();
+    };
+
+    // A node limit of 0 stops before the first layer, after the pools were seeded from the root.
+    Solver seeded(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.width = 8, .node_limit = 0});
+    Solver searched(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.width = 8});
+    configure(seeded);
+    configure(searched);
+
+    uint64_t allocations = allocation_count();
+    ASSERT_EQ(seeded.solve(), SearchStatus::kLimitReached);
+    const uint64_t seeding = allocation_count() - allocations;
+    EXPECT_GT(seeding, 0u);
+
+    allocations = allocation_count();
+    ASSERT_NE(searched.solve(), SearchStatus::kLimitReached);
+    EXPECT_EQ(allocation_count() - allocations, seeding);
+
+    // The pools now match the root, so searching again allocates nothing.
+    searched.set_upper_bound(Solver::kNoSolution);
+    allocations = allocation_count();
+    ASSERT_NE(searched.solve(), SearchStatus::kLimitReached);
+    EXPECT_EQ(allocation_count(), allocations);
+}
+
+TEST(BeamSearchSolverTest, NodeLimitStopsBetweenLayers)
+{
+    const TestProblem problem = make_random_problem(3, 8, 3);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.width = 4, .node_limit = 10});
+
+    const SearchStatus status = solver.solve();
+    EXPECT_EQ(status, SearchStatus::kLimitReached);
+    EXPECT_GE(solver.statistics().nodes, 10u);
+    EXPECT_LT(solver.statistics().nodes, 14u);
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+#include "leviathan/bnb/allocation_counter.h"
+#include "leviathan/bnb/berth_timeline.h"
+
+// Measures BerthTimeline::find_earliest_start on timelines with many availability windows.
+// Windows are 100 time units long with gaps of 20; queries start at random times and ask for
+// durations that fit in the current window about half of the time.
+
+namespace
+{
+    using Timeline = leviathan::bnb::BerthTimeline<int64_t>;
+    using Window = leviathan::bnb::AvailableWindow<int64_t>;
+
+    constexpr int64_t kWindowLength = 100;
+    constexpr int64_t kPeriod = 120;
+    constexpr size_t kQueries = 4096;
+
+    void BM_BerthTimelineFindEarliestStart(benchmark::State& state)
+    {
+        const int64_t num_windows = state.range(0);
+        std::vector<Window> windows;
+        windows.reserve(static_cast<size_t>(num_windows));
+        for (int64_t i = 0; i < num_windows; ++i)
+        {
+            windows.push_back(Window{i * kPeriod, i * kPeriod + kWindowLength});
+        }
+        const Timeline timeline(windows);
+
+        std::mt19937_64 rng(42);
+        std::uniform_int_distribution<int64_t> ready(0, num_windows * kPeriod);
+        std::uniform_int_distribution<int64_t> duration(1, kWindowLength);
+        std::vector<std::pair<int64_t, int64_t>> queries(kQueries);
+        for (auto& [r, d] : queries)
+        {
+            r = ready(rng);
+            d = duration(rng);
+        }
+
+        size_t next = 0;
+        const uint64_t bytes_before = leviathan::bnb::testing::allocated_bytes();
+        for (auto _ : state)
+        {
+            const auto& [r, d] = queries[next];
+            next = (next + 1) % kQueries;
+            benchmark::DoNotOptimize(timeline.find_earliest_start(r, d));
+        }
+        const uint64_t bytes = leviathan::bnb::testing::allocated_bytes() - bytes_before;
+
+        state.SetItemsProcessed(state.iterations());
+        state.counters["bytes_per_op"] = static_cast<double>(bytes) / static_cast<double>(state.iterations());
+    }
+}
+
+BENCHMARK(BM_BerthTimelineFindEarliestStart)
+    ->ArgName("windows")
+    ->RangeMultiplier(10)
+    ->Range(10, 100000);
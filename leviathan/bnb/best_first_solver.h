@@ -0,0 +1,443 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_BEST_FIRST_SOLVER_H_
+#define LEVIATHAN_BNB_BEST_FIRST_SOLVER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_stack.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/search_statistics.h"
+#include "leviathan/bnb/search_trail.h"
+#include "leviathan/bnb/shared_incumbent.h"
+
+namespace leviathan::bnb
+{
+    /// \brief Tuning knobs of the BestFirstSolver.
+    struct BestFirstSolverOptions
+    {
+        /// Maximum number of nodes to enter before the search stops.
+        std::uint64_t node_limit = std::numeric_limits<std::uint64_t>::max();
+    };
+
+    /// \brief Best-bound branch-and-bound over path-encoded open nodes.
+    ///
+    /// Open nodes are never stored as state copies. Every node is a single move plus the index
+    /// of its parent in a flat, reference-counted node arena, so an open node costs a constant
+    /// number of bytes and shares its decision prefix with its siblings. Nodes whose subtrees
+    /// are fully explored are recycled through a free list.
+    ///
+    /// The node with the smallest lower bound is selected next (ties prefer deeper nodes).
+    /// Its state is rebuilt incrementally: the solver backtracks only to the longest common
+    /// prefix of the currently applied path and the selected node's path, then replays the
+    /// remaining moves through SearchState::apply_move.
+    ///
+    /// Like the DepthFirstSolver, it prunes against an owned or attached SharedIncumbent.
+    ///
+    /// \tparam BrancherType The branching rule, see the Brancher concept.
+    template <typename TimeType, typename IndexType, typename CostType, typename BrancherType>
+        requires Brancher<BrancherType, TimeType, IndexType, CostType>
+    class BestFirstSolver
+    {
+    public:
+        using state_type = SearchState<TimeType, IndexType, CostType>;
+        using move_type = SearchMove<TimeType, IndexType, CostType>;
+        using undo_type = SearchUndo<TimeType, IndexType, CostType>;
+        using stack_type = SearchStack<move_type>;
+        using trail_type = SearchTrail<undo_type>;
+        using incumbent_type = SharedIncumbent<TimeType, IndexType, CostType>;
+        using size_type = std::size_t;
+        using node_index = std::uint32_t;
+
+        static constexpr CostType kNoSolution = incumbent_type::kNoSolution;
+
+    private:
+        static constexpr node_index kRootNode = std::numeric_limits<node_index>::max();
+
+        /// \brief A node of the search tree, encoded as the delta to its parent.
+        struct Node
+        {
+            move_type move;
+            node_index parent;
+            /// Open self-reference + applied reference + number of live children.
+            std::uint32_t ref_count;
+        };
+
+        /// \brief A heap entry of the open list.
+        struct OpenEntry
+        {
+            CostType bound;
+            std::uint32_t depth;
+            node_index node;
+        };
+
+    public:
+        /// \brief Number of bytes an open node occupies (arena node plus heap entry).
+        static constexpr size_type kBytesPerOpenNode = sizeof(Node) + sizeof(OpenEntry);
+
+        /// \brief Constructs a solver for an instance of the given size.
+        ///
+        /// \param num_berths The number of berths of the instance.
+        /// \param num_vessels The number of vessels of the instance.
+        /// \param brancher The branching rule used to expand nodes.
+        /// \param options The search limits.
+        LEVIATHAN_FORCE_INLINE BestFirstSolver(const size_type num_berths, const size_type num_vessels,
+                                               BrancherType brancher, const BestFirstSolverOptions options = {})
+            : state_(num_berths, num_vessels),
+              brancher_(std::move(brancher)),
+              options_(options),
+              owned_incumbent_(num_vessels),
+              best_assignments_(num_vessels, state_type::kUnassignedVessel),
+              best_start_times_(num_vessels, 0)
+        {
+            stack_.reserve(num_vessels * std::max<size_type>(num_berths, 1), 1);
+            trail_.reserve(num_vessels, num_vessels);
+            applied_.reserve(num_vessels);
+            path_.reserve(num_vessels);
+        }
+
+        /// \brief Returns the root state. May be modified before solve() (e.g. initial berth free times).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE state_type& state() noexcept
+        {
+            return state_;
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const state_type& state() const noexcept
+        {
+            return state_;
+        }
+
+        /// \brief Resets the incumbent to an upper bound; only strictly better solutions will be reported.
+        ///
+        /// Must not be called while another solver searches with the same incumbent.
+        LEVIATHAN_FORCE_INLINE void set_upper_bound(const CostType upper_bound) noexcept
+        {
+            incumbent_->reset(upper_bound);
+            has_solution_ = false;
+        }
+
+        /// \brief Prunes against and publishes to an external incumbent instead of the owned one.
+        ///
+        /// \param incumbent The shared incumbent. Must outlive the solver.
+        LEVIATHAN_FORCE_INLINE void attach_incumbent(incumbent_type& incumbent) noexcept
+        {
+            incumbent_ = &incumbent;
+        }
+
+        /// \brief Returns the incumbent the solver prunes against.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE incumbent_type& incumbent() noexcept
+        {
+            return *incumbent_;
+        }
+
+        /// \brief Makes the search stop (as if a limit was hit) once `flag` becomes true.
+        ///
+        /// \param flag The stop flag, usually raised by another thread. Must outlive the solver.
+        LEVIATHAN_FORCE_INLINE void attach_stop_flag(const std::atomic<bool>& flag) noexcept
+        {
+            stop_flag_ = &flag;
+        }
+
+        /// \brief Runs the search from the current root state.
+        ///
+        /// On return the state is restored to the root, regardless of whether the
+        /// search was exhausted or stopped by a limit.
+        SearchStatus solve()
+        {
+            DCHECK(trail_.empty());
+            nodes_.clear();
+            free_nodes_.clear();
+            open_.clear();
+            statistics_ = {};
+            root_unassigned_ = static_cast<size_type>(state_.num_unassigned());
+
+            if (root_unassigned_ == 0)
+            {
+                record_solution();
+                return finish(true);
+            }
+
+            expand();
+            while (!open_.empty())
+            {
+                std::ranges::pop_heap(open_, worse);
+                const OpenEntry entry = open_.back();
+                open_.pop_back();
+
+                if (entry.bound >= incumbent_->objective())
+                {
+                    // The heap yields bounds in ascending order: everything left is dominated.
+                    statistics_.pruned += open_.size() + 1;
+                    open_.clear();
+                    break;
+                }
+
+                if (LEVIATHAN_UNLIKELY(statistics_.nodes >= options_.node_limit ||
+                    stop_flag_->load(std::memory_order_relaxed)))
+                {
+                    unwind();
+                    return finish(false);
+                }
+
+                move_to(entry.node);
+                release(entry.node);
+                ++statistics_.nodes;
+                statistics_.max_depth = std::max<std::uint64_t>(statistics_.max_depth, applied_.size());
+                expand();
+            }
+
+            unwind();
+            return finish(true);
+        }
+
+        /// \brief Returns true if this solver has found a solution.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool has_solution() const noexcept
+        {
+            return has_solution_;
+        }
+
+        /// \brief Returns the objective of the incumbent (or the upper bound if none was found).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType best_objective() const noexcept
+        {
+            return incumbent_->objective();
+        }
+
+        /// \brief Returns the berth of every vessel in the best solution found by this solver.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const IndexType> best_assignments() const noexcept
+        {
+            return best_assignments_;
+        }
+
+        /// \brief Returns the start time of every vessel in the best solution found by this solver.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const TimeType> best_start_times() const noexcept
+        {
+            return best_start_times_;
+        }
+
+        /// \brief Returns the counters of the last solve() call.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const SearchStatistics& statistics() const noexcept
+        {
+            return statistics_;
+        }
+
+        /// \brief Returns the total bytes allocated by the node arena, the open list, the stack and the trail.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type allocated_memory_bytes() const noexcept
+        {
+            return nodes_.capacity() * sizeof(Node) +
+                free_nodes_.capacity() * sizeof(node_index) +
+                open_.capacity() * sizeof(OpenEntry) +
+                stack_.allocated_memory_bytes() +
+                trail_.allocated_memory_bytes();
+        }
+
+    private:
+        /// \brief Heap order: returns true if `a` should be selected after `b`.
+        static constexpr bool worse(const OpenEntry& a, const OpenEntry& b) noexcept
+        {
+            if (a.bound != b.bound)
+            {
+                return a.bound > b.bound;
+            }
+            if (a.depth != b.depth)
+            {
+                return a.depth < b.depth;
+            }
+            return a.node > b.node;
+        }
+
+        /// \brief Generates the children of the current state and opens them.
+        ///
+        /// Children that complete the schedule are evaluated on the spot instead of being opened.
+        void expand()
+        {
+            const node_index parent = applied_.empty() ? kRootNode : applied_.back();
+            const auto child_depth = static_cast<std::uint32_t>(applied_.size() + 1);
+
+            stack_.fill_frame([this](stack_type& stack)
+            {
+                brancher_.branch(state_, stack);
+            });
+
+            for (const move_type& child : stack_.current_frame_entries())
+            {
+                if (child.lower_bound >= incumbent_->objective())
+                {
+                    ++statistics_.pruned;
+                    continue;
+                }
+
+                if (child_depth == root_unassigned_)
+                {
+                    apply_decision(state_, trail_, child);
+                    ++statistics_.nodes;
+                    record_solution();
+                    backtrack_decision(state_, trail_);
+                    continue;
+                }
+
+                const node_index index = allocate_node(child, parent);
+                open_.push_back(OpenEntry{child.lower_bound, child_depth, index});
+                std::ranges::push_heap(open_, worse);
+            }
+
+            stack_.pop_frame();
+            statistics_.max_open_nodes = std::max<std::uint64_t>(statistics_.max_open_nodes, open_.size());
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE node_index allocate_node(const move_type& move, const node_index parent)
+        {
+            if (parent != kRootNode)
+            {
+                ++nodes_[parent].ref_count;
+            }
+
+            if (!free_nodes_.empty())
+            {
+                const node_index index = free_nodes_.back();
+                free_nodes_.pop_back();
+                nodes_[index] = Node{move, parent, 1};
+                return index;
+            }
+
+            DCHECK_LT(nodes_.size(), static_cast<size_type>(kRootNode));
+            nodes_.push_back(Node{move, parent, 1});
+            return static_cast<node_index>(nodes_.size() - 1);
+        }
+
+        /// \brief Drops one reference to a node and recycles every ancestor that becomes unreferenced.
+        LEVIATHAN_FORCE_INLINE void release(node_index index)
+        {
+            while (index != kRootNode)
+            {
+                DCHECK_GT(nodes_[index].ref_count, 0u);
+                if (--nodes_[index].ref_count > 0)
+                {
+                    return;
+                }
+                free_nodes_.push_back(index);
+                index = nodes_[index].parent;
+            }
+        }
+
+        /// \brief Rebuilds the state of `target` from the currently applied path.
+        void move_to(const node_index target)
+        {
+            path_.clear();
+            for (node_index n = target; n != kRootNode; n = nodes_[n].parent)
+            {
+                path_.push_back(n);
+            }
+
+            // path_ is leaf-to-root; find the longest prefix shared with the applied path.
+            size_type common = 0;
+            while (common < applied_.size() && common < path_.size() &&
+                applied_[common] == path_[path_.size() - 1 - common])
+            {
+                ++common;
+            }
+
+            while (applied_.size() > common)
+            {
+                pop_applied();
+            }
+
+            for (size_type i = path_.size() - common; i-- > 0;)
+            {
+                const node_index n = path_[i];
+                apply_decision(state_, trail_, nodes_[n].move);
+                ++nodes_[n].ref_count;
+                applied_.push_back(n);
+            }
+        }
+
+        LEVIATHAN_FORCE_INLINE void pop_applied()
+        {
+            backtrack_decision(state_, trail_);
+            release(applied_.back());
+            applied_.pop_back();
+        }
+
+        LEVIATHAN_FORCE_INLINE void record_solution()
+        {
+            if (!incumbent_->try_improve(state_))
+            {
+                return;
+            }
+            std::ranges::copy(state_.vessel_assignments, best_assignments_.begin());
+            std::ranges::copy(state_.vessel_start_times, best_start_times_.begin());
+            has_solution_ = true;
+            ++statistics_.solutions;
+        }
+
+        /// \brief Undoes all applied moves and drops all open nodes.
+        LEVIATHAN_FORCE_INLINE void unwind()
+        {
+            while (!applied_.empty())
+            {
+                pop_applied();
+            }
+            open_.clear();
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE SearchStatus finish(const bool exhausted) const noexcept
+        {
+            const bool has_incumbent = incumbent_->has_solution();
+            if (exhausted)
+            {
+                return has_incumbent ? SearchStatus::kOptimal : SearchStatus::kInfeasible;
+            }
+            return has_incumbent ? SearchStatus::kFeasible : SearchStatus::kLimitReached;
+        }
+
+        state_type state_;
+        stack_type stack_;
+        trail_type trail_;
+        BrancherType brancher_;
+        BestFirstSolverOptions options_;
+        SearchStatistics statistics_;
+        size_type root_unassigned_ = 0;
+
+        std::vector<Node> nodes_;
+        std::vector<node_index> free_nodes_;
+        std::vector<OpenEntry> open_;
+        std::vector<node_index> applied_;
+        std::vector<node_index> path_;
+
+        incumbent_type owned_incumbent_;
+        incumbent_type* incumbent_ = &owned_incumbent_;
+        std::atomic<bool> never_stop_{false};
+        const std::atomic<bool>* stop_flag_ = &never_stop_;
+        bool has_solution_ = false;
+        std::vector<IndexType> best_assignments_;
+        std::vector<TimeType> best_start_times_;
+    };
+}
+
+#endif // LEVIATHAN_BNB_BEST_FIRST_SOLVER_H_
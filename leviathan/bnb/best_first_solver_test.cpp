@@ -0,0 +1,111 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "leviathan/bnb/assignment_brancher.h"
+#include "leviathan/bnb/best_first_solver.h"
+#include "leviathan/bnb/depth_first_solver.h"
+#include "leviathan/bnb/test_util.h"
+
+using namespace leviathan::bnb::testing;
+using Brancher = leviathan::bnb::AssignmentBrancher<Time, Index, Cost>;
+using Solver = leviathan::bnb::BestFirstSolver<Time, Index, Cost, Brancher>;
+using DfsSolver = leviathan::bnb::DepthFirstSolver<Time, Index, Cost, Brancher>;
+using leviathan::bnb::SearchStatus;
+
+TEST(BestFirstSolverTest, MatchesBruteForceOnRandomInstances)
+{
+    for (uint32_t seed = 0; seed < 20; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 5, 2);
+        Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+
+        ASSERT_EQ(solver.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(solver.best_objective(), brute_force_optimum(problem)) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(evaluate_schedule(problem, solver.best_assignments(), solver.best_start_times()),
+                         solver.best_objective()) << "seed " << seed;
+    }
+}
+
+TEST(BestFirstSolverTest, MatchesDepthFirstOnLargerInstances)
+{
+    for (uint32_t seed = 100; seed < 105; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 7, 3);
+        Solver best_first(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+        DfsSolver depth_first(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+
+        ASSERT_EQ(best_first.solve(), SearchStatus::kOptimal);
+        ASSERT_EQ(depth_first.solve(), SearchStatus::kOptimal);
+        EXPECT_DOUBLE_EQ(best_first.best_objective(), depth_first.best_objective()) << "seed " << seed;
+    }
+}
+
+TEST(BestFirstSolverTest, StateIsRestoredAfterSolve)
+{
+    const TestProblem problem = make_random_problem(7, 6, 3);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+
+    ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+    EXPECT_EQ(solver.state().current_objective, 0.0);
+    EXPECT_EQ(solver.state().last_assigned_vessel, Solver::state_type::kUnassignedVessel);
+    for (Index v = 0; v < static_cast<Index>(problem.num_vessels()); ++v)
+    {
+        EXPECT_FALSE(solver.state().is_assigned(v));
+    }
+    for (const Time t : solver.state().berth_free_times)
+    {
+        EXPECT_EQ(t, 0);
+    }
+}
+
+TEST(BestFirstSolverTest, NodeLimitStopsAndUnwinds)
+{
+    const TestProblem problem = make_random_problem(3, 7, 2);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.node_limit = 5});
+
+    const SearchStatus status = solver.solve();
+    EXPECT_TRUE(status == SearchStatus::kFeasible || status == SearchStatus::kLimitReached);
+    EXPECT_EQ(solver.state().current_objective, 0.0);
+    EXPECT_EQ(solver.state().last_assigned_vessel, Solver::state_type::kUnassignedVessel);
+}
+
+TEST(BestFirstSolverTest, OpenNodeSizeIndependentOfInstance)
+{
+    // An open node is one move plus bookkeeping, regardless of the number of berths and vessels.
+    EXPECT_LE(Solver::kBytesPerOpenNode, sizeof(Solver::move_type) + 32);
+
+    const TestProblem problem = make_random_problem(9, 7, 3);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+    ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+    EXPECT_GT(solver.statistics().max_open_nodes, 0);
+}
+
+TEST(BestFirstSolverTest, UpperBoundPrunesEverything)
+{
+    const TestProblem problem = make_random_problem(11, 4, 2);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+    solver.set_upper_bound(brute_force_optimum(problem));
+
+    EXPECT_EQ(solver.solve(), SearchStatus::kInfeasible);
+    EXPECT_FALSE(solver.has_solution());
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <benchmark/benchmark.h>
+#include "leviathan/bnb/decision_diagram.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/test_util.h"
+
+// Compiles the relaxed and the restricted decision diagram at the root of a 20 vessel,
+// 5 berth instance for growing widths.
+
+namespace
+{
+    using namespace leviathan::bnb::testing;
+    using State = leviathan::bnb::SearchState<Time, Index, Cost>;
+    using Diagram = leviathan::bnb::DecisionDiagram<Time, Index, Cost>;
+
+    void BM_RelaxedDiagram(benchmark::State& state)
+    {
+        const TestProblem problem = make_random_problem(7, 20, 5);
+        const State root(problem.num_berths(), problem.num_vessels());
+        Diagram diagram(problem, {.width = static_cast<size_t>(state.range(0))});
+
+        Cost bound = 0.0;
+        for (auto _ : state)
+        {
+            bound = diagram.lower_bound(root);
+            benchmark::DoNotOptimize(bound);
+        }
+
+        state.counters["bound"] = bound;
+        state.counters["bytes"] = static_cast<double>(diagram.allocated_memory_bytes());
+    }
+
+    void BM_RestrictedDiagram(benchmark::State& state)
+    {
+        const TestProblem problem = make_random_problem(7, 20, 5);
+        const State root(problem.num_berths(), problem.num_vessels());
+        Diagram diagram(problem, {.width = static_cast<size_t>(state.range(0))});
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(diagram.restricted_solve(root));
+        }
+
+        state.counters["objective"] = diagram.restricted_objective();
+        state.counters["bytes"] = static_cast<double>(diagram.allocated_memory_bytes());
+    }
+}
+
+BENCHMARK(BM_RelaxedDiagram)->ArgName("width")->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RestrictedDiagram)->ArgName("width")->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,196 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "leviathan/bnb/decision_diagram.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/test_util.h"
+
+using namespace leviathan::bnb::testing;
+
+namespace
+{
+    using State = leviathan::bnb::SearchState<Time, Index, Cost>;
+    using Diagram = leviathan::bnb::DecisionDiagram<Time, Index, Cost>;
+
+    // Checks that a complete schedule respects ready times, berth windows and berth capacity.
+    void expect_feasible(const TestProblem& problem, const std::span<const Index> assignments,
+                         const std::span<const Time> start_times)
+    {
+        for (Index v = 0; v < static_cast<Index>(problem.num_vessels()); ++v)
+        {
+            ASSERT_GE(assignments[v], 0);
+            const Time start = start_times[v];
+            const Time finish = start + problem.processing_time(v, assignments[v]);
+            EXPECT_GE(start, problem.ready_time(v));
+            const auto& timeline = problem.timeline(assignments[v]);
+            EXPECT_TRUE(std::ranges::any_of(timeline, [&](const auto& window)
+            {
+                return window.start_inclusive <= start && finish <= window.end_exclusive;
+            })) << "vessel " << v;
+            for (Index u = 0; u < v; ++u)
+            {
+                if (assignments[u] == assignments[v])
+                {
+                    const Time u_finish = start_times[u] + problem.processing_time(u, assignments[u]);
+                    EXPECT_TRUE(u_finish <= start || finish <= start_times[u]) << "vessels " << u << " and " << v;
+                }
+            }
+        }
+    }
+
+    // Assigns the first `count` vessels, each to the berth where it finishes first.
+    State partial_state(const TestProblem& problem, const Index count)
+    {
+        State state(problem.num_berths(), problem.num_vessels());
+        for (Index v = 0; v < count; ++v)
+        {
+            std::optional<Time> best_start;
+            Index best_berth = 0;
+            for (Index b = 0; b < static_cast<Index>(problem.num_berths()); ++b)
+            {
+                const Time duration = problem.processing_time(v, b);
+                const std::optional<Time> start = problem.timeline(b).find_earliest_start(
+                    std::max(problem.ready_time(v), state.berth_free_times[b]), duration);
+                if (start && (!best_start || *start + duration <
+                    *best_start + problem.processing_time(v, best_berth)))
+                {
+                    best_start = start;
+                    best_berth = b;
+                }
+            }
+            const Time finish = *best_start + problem.processing_time(v, best_berth);
+            state.apply_move(v, best_berth, *best_start, finish, problem.cost(v, finish));
+        }
+        return state;
+    }
+}
+
+TEST(DecisionDiagramTest, UnlimitedWidthIsExact)
+{
+    for (uint32_t seed = 0; seed < 6; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 6, 2);
+        const State root(problem.num_berths(), problem.num_vessels());
+        const Cost optimum = brute_force_optimum(problem);
+
+        Diagram diagram(problem, {.width = 100000});
+        EXPECT_NEAR(diagram.lower_bound(root), optimum, 1e-9) << "seed " << seed;
+        EXPECT_TRUE(diagram.exact());
+
+        ASSERT_TRUE(diagram.restricted_solve(root));
+        EXPECT_TRUE(diagram.exact());
+        EXPECT_NEAR(diagram.restricted_objective(), optimum, 1e-9) << "seed " << seed;
+        expect_feasible(problem, diagram.restricted_assignments(), diagram.restricted_start_times());
+        EXPECT_NEAR(evaluate_schedule(problem, diagram.restricted_assignments(), diagram.restricted_start_times()),
+                    optimum, 1e-9);
+    }
+}
+
+TEST(DecisionDiagramTest, NarrowDiagramsBracketTheOptimum)
+{
+    for (uint32_t seed = 0; seed < 6; ++seed)
+    {
+        const TestProblem problem = make_random_problem(100 + seed, 6, 3);
+        const State root(problem.num_berths(), problem.num_vessels());
+        const Cost optimum = brute_force_optimum(problem);
+
+        for (const size_t width : {1, 2, 8})
+        {
+            Diagram diagram(problem, {.width = width});
+            const Cost bound = diagram.lower_bound(root);
+            EXPECT_LE(bound, optimum + 1e-9) << "seed " << seed << " width " << width;
+            EXPECT_GT(bound, 0.0);
+
+            ASSERT_TRUE(diagram.restricted_solve(root));
+            EXPECT_GE(diagram.restricted_objective(), optimum - 1e-9) << "seed " << seed << " width " << width;
+            expect_feasible(problem, diagram.restricted_assignments(), diagram.restricted_start_times());
+            EXPECT_NEAR(evaluate_schedule(problem, diagram.restricted_assignments(), diagram.restricted_start_times()),
+                        diagram.restricted_objective(), 1e-9);
+        }
+    }
+}
+
+TEST(DecisionDiagramTest, NarrowDiagramIsNotExact)
+{
+    const TestProblem problem = make_random_problem(3, 7, 3);
+    const State root(problem.num_berths(), problem.num_vessels());
+
+    Diagram diagram(problem, {.width = 4});
+    static_cast<void>(diagram.value(root));
+    EXPECT_FALSE(diagram.exact());
+}
+
+TEST(DecisionDiagramTest, BoundHoldsBelowPartialStates)
+{
+    for (uint32_t seed = 0; seed < 8; ++seed)
+    {
+        const TestProblem problem = make_random_problem(200 + seed, 7, 2);
+        Diagram diagram(problem, {.width = 6});
+        for (Index assigned = 0; assigned <= 7; ++assigned)
+        {
+            const State state = partial_state(problem, assigned);
+            const Cost optimum = completion_optimum(problem, state);
+            EXPECT_LE(diagram.lower_bound(state), optimum + 1e-9) << "seed " << seed << " assigned " << assigned;
+
+            ASSERT_TRUE(diagram.restricted_solve(state));
+            EXPECT_GE(diagram.restricted_objective(), optimum - 1e-9);
+            for (Index v = 0; v < assigned; ++v)
+            {
+                EXPECT_EQ(diagram.restricted_assignments()[v], state.vessel_assignments[v]);
+                EXPECT_EQ(diagram.restricted_start_times()[v], state.vessel_start_times[v]);
+            }
+        }
+    }
+}
+
+TEST(DecisionDiagramTest, InfeasibleWhenNoBerthFits)
+{
+    const TestProblem problem({0, 0}, {1.0, 1.0}, {5, 50},
+                              {leviathan::bnb::BerthTimeline<Time>(0, 10)});
+    const State root(problem.num_berths(), problem.num_vessels());
+
+    Diagram diagram(problem, {.width = 16});
+    EXPECT_EQ(diagram.value(root), Diagram::kInfeasible);
+    EXPECT_EQ(diagram.lower_bound(root), Diagram::kInfeasible);
+    EXPECT_FALSE(diagram.restricted_solve(root));
+}
+
+TEST(DecisionDiagramTest, MemoryIsAllocatedUpFront)
+{
+    const TestProblem problem = make_random_problem(4, 10, 3);
+    const State root(problem.num_berths(), problem.num_vessels());
+
+    Diagram diagram(problem, {.width = 64});
+    static_cast<void>(diagram.value(root));
+    ASSERT_TRUE(diagram.restricted_solve(root));
+    const size_t bytes = diagram.allocated_memory_bytes();
+    EXPECT_GT(bytes, 0u);
+
+    static_cast<void>(diagram.value(root));
+    ASSERT_TRUE(diagram.restricted_solve(root));
+    EXPECT_EQ(diagram.allocated_memory_bytes(), bytes);
+}
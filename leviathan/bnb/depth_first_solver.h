@@ -0,0 +1,525 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_DEPTH_FIRST_SOLVER_H_
+#define LEVIATHAN_BNB_DEPTH_FIRST_SOLVER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+#include "leviathan/bnb/node_bound.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_stack.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/search_statistics.h"
+#include "leviathan/bnb/search_trail.h"
+#include "leviathan/bnb/shared_incumbent.h"
+#include "leviathan/bnb/transposition_table.h"
+
+namespace leviathan::bnb
+{
+    /// \brief Tuning knobs of the DepthFirstSolver.
+    struct DepthFirstSolverOptions
+    {
+        /// Maximum number of nodes to enter before the search stops.
+        std::uint64_t node_limit = std::numeric_limits<std::uint64_t>::max();
+        /// Size of the transposition table in bytes; 0 disables it.
+        std::size_t transposition_table_bytes = 0;
+        /// Reserve the stack for the deepest possible dive (max_dive_entries()) instead of at
+        /// most kDiveReserveCap moves, so that no solve() call ever grows it.
+        bool reserve_max_dive = false;
+    };
+
+    /// \brief The reference depth-first branch-and-bound loop.
+    ///
+    /// Owns exactly one SearchStack, one SearchTrail and one SearchState and never copies them.
+    /// Every node is expanded by the brancher directly into a new stack frame. Children are
+    /// taken from the frame one by one, pruned against the incumbent using their stored
+    /// lower bound, and applied to the state with an undo entry on the trail. Exhausted
+    /// frames are popped together with the matching trail frame. Whenever the solver improves
+    /// the incumbent, one sweep over the whole stack drops every pending child whose bound
+    /// reached the new objective.
+    ///
+    /// All buffers are reserved at construction and only ever cleared. The trail is sized for
+    /// the deepest dive outright. The worst-case stack, max_dive_entries(), is quadratic in the
+    /// number of vessels, so by default the stack reserves at most kDiveReserveCap moves and a
+    /// deeper dive grows it once; it keeps that capacity for later calls. With
+    /// `reserve_max_dive`, or whenever the worst case fits under the cap, no solve() call
+    /// allocates, the first one included.
+    ///
+    /// Pruning reads the objective of a SharedIncumbent. The solver owns one by default; several
+    /// solvers running on different threads can share one via attach_incumbent().
+    ///
+    /// With a transposition table, the state keeps a Zobrist hash and every entered node is
+    /// looked up by it. The hash keys depend only on the dimensions and are drawn at construction;
+    /// solve() only recomputes the hash of the (possibly edited) root and clears the table, which
+    /// starts a new table generation in O(1). A node whose assigned vessels and berth free times were already reached
+    /// with an objective at least as good is backtracked without expanding it: the earlier
+    /// visit searched the same completions from a cheaper start.
+    ///
+    /// With a NodeBound, every solve() first calls its bound_root() on the root of the searched
+    /// subtree (after the prefix), follows every move below it with notify_apply() and
+    /// notify_backtrack(), and asks bound_node() for every inner node it enters. A node whose
+    /// bound reaches the incumbent is backtracked without expanding it. A schedule published to
+    /// the incumbent while bound_root() runs is adopted as this solver's best solution.
+    ///
+    /// The solver searches a SearchState by default. A FixedSearchState can replace it for small
+    /// instances, given a brancher and bound for that state; it keeps no Zobrist hash, so the
+    /// transposition table must stay disabled.
+    ///
+    /// \tparam BrancherType The branching rule, see the Brancher concept.
+    /// \tparam BoundType The node bound, see the NodeBound concept. NoNodeBound disables bounding.
+    /// \tparam StateType The searched state, SearchState or FixedSearchState.
+    template <typename TimeType, typename IndexType, typename CostType, typename BrancherType,
+              typename BoundType = NoNodeBound<TimeType, IndexType, CostType>,
+              typename StateType = SearchState<TimeType, IndexType, CostType>>
+        requires Brancher<BrancherType, TimeType, IndexType, CostType, StateType> &&
+        NodeBound<BoundType, TimeType, IndexType, CostType, StateType>
+    class DepthFirstSolver
+    {
+    public:
+        using state_type = StateType;
+        using move_type = SearchMove<TimeType, IndexType, CostType>;
+        using undo_type = SearchUndo<TimeType, IndexType, CostType>;
+        using stack_type = SearchStack<move_type>;
+        using trail_type = SearchTrail<undo_type>;
+        using incumbent_type = SharedIncumbent<TimeType, IndexType, CostType>;
+        using size_type = std::size_t;
+
+        static constexpr CostType kNoSolution = incumbent_type::kNoSolution;
+
+        /// \brief Constructs a solver for an instance of the given size.
+        ///
+        /// \param num_berths The number of berths of the instance.
+        /// \param num_vessels The number of vessels of the instance.
+        /// \param brancher The branching rule used to expand nodes.
+        /// \param options The search limits.
+        LEVIATHAN_FORCE_INLINE DepthFirstSolver(const size_type num_berths, const size_type num_vessels,
+                                                BrancherType brancher, const DepthFirstSolverOptions options = {})
+            requires std::default_initializable<BoundType>
+            : DepthFirstSolver(num_berths, num_vessels, std::move(brancher), BoundType{}, options)
+        {
+        }
+
+        /// \brief Constructs a solver that prunes entered nodes with a bound.
+        ///
+        /// \param num_berths The number of berths of the instance.
+        /// \param num_vessels The number of vessels of the instance.
+        /// \param brancher The branching rule used to expand nodes.
+        /// \param bound The lower bound evaluated on entered nodes.
+        /// \param options The search limits.
+        LEVIATHAN_FORCE_INLINE DepthFirstSolver(const size_type num_berths, const size_type num_vessels,
+                                                BrancherType brancher, BoundType bound,
+                                                const DepthFirstSolverOptions options = {})
+            : state_(num_berths, num_vessels),
+              brancher_(std::move(brancher)),
+              bound_(std::move(bound)),
+              options_(options),
+              owned_incumbent_(num_vessels),
+              best_assignments_(num_vessels, state_type::kUnassignedVessel),
+              best_start_times_(num_vessels, 0)
+        {
+            stack_.reserve(dive_reserve_entries(num_berths, num_vessels, options_.reserve_max_dive),
+                           num_vessels + 1);
+            trail_.reserve(num_vessels, num_vessels);
+            if constexpr (kHashable)
+            {
+                if (options_.transposition_table_bytes > 0)
+                {
+                    state_.enable_zobrist_hash();
+                    table_.emplace(options_.transposition_table_bytes);
+                }
+            }
+            else
+            {
+                DCHECK_EQ(options_.transposition_table_bytes, 0u) << "the state keeps no Zobrist hash";
+            }
+        }
+
+        /// \brief Returns the root state. May be modified before solve() (e.g. initial berth free times).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE state_type& state() noexcept
+        {
+            return state_;
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const state_type& state() const noexcept
+        {
+            return state_;
+        }
+
+        /// \brief Returns the node bound.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE BoundType& bound() noexcept
+        {
+            return bound_;
+        }
+
+        /// \brief Resets the incumbent to an upper bound; only strictly better solutions will be reported.
+        ///
+        /// Must not be called while another solver searches with the same incumbent.
+        LEVIATHAN_FORCE_INLINE void set_upper_bound(const CostType upper_bound) noexcept
+        {
+            incumbent_->reset(upper_bound);
+            has_solution_ = false;
+        }
+
+        /// \brief Prunes against and publishes to an external incumbent instead of the owned one.
+        ///
+        /// \param incumbent The shared incumbent. Must outlive the solver.
+        LEVIATHAN_FORCE_INLINE void attach_incumbent(incumbent_type& incumbent) noexcept
+        {
+            incumbent_ = &incumbent;
+        }
+
+        /// \brief Returns the incumbent the solver prunes against.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE incumbent_type& incumbent() noexcept
+        {
+            return *incumbent_;
+        }
+
+        /// \brief Makes the search stop (as if a limit was hit) once `flag` becomes true.
+        ///
+        /// \param flag The stop flag, usually raised by another thread. Must outlive the solver.
+        LEVIATHAN_FORCE_INLINE void attach_stop_flag(const std::atomic<bool>& flag) noexcept
+        {
+            stop_flag_ = &flag;
+        }
+
+        /// \brief Runs the search from the current root state.
+        ///
+        /// On return the state is restored to the root, regardless of whether the
+        /// search was exhausted or stopped by a limit.
+        SearchStatus solve()
+        {
+            return solve(std::span<const move_type>{});
+        }
+
+        /// \brief Searches only the subtree below a decision path.
+        ///
+        /// The path is replayed from the root state first; its moves are not counted as nodes.
+        /// On return the state is restored to the root.
+        ///
+        /// \param prefix The moves leading from the root to the subtree, root first.
+        SearchStatus solve(const std::span<const move_type> prefix)
+        {
+            DCHECK(trail_.empty());
+            stack_.clear();
+            statistics_ = {};
+            if constexpr (kHashable)
+            {
+                if (table_)
+                {
+                    // The root may have been edited since the last call, and entries recorded
+                    // against another upper bound are not valid cuts anymore.
+                    state_.refresh_zobrist_hash();
+                    table_->clear();
+                    statistics_.transposition_bytes = table_->allocated_memory_bytes();
+                }
+            }
+            root_unassigned_ = static_cast<size_type>(state_.num_unassigned());
+            DCHECK_LE(prefix.size(), root_unassigned_);
+
+            for (const move_type& move : prefix)
+            {
+                apply_decision(state_, trail_, move);
+            }
+            base_depth_ = prefix.size();
+
+            if (base_depth_ == root_unassigned_)
+            {
+                record_solution();
+                unwind();
+                return finish(true);
+            }
+            if (is_root_bounded_out())
+            {
+                unwind();
+                return finish(true);
+            }
+
+            expand();
+            while (!stack_.empty())
+            {
+                if (stack_.current_frame_size() == 0)
+                {
+                    stack_.pop_frame();
+                    if (trail_.depth() > base_depth_)
+                    {
+                        retract();
+                    }
+                    continue;
+                }
+
+                const move_type move = stack_.top();
+                stack_.pop_entry();
+
+                if (move.lower_bound >= incumbent_->objective())
+                {
+                    ++statistics_.pruned;
+                    continue;
+                }
+
+                if (LEVIATHAN_UNLIKELY(statistics_.nodes >= options_.node_limit ||
+                    stop_flag_->load(std::memory_order_relaxed)))
+                {
+                    unwind();
+                    return finish(false);
+                }
+
+                advance(move);
+                ++statistics_.nodes;
+                statistics_.max_depth = std::max<std::uint64_t>(statistics_.max_depth, trail_.depth());
+
+                if (trail_.depth() == root_unassigned_)
+                {
+                    record_solution();
+                    retract();
+                    continue;
+                }
+
+                if (is_transposition() || is_bounded_out())
+                {
+                    retract();
+                    continue;
+                }
+
+                expand();
+            }
+
+            unwind();
+            return finish(true);
+        }
+
+        /// \brief Returns true if this solver has found a solution.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool has_solution() const noexcept
+        {
+            return has_solution_;
+        }
+
+        /// \brief Returns the objective of the incumbent (or the upper bound if none was found).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType best_objective() const noexcept
+        {
+            return incumbent_->objective();
+        }
+
+        /// \brief Returns the berth of every vessel in the best solution found by this solver.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const IndexType> best_assignments() const noexcept
+        {
+            return best_assignments_;
+        }
+
+        /// \brief Returns the start time of every vessel in the best solution found by this solver.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const TimeType> best_start_times() const noexcept
+        {
+            return best_start_times_;
+        }
+
+        /// \brief Returns the counters of the last solve() call.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const SearchStatistics& statistics() const noexcept
+        {
+            return statistics_;
+        }
+
+        /// \brief Returns the total bytes allocated by the stack, the trail and the transposition table.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type allocated_memory_bytes() const noexcept
+        {
+            return stack_.allocated_memory_bytes() + trail_.allocated_memory_bytes() +
+                (table_ ? table_->allocated_memory_bytes() : 0);
+        }
+
+    private:
+        /// \brief Generates the children of the current state into a new frame.
+        ///
+        /// The brancher emits children in preference order; the frame is reversed so that
+        /// the preferred child sits on top of the stack and is explored first.
+        LEVIATHAN_FORCE_INLINE void expand()
+        {
+            stack_.fill_frame([this](stack_type& stack)
+            {
+                brancher_.branch(state_, stack);
+            });
+            std::ranges::reverse(stack_.current_frame_entries());
+        }
+
+        /// \brief Applies a move below the searched root and lets the bound follow it.
+        LEVIATHAN_FORCE_INLINE void advance(const move_type& move)
+        {
+            apply_decision(state_, trail_, move);
+            if constexpr (kBounded)
+            {
+                bound_.notify_apply(state_, move);
+            }
+        }
+
+        /// \brief Reverts the most recent move; the bound follows it if it was applied below the searched root.
+        LEVIATHAN_FORCE_INLINE void retract()
+        {
+            if constexpr (kBounded)
+            {
+                if (trail_.depth() > base_depth_)
+                {
+                    backtrack_decision(state_, trail_, [this](const undo_type& undo)
+                    {
+                        bound_.notify_backtrack(state_, undo);
+                    });
+                    return;
+                }
+            }
+            backtrack_decision(state_, trail_);
+        }
+
+        /// \brief Initializes the bound on the searched root. Returns true if the whole subtree is pruned.
+        LEVIATHAN_FORCE_INLINE bool is_root_bounded_out()
+        {
+            if constexpr (kBounded)
+            {
+                const std::uint64_t sequence = incumbent_->sequence();
+                const CostType bound = bound_.bound_root(state_, *incumbent_);
+                if (incumbent_->sequence() != sequence && incumbent_->has_solution())
+                {
+                    incumbent_->read(best_assignments_, best_start_times_);
+                    has_solution_ = true;
+                    ++statistics_.solutions;
+                }
+                if (bound >= incumbent_->objective())
+                {
+                    ++statistics_.bound_cuts;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// \brief Returns true if the bound of the current state reached the incumbent.
+        LEVIATHAN_FORCE_INLINE bool is_bounded_out()
+        {
+            if constexpr (kBounded)
+            {
+                const CostType objective = incumbent_->objective();
+                if (bound_.bound_node(state_, objective) >= objective)
+                {
+                    ++statistics_.bound_cuts;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// \brief Returns true if the current state was already searched from an objective at least as good.
+        LEVIATHAN_FORCE_INLINE bool is_transposition()
+        {
+            if constexpr (kHashable)
+            {
+                if (!table_)
+                {
+                    return false;
+                }
+                ++statistics_.transposition_probes;
+                if (table_->probe_and_store(state_.zobrist_hash(), state_.current_objective))
+                {
+                    ++statistics_.transposition_hits;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        LEVIATHAN_FORCE_INLINE void record_solution()
+        {
+            // A FixedSearchState may hold more vessel slots than the instance has.
+            const size_type num_vessels = best_assignments_.size();
+            const std::span<const IndexType> assignments(state_.vessel_assignments.data(), num_vessels);
+            const std::span<const TimeType> start_times(state_.vessel_start_times.data(), num_vessels);
+            if (!incumbent_->try_improve(state_.current_objective, assignments, start_times))
+            {
+                return;
+            }
+            std::ranges::copy(assignments, best_assignments_.begin());
+            std::ranges::copy(start_times, best_start_times_.begin());
+            has_solution_ = true;
+            ++statistics_.solutions;
+
+            const CostType objective = incumbent_->objective();
+            statistics_.pruned += stack_.erase_if([objective](const move_type& move)
+            {
+                return move.lower_bound >= objective;
+            });
+        }
+
+        /// \brief Undoes all applied moves and drops all pending children.
+        LEVIATHAN_FORCE_INLINE void unwind()
+        {
+            while (!trail_.empty())
+            {
+                retract();
+            }
+            stack_.clear();
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE SearchStatus finish(const bool exhausted) const noexcept
+        {
+            const bool has_incumbent = incumbent_->has_solution();
+            if (exhausted)
+            {
+                return has_incumbent ? SearchStatus::kOptimal : SearchStatus::kInfeasible;
+            }
+            return has_incumbent ? SearchStatus::kFeasible : SearchStatus::kLimitReached;
+        }
+
+        static constexpr bool kBounded = !std::is_same_v<BoundType, NoNodeBound<TimeType, IndexType, CostType>>;
+        static constexpr bool kHashable = requires(state_type& state)
+        {
+            state.enable_zobrist_hash();
+            state.refresh_zobrist_hash();
+            state.zobrist_hash();
+        };
+
+        state_type state_;
+        stack_type stack_;
+        trail_type trail_;
+        BrancherType brancher_;
+        BoundType bound_;
+        DepthFirstSolverOptions options_;
+        SearchStatistics statistics_;
+        std::optional<TranspositionTable<CostType>> table_;
+        size_type root_unassigned_ = 0;
+        // Number of prefix moves replayed before the searched root.
+        size_type base_depth_ = 0;
+
+        incumbent_type owned_incumbent_;
+        incumbent_type* incumbent_ = &owned_incumbent_;
+        std::atomic<bool> never_stop_{false};
+        const std::atomic<bool>* stop_flag_ = &never_stop_;
+        bool has_solution_ = false;
+        std::vector<IndexType> best_assignments_;
+        std::vector<TimeType> best_start_times_;
+    };
+}
+
+#endif // LEVIATHAN_BNB_DEPTH_FIRST_SOLVER_H_
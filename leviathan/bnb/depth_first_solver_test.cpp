@@ -0,0 +1,506 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include "leviathan/bnb/allocation_counter.h"
+#include "leviathan/bnb/assignment_bound.h"
+#include "leviathan/bnb/assignment_brancher.h"
+#include "leviathan/bnb/decision_diagram.h"
+#include "leviathan/bnb/depth_first_solver.h"
+#include "leviathan/bnb/fixed_search_state.h"
+#include "leviathan/bnb/lagrangian_bound.h"
+#include "leviathan/bnb/preemptive_bound.h"
+#include "leviathan/bnb/test_util.h"
+
+using namespace leviathan::bnb::testing;
+using Brancher = leviathan::bnb::AssignmentBrancher<Time, Index, Cost>;
+using Solver = leviathan::bnb::DepthFirstSolver<Time, Index, Cost, Brancher>;
+using leviathan::bnb::SearchStatus;
+
+namespace
+{
+    /// \brief Bound-specific checks that expect_bound_keeps_optimum_and_prunes() runs after each search.
+    struct NoExtraChecks
+    {
+        template <typename BoundedSolver>
+        void operator()(const TestProblem&, BoundedSolver&, uint32_t) const
+        {
+        }
+    };
+
+    /// \brief Checks that the reported schedule really costs the reported objective.
+    struct ScheduleMatchesObjective
+    {
+        template <typename BoundedSolver>
+        void operator()(const TestProblem& problem, BoundedSolver& solver, const uint32_t seed) const
+        {
+            EXPECT_DOUBLE_EQ(evaluate_schedule(problem, solver.best_assignments(), solver.best_start_times()),
+                             solver.best_objective()) << "seed " << seed;
+        }
+    };
+
+    /// \brief Solves ten random 7 vessel, 2 berth instances with and without the bound `make_bound(problem)`.
+    ///
+    /// The bounded search must find the same optimum, enter at most as many nodes on every
+    /// instance and fewer in total. `check(problem, bounded_solver, seed)` runs after each
+    /// search and may search again.
+    template <typename MakeBound, typename Check = NoExtraChecks>
+    void expect_bound_keeps_optimum_and_prunes(const MakeBound& make_bound, const Check& check = {})
+    {
+        using Bound = std::invoke_result_t<const MakeBound&, const TestProblem&>;
+        using BoundedSolver = leviathan::bnb::DepthFirstSolver<Time, Index, Cost, Brancher, Bound>;
+
+        uint64_t plain_nodes = 0;
+        uint64_t bounded_nodes = 0;
+        for (uint32_t seed = 0; seed < 10; ++seed)
+        {
+            const TestProblem problem = make_random_problem(seed, 7, 2);
+            Solver plain(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+            BoundedSolver bounded(problem.num_berths(), problem.num_vessels(), Brancher(problem), make_bound(problem));
+
+            ASSERT_EQ(plain.solve(), SearchStatus::kOptimal) << "seed " << seed;
+            ASSERT_EQ(bounded.solve(), SearchStatus::kOptimal) << "seed " << seed;
+            EXPECT_DOUBLE_EQ(bounded.best_objective(), plain.best_objective()) << "seed " << seed;
+            EXPECT_LE(bounded.statistics().nodes, plain.statistics().nodes) << "seed " << seed;
+            EXPECT_EQ(plain.statistics().bound_cuts, 0u) << "seed " << seed;
+            plain_nodes += plain.statistics().nodes;
+            bounded_nodes += bounded.statistics().nodes;
+            check(problem, bounded, seed);
+        }
+        EXPECT_LT(bounded_nodes, plain_nodes);
+    }
+}
+
+TEST(DepthFirstSolverTest, SingleVesselPicksCheapestBerth)
+{
+    const TestProblem problem({0}, {1.0}, {7, 3}, {{0, 100}, {0, 100}});
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+
+    EXPECT_EQ(solver.solve(), SearchStatus::kOptimal);
+    EXPECT_EQ(solver.best_objective(), 3.0);
+    EXPECT_EQ(solver.best_assignments()[0], 1);
+    EXPECT_EQ(solver.best_start_times()[0], 0);
+}
+
+TEST(DepthFirstSolverTest, MatchesBruteForceOnRandomInstances)
+{
+    for (uint32_t seed = 0; seed < 20; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 5, 2);
+        Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+
+        ASSERT_EQ(solver.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(solver.best_objective(), brute_force_optimum(problem)) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(evaluate_schedule(problem, solver.best_assignments(), solver.best_start_times()),
+                         solver.best_objective()) << "seed " << seed;
+    }
+}
+
+TEST(DepthFirstSolverTest, StateIsRestoredAfterSolve)
+{
+    const TestProblem problem = make_random_problem(7, 5, 3);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+
+    ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+    EXPECT_EQ(solver.state().current_objective, 0.0);
+    for (Index v = 0; v < static_cast<Index>(problem.num_vessels()); ++v)
+    {
+        EXPECT_FALSE(solver.state().is_assigned(v));
+    }
+    for (const Time t : solver.state().berth_free_times)
+    {
+        EXPECT_EQ(t, 0);
+    }
+}
+
+TEST(DepthFirstSolverTest, NodeLimitStopsAndUnwinds)
+{
+    const TestProblem problem = make_random_problem(3, 6, 2);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.node_limit = 10});
+
+    const SearchStatus status = solver.solve();
+    EXPECT_TRUE(status == SearchStatus::kFeasible || status == SearchStatus::kLimitReached);
+    EXPECT_EQ(solver.statistics().nodes, 10);
+    EXPECT_EQ(solver.state().current_objective, 0.0);
+    EXPECT_EQ(solver.state().last_assigned_vessel, Solver::state_type::kUnassignedVessel);
+}
+
+TEST(DepthFirstSolverTest, UpperBoundPrunesEverything)
+{
+    const TestProblem problem = make_random_problem(11, 4, 2);
+    const Cost optimum = brute_force_optimum(problem);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+    solver.set_upper_bound(optimum);
+
+    EXPECT_EQ(solver.solve(), SearchStatus::kInfeasible);
+    EXPECT_FALSE(solver.has_solution());
+    EXPECT_GT(solver.statistics().pruned, 0);
+}
+
+TEST(DepthFirstSolverTest, InfeasibleInstance)
+{
+    // Both vessels need 30 time units but the only berth is open for 50.
+    const TestProblem problem({0, 0}, {1.0, 1.0}, {30, 30}, {{0, 50}});
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+
+    EXPECT_EQ(solver.solve(), SearchStatus::kInfeasible);
+    EXPECT_FALSE(solver.has_solution());
+}
+
+TEST(DepthFirstSolverTest, NoAllocationAfterConstruction)
+{
+    const TestProblem problem = make_random_problem(5, 6, 3);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+    const size_t bytes = solver.allocated_memory_bytes();
+
+    ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+    EXPECT_EQ(solver.allocated_memory_bytes(), bytes);
+    const Cost objective = solver.best_objective();
+
+    solver.set_upper_bound(Solver::kNoSolution);
+    ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+    EXPECT_EQ(solver.allocated_memory_bytes(), bytes);
+    EXPECT_EQ(solver.best_objective(), objective);
+
+    // With a transposition table, the hash keys are drawn at construction as well.
+    Solver hashed(problem.num_berths(), problem.num_vessels(), Brancher(problem),
+                  {.transposition_table_bytes = 1 << 16});
+    const uint64_t allocations = allocation_count();
+    ASSERT_EQ(hashed.solve(), SearchStatus::kOptimal);
+    hashed.set_upper_bound(Solver::kNoSolution);
+    hashed.state().berth_free_times[0] = 1;
+    ASSERT_EQ(hashed.solve(), SearchStatus::kOptimal);
+    EXPECT_EQ(allocation_count(), allocations);
+}
+
+TEST(DepthFirstSolverTest, ReservesTheDeepestDiveOnlyOnRequest)
+{
+    // The solver reserves before it searches, so the brancher's instance does not matter here.
+    const TestProblem problem = make_random_problem(5, 6, 3);
+    constexpr size_t kBerths = 50;
+    constexpr size_t kVessels = 60;
+    const size_t max_dive_bytes = leviathan::bnb::max_dive_entries(kBerths, kVessels) * sizeof(Solver::move_type);
+
+    const Solver capped(kBerths, kVessels, Brancher(problem));
+    const Solver full(kBerths, kVessels, Brancher(problem), {.reserve_max_dive = true});
+    EXPECT_LT(capped.allocated_memory_bytes(), max_dive_bytes);
+    EXPECT_GE(full.allocated_memory_bytes(), max_dive_bytes);
+}
+
+TEST(DepthFirstSolverTest, SolversShareAnIncumbent)
+{
+    const TestProblem problem = make_random_problem(13, 5, 2);
+    const Cost optimum = brute_force_optimum(problem);
+    Solver::incumbent_type incumbent(problem.num_vessels());
+
+    Solver first(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+    Solver second(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+    first.attach_incumbent(incumbent);
+    second.attach_incumbent(incumbent);
+
+    ASSERT_EQ(first.solve(), SearchStatus::kOptimal);
+    EXPECT_DOUBLE_EQ(incumbent.objective(), optimum);
+
+    // The second solver starts with the optimum as bound and prunes its whole tree.
+    ASSERT_EQ(second.solve(), SearchStatus::kOptimal);
+    EXPECT_FALSE(second.has_solution());
+    EXPECT_EQ(second.statistics().solutions, 0);
+    EXPECT_DOUBLE_EQ(second.best_objective(), optimum);
+}
+
+TEST(DepthFirstSolverTest, SolveBelowPrefix)
+{
+    const TestProblem problem = make_random_problem(21, 4, 2);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+
+    // Fix vessel 0 on berth 1 first, then compare against a solve of the full tree.
+    leviathan::bnb::SearchStack<Solver::move_type> stack;
+    stack.push_frame();
+    Brancher(problem).branch(solver.state(), stack);
+    const auto root_children = stack.current_frame_entries();
+    const auto it = std::ranges::find_if(root_children, [](const Solver::move_type& m)
+    {
+        return m.vessel == 0 && m.berth == 1;
+    });
+    ASSERT_NE(it, root_children.end());
+    const std::vector<Solver::move_type> prefix = {*it};
+
+    ASSERT_EQ(solver.solve(prefix), SearchStatus::kOptimal);
+    const Cost restricted = solver.best_objective();
+    EXPECT_EQ(solver.best_assignments()[0], 1);
+    EXPECT_FALSE(solver.state().is_assigned(0));
+
+    solver.set_upper_bound(Solver::kNoSolution);
+    ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+    EXPECT_LE(solver.best_objective(), restricted);
+}
+
+TEST(DepthFirstSolverTest, StopFlagEndsSearch)
+{
+    const TestProblem problem = make_random_problem(42, 8, 3);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+    const std::atomic<bool> stop{true};
+    solver.attach_stop_flag(stop);
+
+    const SearchStatus status = solver.solve();
+    EXPECT_TRUE(status == SearchStatus::kFeasible || status == SearchStatus::kLimitReached);
+    EXPECT_LE(solver.statistics().nodes, 1u);
+}
+
+TEST(DepthFirstSolverTest, RemainingCostBoundPrunesMore)
+{
+    for (uint32_t seed = 0; seed < 10; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 7, 2);
+        Solver plain(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+        Solver bounded(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+        bounded.state().enable_remaining_cost_bound(problem.ready_times(), problem.weights(),
+                                                    problem.min_processing_times());
+
+        ASSERT_EQ(plain.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        ASSERT_EQ(bounded.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(bounded.best_objective(), plain.best_objective()) << "seed " << seed;
+        EXPECT_LE(bounded.statistics().nodes, plain.statistics().nodes) << "seed " << seed;
+    }
+}
+
+TEST(DepthFirstSolverTest, LagrangianBoundKeepsTheOptimumAndPrunes)
+{
+    expect_bound_keeps_optimum_and_prunes([](const TestProblem& problem)
+    {
+        return leviathan::bnb::LagrangianBound<Time, Index, Cost>(problem);
+    }, ScheduleMatchesObjective{});
+}
+
+TEST(DepthFirstSolverTest, AssignmentBoundFollowsTheDive)
+{
+    expect_bound_keeps_optimum_and_prunes([](const TestProblem& problem)
+    {
+        return leviathan::bnb::AssignmentBound<Time, Index, Cost>(problem);
+    }, [](const TestProblem&, auto& solver, const uint32_t seed)
+    {
+        // Every move the solver applied was reverted on the bound as well.
+        EXPECT_TRUE(solver.bound().trail().empty()) << "seed " << seed;
+
+        // A second search re-solves the relaxation at the root instead of reusing stale duals.
+        const Cost optimum = solver.best_objective();
+        solver.set_upper_bound(Solver::kNoSolution);
+        ASSERT_EQ(solver.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(solver.best_objective(), optimum) << "seed " << seed;
+    });
+}
+
+TEST(DepthFirstSolverTest, PreemptiveBoundKeepsTheOptimumAndPrunes)
+{
+    expect_bound_keeps_optimum_and_prunes([](const TestProblem& problem)
+    {
+        return leviathan::bnb::PreemptiveBound<Time, Index, Cost>(problem);
+    });
+}
+
+TEST(DepthFirstSolverTest, DecisionDiagramKeepsTheOptimumAndPrunes)
+{
+    expect_bound_keeps_optimum_and_prunes([](const TestProblem& problem)
+    {
+        return leviathan::bnb::DecisionDiagram<Time, Index, Cost>(problem, {.width = 8});
+    }, ScheduleMatchesObjective{});
+}
+
+TEST(DepthFirstSolverTest, ExactDecisionDiagramSolvesTheRoot)
+{
+    using Bound = leviathan::bnb::DecisionDiagram<Time, Index, Cost>;
+    using BoundedSolver = leviathan::bnb::DepthFirstSolver<Time, Index, Cost, Brancher, Bound>;
+
+    for (uint32_t seed = 0; seed < 5; ++seed)
+    {
+        // Wide enough that neither diagram merges or drops a node: the restricted diagram
+        // seeds the optimum and the relaxed one proves it, so the root is cut.
+        const TestProblem problem = make_random_problem(seed, 5, 2);
+        BoundedSolver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem),
+                             Bound(problem, {.width = 1 << 12}));
+
+        ASSERT_EQ(solver.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(solver.best_objective(), brute_force_optimum(problem)) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(evaluate_schedule(problem, solver.best_assignments(), solver.best_start_times()),
+                         solver.best_objective()) << "seed " << seed;
+        EXPECT_EQ(solver.statistics().nodes, 0u) << "seed " << seed;
+        EXPECT_EQ(solver.statistics().bound_cuts, 1u) << "seed " << seed;
+    }
+}
+
+TEST(DepthFirstSolverTest, FixedSearchStateGivesTheSameSearch)
+{
+    // Eight vessel slots for seven vessels, so the slot past the instance is never touched.
+    using FixedState = leviathan::bnb::FixedSearchState<2, 8, Time, Index, Cost>;
+    using FixedBrancher = leviathan::bnb::AssignmentBrancher<Time, Index, Cost, FixedState>;
+    using FixedSolver = leviathan::bnb::DepthFirstSolver<Time, Index, Cost, FixedBrancher,
+                                                         leviathan::bnb::NoNodeBound<Time, Index, Cost>, FixedState>;
+
+    for (uint32_t seed = 0; seed < 10; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 7, 2);
+        Solver reference(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+        FixedSolver fixed(problem.num_berths(), problem.num_vessels(), FixedBrancher(problem));
+
+        ASSERT_EQ(reference.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        ASSERT_EQ(fixed.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(fixed.best_objective(), reference.best_objective()) << "seed " << seed;
+        EXPECT_TRUE(std::ranges::equal(fixed.best_assignments(), reference.best_assignments())) << "seed " << seed;
+        EXPECT_TRUE(std::ranges::equal(fixed.best_start_times(), reference.best_start_times())) << "seed " << seed;
+        EXPECT_EQ(fixed.statistics().nodes, reference.statistics().nodes) << "seed " << seed;
+        EXPECT_EQ(fixed.state().num_assigned(), 0u) << "seed " << seed;
+    }
+}
+
+TEST(DepthFirstSolverTest, UnassignedSetGivesTheSameSearch)
+{
+    for (uint32_t seed = 0; seed < 10; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 7, 2);
+        Solver plain(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+        Solver sparse(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+        sparse.state().enable_unassigned_set();
+
+        ASSERT_EQ(plain.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        ASSERT_EQ(sparse.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(sparse.best_objective(), plain.best_objective()) << "seed " << seed;
+        EXPECT_EQ(sparse.statistics().nodes, plain.statistics().nodes) << "seed " << seed;
+        EXPECT_EQ(sparse.state().num_unassigned(), problem.num_vessels());
+    }
+}
+
+TEST(DepthFirstSolverTest, TranspositionTableCutsRevisits)
+{
+    for (uint32_t seed = 0; seed < 10; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 7, 2);
+        Solver plain(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+        Solver cached(problem.num_berths(), problem.num_vessels(), Brancher(problem),
+                      {.transposition_table_bytes = 1 << 16});
+
+        ASSERT_EQ(plain.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        ASSERT_EQ(cached.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(cached.best_objective(), plain.best_objective()) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(evaluate_schedule(problem, cached.best_assignments(), cached.best_start_times()),
+                         cached.best_objective()) << "seed " << seed;
+        EXPECT_LE(cached.statistics().nodes, plain.statistics().nodes) << "seed " << seed;
+
+        const auto& statistics = cached.statistics();
+        EXPECT_GT(statistics.transposition_hits, 0) << "seed " << seed;
+        EXPECT_LE(statistics.transposition_hits, statistics.transposition_probes);
+        EXPECT_GT(statistics.transposition_hit_rate(), 0.0);
+        EXPECT_EQ(statistics.transposition_bytes, 1 << 16);
+        EXPECT_EQ(plain.statistics().transposition_probes, 0);
+        EXPECT_EQ(plain.statistics().transposition_bytes, 0);
+    }
+}
+
+TEST(DepthFirstSolverTest, TranspositionTableRespectsEditedRoot)
+{
+    const TestProblem problem = make_random_problem(21, 6, 2);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem),
+                  {.transposition_table_bytes = 1 << 12});
+    ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+    EXPECT_DOUBLE_EQ(solver.best_objective(), brute_force_optimum(problem));
+
+    // Delay both berths and solve again: entries of the first search must not leak into the second.
+    Solver reference(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+    for (Solver* s : {&solver, &reference})
+    {
+        s->state().berth_free_times = {15, 25};
+        s->set_upper_bound(Solver::kNoSolution);
+        ASSERT_EQ(s->solve(), SearchStatus::kOptimal);
+    }
+    EXPECT_DOUBLE_EQ(solver.best_objective(), reference.best_objective());
+}
+
+TEST(DepthFirstSolverTest, LeftShiftDominanceKeepsTheOptimum)
+{
+    for (uint32_t seed = 0; seed < 20; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 6, 2);
+        Solver plain(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+        Solver filtered(problem.num_berths(), problem.num_vessels(),
+                        Brancher(problem, {.left_shift_dominance = true}));
+
+        ASSERT_EQ(plain.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        ASSERT_EQ(filtered.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(filtered.best_objective(), brute_force_optimum(problem)) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(evaluate_schedule(problem, filtered.best_assignments(), filtered.best_start_times()),
+                         filtered.best_objective()) << "seed " << seed;
+        EXPECT_LE(filtered.statistics().nodes, plain.statistics().nodes) << "seed " << seed;
+    }
+}
+
+TEST(DepthFirstSolverTest, SymmetryBreakingKeepsTheOptimum)
+{
+    for (uint32_t seed = 0; seed < 8; ++seed)
+    {
+        // Vessels 0-2 and 3-4 are interchangeable, and so are berths 0 and 1.
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<Time> time(0, 30);
+        std::uniform_int_distribution<Time> duration(3, 15);
+        const std::vector<Time> ready_of_class = {time(rng), time(rng), time(rng), time(rng)};
+        const std::vector<size_t> vessel_class = {0, 0, 0, 1, 1, 2};
+        std::vector<std::vector<Time>> rows(4);
+        for (auto& row : rows)
+        {
+            const Time shared = duration(rng);
+            row = {shared, shared, duration(rng)};
+        }
+
+        std::vector<Time> ready;
+        std::vector<Cost> weights;
+        std::vector<Time> processing;
+        for (const size_t c : vessel_class)
+        {
+            ready.push_back(ready_of_class[c]);
+            weights.push_back(static_cast<Cost>(c % 2 + 1));
+            processing.insert(processing.end(), rows[c].begin(), rows[c].end());
+        }
+        const std::vector<leviathan::bnb::AvailableWindow<Time>> gap = {{0, 20}, {30, 100000}};
+        const TestProblem problem(std::move(ready), std::move(weights), std::move(processing),
+                                  {leviathan::bnb::BerthTimeline<Time>(0, 100000),
+                                   leviathan::bnb::BerthTimeline<Time>(0, 100000),
+                                   leviathan::bnb::BerthTimeline<Time>(gap)});
+
+        Solver plain(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+        Solver symmetric(problem.num_berths(), problem.num_vessels(),
+                         Brancher(problem, {.symmetry_breaking = true}));
+        Solver combined(problem.num_berths(), problem.num_vessels(),
+                        Brancher(problem, {.left_shift_dominance = true, .symmetry_breaking = true}));
+
+        ASSERT_EQ(plain.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        ASSERT_EQ(symmetric.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        ASSERT_EQ(combined.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(symmetric.best_objective(), plain.best_objective()) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(combined.best_objective(), plain.best_objective()) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(evaluate_schedule(problem, combined.best_assignments(), combined.best_start_times()),
+                         combined.best_objective()) << "seed " << seed;
+        EXPECT_LT(symmetric.statistics().nodes, plain.statistics().nodes) << "seed " << seed;
+        EXPECT_LE(combined.statistics().nodes, symmetric.statistics().nodes) << "seed " << seed;
+    }
+}
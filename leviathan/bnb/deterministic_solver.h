@@ -0,0 +1,419 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_DETERMINISTIC_SOLVER_H_
+#define LEVIATHAN_BNB_DETERMINISTIC_SOLVER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+#include "leviathan/bnb/depth_first_solver.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_stack.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/search_statistics.h"
+#include "leviathan/bnb/search_trail.h"
+#include "leviathan/bnb/shared_incumbent.h"
+
+namespace leviathan::bnb
+{
+    /// \brief Tuning knobs of the DeterministicSolver.
+    struct DeterministicSolverOptions
+    {
+        /// Number of worker threads; 0 selects std::thread::hardware_concurrency().
+        std::size_t num_threads = 0;
+        /// The root is expanded level by level until at least this many subproblems exist.
+        std::size_t min_subproblems = 256;
+        /// Number of subproblems solved between two synchronization points.
+        std::size_t subproblems_per_epoch = 64;
+        /// Maximum number of nodes to enter; checked at epoch boundaries only.
+        std::uint64_t node_limit = std::numeric_limits<std::uint64_t>::max();
+    };
+
+    /// \brief Parallel branch-and-bound whose result does not depend on thread timing.
+    ///
+    /// The root is split into a fixed list of subproblems by expanding it breadth-first in
+    /// brancher order. Subproblems are processed in epochs of a fixed size. Within an epoch,
+    /// every subproblem is searched by a DepthFirstSolver against the bound frozen at the start
+    /// of the epoch, so its tree only depends on that bound and its own decision path, never on
+    /// which thread runs it or when. At the epoch boundary the results are merged in subproblem
+    /// order and the new incumbent becomes the next frozen bound.
+    ///
+    /// As a consequence, the explored tree, the node counts and the final schedule are identical
+    /// from run to run, and, since neither the partition nor the epochs depend on it, for any
+    /// thread count. The price is that improvements only propagate at epoch boundaries and that
+    /// threads idle at the barrier while the slowest subproblem of an epoch finishes.
+    ///
+    /// \tparam BrancherType The branching rule, see the Brancher concept. Each worker gets a copy.
+    template <typename TimeType, typename IndexType, typename CostType, typename BrancherType>
+        requires Brancher<BrancherType, TimeType, IndexType, CostType> && std::copy_constructible<BrancherType>
+    class DeterministicSolver
+    {
+    public:
+        using state_type = SearchState<TimeType, IndexType, CostType>;
+        using move_type = SearchMove<TimeType, IndexType, CostType>;
+        using undo_type = SearchUndo<TimeType, IndexType, CostType>;
+        using stack_type = SearchStack<move_type>;
+        using trail_type = SearchTrail<undo_type>;
+        using incumbent_type = SharedIncumbent<TimeType, IndexType, CostType>;
+        using worker_type = DepthFirstSolver<TimeType, IndexType, CostType, BrancherType>;
+        using size_type = std::size_t;
+
+        static constexpr CostType kNoSolution = incumbent_type::kNoSolution;
+
+    private:
+        /// \brief The outcome of one subproblem of the current epoch.
+        struct SlotResult
+        {
+            bool found;
+            CostType objective;
+            SearchStatistics statistics;
+        };
+
+    public:
+        /// \brief Constructs a solver for an instance of the given size.
+        ///
+        /// \param num_berths The number of berths of the instance.
+        /// \param num_vessels The number of vessels of the instance.
+        /// \param brancher The branching rule; copied into every worker.
+        /// \param options The thread count, partitioning and search limits.
+        DeterministicSolver(const size_type num_berths, const size_type num_vessels, const BrancherType& brancher,
+                            const DeterministicSolverOptions options = {})
+            : root_(num_berths, num_vessels),
+              brancher_(brancher),
+              options_(options),
+              incumbent_(num_vessels),
+              best_assignments_(num_vessels, state_type::kUnassignedVessel),
+              best_start_times_(num_vessels, 0)
+        {
+            DCHECK_GT(options_.subproblems_per_epoch, 0u);
+            size_type threads = options_.num_threads;
+            if (threads == 0)
+            {
+                threads = std::max<size_type>(std::thread::hardware_concurrency(), 1);
+            }
+            workers_.reserve(threads);
+            for (size_type i = 0; i < threads; ++i)
+            {
+                workers_.push_back(std::make_unique<worker_type>(num_berths, num_vessels, brancher));
+            }
+
+            slots_.resize(options_.subproblems_per_epoch);
+            slot_assignments_.resize(options_.subproblems_per_epoch * num_vessels);
+            slot_start_times_.resize(options_.subproblems_per_epoch * num_vessels);
+            stack_.reserve(num_vessels * std::max<size_type>(num_berths, 1), 1);
+            trail_.reserve(num_vessels, num_vessels);
+        }
+
+        /// \brief Returns the root state. May be modified before solve() (e.g. initial berth free times).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE state_type& state() noexcept
+        {
+            return root_;
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const state_type& state() const noexcept
+        {
+            return root_;
+        }
+
+        /// \brief Resets the incumbent to an upper bound; only strictly better solutions will be reported.
+        LEVIATHAN_FORCE_INLINE void set_upper_bound(const CostType upper_bound) noexcept
+        {
+            incumbent_.reset(upper_bound);
+        }
+
+        /// \brief Returns the number of worker threads.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type num_threads() const noexcept
+        {
+            return workers_.size();
+        }
+
+        /// \brief Runs the search. The calling thread acts as worker 0.
+        SearchStatus solve()
+        {
+            statistics_ = {};
+            epochs_ = 0;
+            stopped_ = false;
+            root_unassigned_ = static_cast<size_type>(root_.num_unassigned());
+
+            for (const auto& worker : workers_)
+            {
+                worker->state() = root_;
+            }
+
+            partition();
+            begin_epoch(0);
+
+            if (!done_)
+            {
+                const auto num_workers = static_cast<std::ptrdiff_t>(workers_.size());
+                std::barrier barrier(num_workers, [this]() noexcept
+                {
+                    finish_epoch();
+                });
+
+                auto run = [this, &barrier](const size_type id)
+                {
+                    while (true)
+                    {
+                        size_type index;
+                        while ((index = next_subproblem_.fetch_add(1, std::memory_order_relaxed)) < epoch_end_)
+                        {
+                            solve_subproblem(id, index);
+                        }
+                        barrier.arrive_and_wait();
+                        if (done_)
+                        {
+                            return;
+                        }
+                    }
+                };
+
+                std::vector<std::thread> threads;
+                threads.reserve(workers_.size() - 1);
+                for (size_type i = 1; i < workers_.size(); ++i)
+                {
+                    threads.emplace_back(run, i);
+                }
+                run(0);
+                for (std::thread& thread : threads)
+                {
+                    thread.join();
+                }
+            }
+
+            const bool has_incumbent = incumbent_.has_solution();
+            if (has_incumbent)
+            {
+                incumbent_.read(best_assignments_, best_start_times_);
+            }
+            if (!stopped_)
+            {
+                return has_incumbent ? SearchStatus::kOptimal : SearchStatus::kInfeasible;
+            }
+            return has_incumbent ? SearchStatus::kFeasible : SearchStatus::kLimitReached;
+        }
+
+        /// \brief Returns true if the incumbent holds a solution.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool has_solution() const noexcept
+        {
+            return incumbent_.has_solution();
+        }
+
+        /// \brief Returns the objective of the incumbent (or the upper bound if none was found).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType best_objective() const noexcept
+        {
+            return incumbent_.objective();
+        }
+
+        /// \brief Returns the berth of every vessel in the incumbent.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const IndexType> best_assignments() const noexcept
+        {
+            return best_assignments_;
+        }
+
+        /// \brief Returns the start time of every vessel in the incumbent.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const TimeType> best_start_times() const noexcept
+        {
+            return best_start_times_;
+        }
+
+        /// \brief Returns the counters of the last solve() call; identical for every run.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const SearchStatistics& statistics() const noexcept
+        {
+            return statistics_;
+        }
+
+        /// \brief Returns the number of subproblems the root was split into.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type num_subproblems() const noexcept
+        {
+            return num_subproblems_;
+        }
+
+        /// \brief Returns the number of epochs of the last solve() call.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type num_epochs() const noexcept
+        {
+            return epochs_;
+        }
+
+    private:
+        /// \brief Splits the root breadth-first into at least min_subproblems decision paths.
+        ///
+        /// Every level is expanded completely and in brancher order, so the partition is a
+        /// pure function of the root state and the upper bound.
+        void partition()
+        {
+            subproblems_.clear();
+            num_subproblems_ = 1;
+            subproblem_depth_ = 0;
+
+            while (num_subproblems_ < options_.min_subproblems && subproblem_depth_ + 1 < root_unassigned_)
+            {
+                next_level_.clear();
+                size_type next_count = 0;
+
+                for (size_type i = 0; i < num_subproblems_; ++i)
+                {
+                    const auto path = subproblem(i);
+                    for (const move_type& move : path)
+                    {
+                        apply_decision(root_, trail_, move);
+                    }
+                    if (!path.empty())
+                    {
+                        ++statistics_.nodes;
+                    }
+
+                    stack_.fill_frame([this](stack_type& stack)
+                    {
+                        brancher_.branch(root_, stack);
+                    });
+                    for (const move_type& child : stack_.current_frame_entries())
+                    {
+                        if (child.lower_bound >= incumbent_.objective())
+                        {
+                            ++statistics_.pruned;
+                            continue;
+                        }
+                        next_level_.insert(next_level_.end(), path.begin(), path.end());
+                        next_level_.push_back(child);
+                        ++next_count;
+                    }
+                    stack_.pop_frame();
+
+                    while (!trail_.empty())
+                    {
+                        backtrack_decision(root_, trail_);
+                    }
+                }
+
+                subproblems_.swap(next_level_);
+                num_subproblems_ = next_count;
+                ++subproblem_depth_;
+                if (num_subproblems_ == 0)
+                {
+                    break;
+                }
+            }
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const move_type> subproblem(const size_type index) const
+        {
+            return std::span<const move_type>(subproblems_.data() + index * subproblem_depth_, subproblem_depth_);
+        }
+
+        LEVIATHAN_FORCE_INLINE void begin_epoch(const size_type begin)
+        {
+            epoch_begin_ = begin;
+            epoch_end_ = std::min(begin + options_.subproblems_per_epoch, num_subproblems_);
+            frozen_bound_ = incumbent_.objective();
+            next_subproblem_.store(begin, std::memory_order_relaxed);
+            done_ = begin >= num_subproblems_;
+        }
+
+        /// \brief Searches one subproblem against the frozen bound and stores its result in its slot.
+        void solve_subproblem(const size_type worker_id, const size_type index)
+        {
+            worker_type& worker = *workers_[worker_id];
+            worker.set_upper_bound(frozen_bound_);
+            worker.solve(subproblem(index));
+
+            const size_type slot = index - epoch_begin_;
+            const size_type num_vessels = root_.vessel_assignments.size();
+            slots_[slot] = SlotResult{worker.has_solution(), worker.best_objective(), worker.statistics()};
+            if (worker.has_solution())
+            {
+                std::ranges::copy(worker.best_assignments(), slot_assignments_.begin() + slot * num_vessels);
+                std::ranges::copy(worker.best_start_times(), slot_start_times_.begin() + slot * num_vessels);
+            }
+        }
+
+        /// \brief Barrier completion: merges the epoch in subproblem order and starts the next one.
+        void finish_epoch() noexcept
+        {
+            const size_type num_vessels = root_.vessel_assignments.size();
+            for (size_type slot = 0; slot < epoch_end_ - epoch_begin_; ++slot)
+            {
+                const SlotResult& result = slots_[slot];
+                statistics_.nodes += result.statistics.nodes;
+                statistics_.pruned += result.statistics.pruned;
+                statistics_.max_depth = std::max(statistics_.max_depth, result.statistics.max_depth);
+                if (result.found && incumbent_.try_improve(
+                    result.objective,
+                    std::span<const IndexType>(slot_assignments_.data() + slot * num_vessels, num_vessels),
+                    std::span<const TimeType>(slot_start_times_.data() + slot * num_vessels, num_vessels)))
+                {
+                    ++statistics_.solutions;
+                }
+            }
+            ++epochs_;
+
+            if (statistics_.nodes >= options_.node_limit && epoch_end_ < num_subproblems_)
+            {
+                stopped_ = true;
+                done_ = true;
+                return;
+            }
+            begin_epoch(epoch_end_);
+        }
+
+        state_type root_;
+        stack_type stack_;
+        trail_type trail_;
+        BrancherType brancher_;
+        DeterministicSolverOptions options_;
+        std::vector<std::unique_ptr<worker_type>> workers_;
+        SearchStatistics statistics_;
+        size_type root_unassigned_ = 0;
+
+        std::vector<move_type> subproblems_;
+        std::vector<move_type> next_level_;
+        size_type num_subproblems_ = 0;
+        size_type subproblem_depth_ = 0;
+
+        size_type epoch_begin_ = 0;
+        size_type epoch_end_ = 0;
+        size_type epochs_ = 0;
+        CostType frozen_bound_ = kNoSolution;
+        bool done_ = false;
+        bool stopped_ = false;
+        alignas(LEVIATHAN_CACHE_LINE_SIZE) std::atomic<size_type> next_subproblem_{0};
+
+        std::vector<SlotResult> slots_;
+        std::vector<IndexType> slot_assignments_;
+        std::vector<TimeType> slot_start_times_;
+
+        incumbent_type incumbent_;
+        std::vector<IndexType> best_assignments_;
+        std::vector<TimeType> best_start_times_;
+    };
+}
+
+#endif // LEVIATHAN_BNB_DETERMINISTIC_SOLVER_H_
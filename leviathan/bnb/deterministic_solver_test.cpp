@@ -0,0 +1,105 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "leviathan/bnb/assignment_brancher.h"
+#include "leviathan/bnb/deterministic_solver.h"
+#include "leviathan/bnb/test_util.h"
+
+using namespace leviathan::bnb::testing;
+using Brancher = leviathan::bnb::AssignmentBrancher<Time, Index, Cost>;
+using Solver = leviathan::bnb::DeterministicSolver<Time, Index, Cost, Brancher>;
+using leviathan::bnb::SearchStatus;
+
+TEST(DeterministicSolverTest, MatchesBruteForce)
+{
+    for (uint32_t seed = 0; seed < 10; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 5, 2);
+        Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem),
+                      {.num_threads = 3, .min_subproblems = 8, .subproblems_per_epoch = 4});
+
+        ASSERT_EQ(solver.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(solver.best_objective(), brute_force_optimum(problem)) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(evaluate_schedule(problem, solver.best_assignments(), solver.best_start_times()),
+                         solver.best_objective()) << "seed " << seed;
+    }
+}
+
+TEST(DeterministicSolverTest, RunsAreReproducibleAcrossThreadCounts)
+{
+    const TestProblem problem = make_random_problem(42, 8, 3);
+    const leviathan::bnb::DeterministicSolverOptions options = {
+        .num_threads = 1, .min_subproblems = 32, .subproblems_per_epoch = 8
+    };
+
+    Solver reference(problem.num_berths(), problem.num_vessels(), Brancher(problem), options);
+    ASSERT_EQ(reference.solve(), SearchStatus::kOptimal);
+    const std::vector<Index> assignments(reference.best_assignments().begin(), reference.best_assignments().end());
+    const std::vector<Time> start_times(reference.best_start_times().begin(), reference.best_start_times().end());
+
+    for (const size_t threads : {1, 2, 4})
+    {
+        for (int run = 0; run < 3; ++run)
+        {
+            auto run_options = options;
+            run_options.num_threads = threads;
+            Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem), run_options);
+            ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+
+            EXPECT_EQ(solver.best_objective(), reference.best_objective());
+            EXPECT_EQ(solver.statistics().nodes, reference.statistics().nodes);
+            EXPECT_EQ(solver.statistics().pruned, reference.statistics().pruned);
+            EXPECT_EQ(solver.statistics().solutions, reference.statistics().solutions);
+            EXPECT_EQ(solver.num_epochs(), reference.num_epochs());
+            EXPECT_TRUE(std::ranges::equal(solver.best_assignments(), assignments));
+            EXPECT_TRUE(std::ranges::equal(solver.best_start_times(), start_times));
+        }
+    }
+}
+
+TEST(DeterministicSolverTest, PartitionReachesRequestedSize)
+{
+    const TestProblem problem = make_random_problem(5, 6, 3);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem),
+                  {.num_threads = 2, .min_subproblems = 50, .subproblems_per_epoch = 16});
+
+    ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+    EXPECT_GE(solver.num_subproblems(), 50);
+    EXPECT_EQ(solver.num_epochs(), (solver.num_subproblems() + 15) / 16);
+}
+
+TEST(DeterministicSolverTest, NodeLimitIsReproducible)
+{
+    const TestProblem problem = make_random_problem(9, 8, 3);
+    const leviathan::bnb::DeterministicSolverOptions options = {
+        .num_threads = 2, .min_subproblems = 32, .subproblems_per_epoch = 4, .node_limit = 2000
+    };
+
+    Solver first(problem.num_berths(), problem.num_vessels(), Brancher(problem), options);
+    Solver second(problem.num_berths(), problem.num_vessels(), Brancher(problem), options);
+    const SearchStatus status = first.solve();
+    EXPECT_EQ(second.solve(), status);
+    EXPECT_EQ(first.statistics().nodes, second.statistics().nodes);
+    EXPECT_EQ(first.best_objective(), second.best_objective());
+}
@@ -0,0 +1,220 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef LEVIATHAN_BNB_FIXED_SEARCH_STATE_H_
+#define LEVIATHAN_BNB_FIXED_SEARCH_STATE_H_
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+
+namespace leviathan::bnb
+{
+    /// \brief A SearchState with compile-time dimensions, for small instances.
+    ///
+    /// Offers the core SearchState interface (apply_move, backtrack_move, is_assigned, the
+    /// assigned vessel set, ...) on `std::array` storage: the state lives in one contiguous,
+    /// trivially copyable block with no heap indirection, and loops over the berths have a
+    /// constant trip count the compiler can unroll. The assigned vessel set is a single
+    /// 64-bit word, which caps the vessel count at 64.
+    ///
+    /// The number of vessels may be smaller than `MaxVessels`; slots past num_vessels() stay
+    /// unassigned and are never visited. The optional structures of SearchState (remaining
+    /// cost bound, Zobrist hash, unassigned set, berth tree, snapshots) are not provided.
+    ///
+    /// AssignmentBrancher and DepthFirstSolver take it through their `StateType` parameter;
+    /// without a Zobrist hash, the solver's transposition table must stay disabled.
+    ///
+    /// \tparam NumBerths The number of berths.
+    /// \tparam MaxVessels The largest number of vessels the state can hold, at most 64.
+    template <std::size_t NumBerths, std::size_t MaxVessels, typename TimeType, typename IndexType, typename CostType>
+        requires (NumBerths > 0) && (MaxVessels <= 64) &&
+        std::integral<TimeType> && std::is_signed_v<TimeType> &&
+        std::integral<IndexType> && std::is_signed_v<IndexType> &&
+        std::is_arithmetic_v<CostType>
+    class FixedSearchState
+    {
+    public:
+        using time_type = TimeType;
+        using index_type = IndexType;
+        using cost_type = CostType;
+
+        static constexpr IndexType kUnassignedVessel = -1;
+        static constexpr std::size_t kNumBerths = NumBerths;
+        static constexpr std::size_t kMaxVessels = MaxVessels;
+
+        std::array<TimeType, NumBerths> berth_free_times{};
+        std::array<IndexType, MaxVessels> vessel_assignments;
+        std::array<TimeType, MaxVessels> vessel_start_times{};
+        IndexType last_assigned_vessel = kUnassignedVessel;
+        CostType current_objective = 0;
+
+        /// \brief Constructs a state with all berths free at time 0 and all vessels unassigned.
+        ///
+        /// Takes the same arguments as SearchState so generic code can construct either.
+        ///
+        /// \param num_berths Must equal `NumBerths`.
+        /// \param num_vessels The number of vessels, at most `MaxVessels`.
+        LEVIATHAN_FORCE_INLINE explicit FixedSearchState(const std::size_t num_berths = NumBerths,
+                                                         const std::size_t num_vessels = MaxVessels)
+            : num_vessels_(num_vessels)
+        {
+            DCHECK_EQ(num_berths, NumBerths);
+            DCHECK_LE(num_vessels, MaxVessels);
+            vessel_assignments.fill(kUnassignedVessel);
+        }
+
+        /// \brief Returns the number of berths.
+        [[nodiscard]] static constexpr std::size_t num_berths() noexcept
+        {
+            return NumBerths;
+        }
+
+        /// \brief Returns the number of vessels.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::size_t num_vessels() const noexcept
+        {
+            return num_vessels_;
+        }
+
+        /// \brief Checks if a vessel is currently assigned to a berth.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool is_assigned(const IndexType v_idx) const
+        {
+            DCHECK_GE(v_idx, 0);
+            DCHECK_LT(static_cast<std::size_t>(v_idx), num_vessels_);
+            return (assigned_ >> v_idx) & 1;
+        }
+
+        /// \brief Retrieves the start time of an assigned vessel.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE TimeType get_start_time(const IndexType v_idx) const
+        {
+            DCHECK(is_assigned(v_idx));
+            return vessel_start_times[v_idx];
+        }
+
+        /// \brief Retrieves the berth of an assigned vessel.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE IndexType get_assigned_berth(const IndexType v_idx) const
+        {
+            DCHECK(is_assigned(v_idx));
+            return vessel_assignments[v_idx];
+        }
+
+        /// \brief Applies a move to the state; see SearchState::apply_move().
+        LEVIATHAN_FORCE_INLINE void apply_move(const IndexType v_idx, const IndexType b_idx, const TimeType start_time,
+                                               const TimeType finish_time, const CostType cost_delta)
+        {
+            DCHECK(!is_assigned(v_idx));
+            DCHECK_GE(b_idx, 0);
+            DCHECK_LT(static_cast<std::size_t>(b_idx), NumBerths);
+            berth_free_times[b_idx] = finish_time;
+            vessel_assignments[v_idx] = b_idx;
+            assigned_ |= std::uint64_t{1} << v_idx;
+            vessel_start_times[v_idx] = start_time;
+            current_objective += cost_delta;
+            last_assigned_vessel = v_idx;
+        }
+
+        /// \brief Reverts a move; see SearchState::backtrack_move().
+        LEVIATHAN_FORCE_INLINE void backtrack_move(const IndexType v_idx, const IndexType b_idx,
+                                                   const TimeType old_berth_free_time, const CostType old_objective,
+                                                   const IndexType old_last_vessel)
+        {
+            DCHECK(is_assigned(v_idx));
+            berth_free_times[b_idx] = old_berth_free_time;
+            vessel_assignments[v_idx] = kUnassignedVessel;
+            assigned_ &= ~(std::uint64_t{1} << v_idx);
+            current_objective = old_objective;
+            last_assigned_vessel = old_last_vessel;
+        }
+
+        /// \brief Returns the assigned vessel set as a bit mask (bit v for vessel v).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::uint64_t assigned_mask() const noexcept
+        {
+            return assigned_;
+        }
+
+        /// \brief Returns the number of assigned vessels.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::size_t num_assigned() const noexcept
+        {
+            return static_cast<std::size_t>(std::popcount(assigned_));
+        }
+
+        /// \brief Returns the number of vessels that still need a berth.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::size_t num_unassigned() const noexcept
+        {
+            return num_vessels_ - num_assigned();
+        }
+
+        /// \brief Calls `f(v)` for every unassigned vessel in increasing index order.
+        ///
+        /// If `f` returns \c bool, iteration stops at the first \c false.
+        ///
+        /// \return \c false if `f` stopped the iteration, \c true otherwise.
+        template <typename F>
+            requires std::invocable<F&, IndexType>
+        LEVIATHAN_FORCE_INLINE bool for_each_unassigned(F&& f) const
+        {
+            for (std::uint64_t open = ~assigned_ & vessel_mask(); open != 0; open &= open - 1)
+            {
+                const auto v = static_cast<IndexType>(std::countr_zero(open));
+                if constexpr (std::is_same_v<std::invoke_result_t<F&, IndexType>, bool>)
+                {
+                    if (!f(v))
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    f(v);
+                }
+            }
+            return true;
+        }
+
+        /// \brief Returns the berth with the earliest free time (the smallest index on ties).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE IndexType earliest_free_berth() const noexcept
+        {
+            std::size_t best = 0;
+            for (std::size_t b = 1; b < NumBerths; ++b)
+            {
+                best = berth_free_times[b] < berth_free_times[best] ? b : best;
+            }
+            return static_cast<IndexType>(best);
+        }
+
+    private:
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::uint64_t vessel_mask() const noexcept
+        {
+            return num_vessels_ == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << num_vessels_) - 1;
+        }
+
+        std::uint64_t assigned_ = 0;
+        std::size_t num_vessels_;
+    };
+}
+
+#endif // LEVIATHAN_BNB_FIXED_SEARCH_STATE_H_
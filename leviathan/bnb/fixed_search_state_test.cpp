@@ -0,0 +1,162 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include "leviathan/bnb/fixed_search_state.h"
+#include "leviathan/bnb/search_state.h"
+
+using Time = int64_t;
+using Index = int32_t;
+using Cost = double;
+using State = leviathan::bnb::SearchState<Time, Index, Cost>;
+using FixedState = leviathan::bnb::FixedSearchState<4, 64, Time, Index, Cost>;
+
+static_assert(std::is_trivially_copyable_v<FixedState>);
+
+TEST(FixedSearchStateTest, InitialState)
+{
+    const FixedState state(4, 10);
+    EXPECT_EQ(state.num_berths(), 4u);
+    EXPECT_EQ(state.num_vessels(), 10u);
+    EXPECT_EQ(state.num_unassigned(), 10u);
+    EXPECT_EQ(state.assigned_mask(), 0u);
+    EXPECT_EQ(state.last_assigned_vessel, FixedState::kUnassignedVessel);
+    for (const Time t : state.berth_free_times)
+    {
+        EXPECT_EQ(t, 0);
+    }
+
+    std::vector<Index> visited;
+    state.for_each_unassigned([&](const Index v) { visited.push_back(v); });
+    EXPECT_EQ(visited.size(), 10u);
+    EXPECT_EQ(visited.back(), 9);
+}
+
+TEST(FixedSearchStateTest, MatchesSearchStateUnderApplyAndBacktrack)
+{
+    struct Undo
+    {
+        Index vessel;
+        Index berth;
+        Time free_time;
+        Cost objective;
+        Index last;
+    };
+
+    for (const size_t num_vessels : {1u, 13u, 64u})
+    {
+        std::mt19937 rng(static_cast<uint32_t>(num_vessels));
+        State reference(4, num_vessels);
+        FixedState fixed(4, num_vessels);
+        std::vector<Undo> trail;
+
+        for (int step = 0; step < 2000; ++step)
+        {
+            const bool can_apply = reference.num_unassigned() > 0;
+            if (can_apply && (trail.empty() || rng() % 3 != 0))
+            {
+                std::vector<Index> open;
+                reference.for_each_unassigned([&](const Index v) { open.push_back(v); });
+                const Index v = open[rng() % open.size()];
+                const auto b = static_cast<Index>(rng() % 4);
+                const Time start = reference.berth_free_times[b] + static_cast<Time>(rng() % 5);
+                const Time finish = start + 1 + static_cast<Time>(rng() % 20);
+                const Cost delta = static_cast<Cost>(finish);
+                trail.push_back({v, b, reference.berth_free_times[b], reference.current_objective,
+                                 reference.last_assigned_vessel});
+                reference.apply_move(v, b, start, finish, delta);
+                fixed.apply_move(v, b, start, finish, delta);
+            }
+            else
+            {
+                const Undo u = trail.back();
+                trail.pop_back();
+                reference.backtrack_move(u.vessel, u.berth, u.free_time, u.objective, u.last);
+                fixed.backtrack_move(u.vessel, u.berth, u.free_time, u.objective, u.last);
+            }
+
+            ASSERT_EQ(fixed.num_unassigned(), reference.num_unassigned());
+            ASSERT_EQ(fixed.current_objective, reference.current_objective);
+            ASSERT_EQ(fixed.last_assigned_vessel, reference.last_assigned_vessel);
+            for (size_t b = 0; b < 4; ++b)
+            {
+                ASSERT_EQ(fixed.berth_free_times[b], reference.berth_free_times[b]);
+            }
+            for (Index v = 0; v < static_cast<Index>(num_vessels); ++v)
+            {
+                ASSERT_EQ(fixed.is_assigned(v), reference.is_assigned(v));
+                if (reference.is_assigned(v))
+                {
+                    ASSERT_EQ(fixed.get_assigned_berth(v), reference.get_assigned_berth(v));
+                    ASSERT_EQ(fixed.get_start_time(v), reference.get_start_time(v));
+                }
+            }
+        }
+    }
+}
+
+TEST(FixedSearchStateTest, ForEachUnassignedSkipsUnusedSlots)
+{
+    FixedState state(4, 5);
+    state.apply_move(2, 0, 0, 4, 4.0);
+
+    std::vector<Index> visited;
+    EXPECT_TRUE(state.for_each_unassigned([&](const Index v) { visited.push_back(v); }));
+    EXPECT_EQ(visited, (std::vector<Index>{0, 1, 3, 4}));
+
+    visited.clear();
+    EXPECT_FALSE(state.for_each_unassigned([&](const Index v)
+    {
+        visited.push_back(v);
+        return v < 1;
+    }));
+    EXPECT_EQ(visited, (std::vector<Index>{0, 1}));
+}
+
+TEST(FixedSearchStateTest, EarliestFreeBerth)
+{
+    FixedState state;
+    EXPECT_EQ(state.earliest_free_berth(), 0);
+    state.berth_free_times = {9, 4, 7, 4};
+    EXPECT_EQ(state.earliest_free_berth(), 1);
+    state.apply_move(0, 1, 4, 12, 12.0);
+    EXPECT_EQ(state.earliest_free_berth(), 3);
+}
+
+#ifndef NDEBUG
+TEST(FixedSearchStateDeathTest, DoubleAssignment)
+{
+    FixedState state(4, 2);
+    state.apply_move(0, 0, 0, 10, 5.0);
+    EXPECT_DEATH(state.apply_move(0, 1, 10, 20, 5.0), "");
+}
+
+TEST(FixedSearchStateDeathTest, TooManyVessels)
+{
+    EXPECT_DEATH(FixedState(4, 65), "");
+    EXPECT_DEATH(FixedState(3, 10), "");
+}
+#endif
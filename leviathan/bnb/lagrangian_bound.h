@@ -0,0 +1,466 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef LEVIATHAN_BNB_LAGRANGIAN_BOUND_H_
+#define LEVIATHAN_BNB_LAGRANGIAN_BOUND_H_
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include "absl/log/check.h"
+#include "leviathan/base/aligned_allocator.h"
+#include "leviathan/base/config.h"
+#include "leviathan/base/system_info.h"
+#include "leviathan/bnb/lower_bound_kernel.h"
+#include "leviathan/bnb/problem.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/shared_incumbent.h"
+
+namespace leviathan::bnb
+{
+    /// \brief Tuning knobs of the LagrangianBound.
+    struct LagrangianBoundOptions
+    {
+        /// Number of unit periods that carry a multiplier. 0 derives the latest ready time plus
+        /// the sum of the longest processing times. Periods beyond the horizon are free.
+        std::int64_t horizon = 0;
+        /// Subgradient steps of solve_root().
+        std::uint32_t root_iterations = 200;
+        /// Subgradient steps of evaluate(), warm-started from the current multipliers.
+        std::uint32_t node_iterations = 5;
+        /// Initial scale of the Polyak step.
+        double initial_step = 2.0;
+        /// Number of steps without improvement after which the step scale is halved.
+        std::uint32_t patience = 10;
+    };
+
+    /// \brief Lagrangian lower bound that relaxes the no-overlap constraints of the berths.
+    ///
+    /// In the time-indexed view, at most one vessel may occupy berth b in period t. Pricing these
+    /// capacities with multipliers `lambda[b][t] >= 0` decouples the vessels: each picks the
+    /// berth and start (inside the berth's windows, not before its ready time or the berth's
+    /// free time) that minimizes its cost plus the prices of the periods it occupies, and the
+    /// bound is the sum of these choices minus the total price of all periods still open. Any
+    /// non-negative multipliers give a valid bound; subgradient optimization with Polyak steps
+    /// raises it.
+    ///
+    /// solve_root() optimizes the multipliers from zero. evaluate() warm-starts from wherever the
+    /// multipliers are and performs only a few steps, so along a dive they keep adapting to the
+    /// shrinking subproblem. The multipliers are stored structure-of-arrays, one cache-aligned
+    /// row of periods per berth, and each vessel's best start on a berth is found with the
+    /// vectorized min_sloped_difference() kernel over the row's prefix sums.
+    ///
+    /// As a NodeBound, the bound runs solve_root() on the root of every search and evaluate() on
+    /// every node the solver enters, so the multipliers follow the dive from node to node.
+    ///
+    /// Weights must be non-negative and times non-negative.
+    template <typename TimeType, typename IndexType, typename CostType>
+        requires std::floating_point<CostType>
+    class LagrangianBound
+    {
+    public:
+        using problem_type = Problem<TimeType, IndexType, CostType>;
+        using state_type = SearchState<TimeType, IndexType, CostType>;
+        using move_type = SearchMove<TimeType, IndexType, CostType>;
+        using undo_type = SearchUndo<TimeType, IndexType, CostType>;
+        using incumbent_type = SharedIncumbent<TimeType, IndexType, CostType>;
+
+        static constexpr IndexType kNoBerth = -1;
+
+        /// \brief Constructs the bound with all multipliers at zero.
+        ///
+        /// \param problem The problem instance. Must outlive the bound.
+        /// \param options Horizon and subgradient settings.
+        explicit LagrangianBound(const problem_type& problem, const LagrangianBoundOptions& options = {})
+            : problem_(&problem),
+              options_(options),
+              horizon_(options.horizon > 0 ? static_cast<size_t>(options.horizon) : default_horizon(problem)),
+              stride_(round_up_to_cache_line(horizon_ + 1)),
+              level_(leviathan::system::get_simd_level())
+        {
+            const size_t cells = problem.num_berths() * stride_;
+            multipliers_.assign(cells, CostType{0});
+            root_multipliers_.assign(cells, CostType{0});
+            prefix_.assign(cells, CostType{0});
+            subgradient_.assign(cells, CostType{0});
+            chosen_berth_.assign(problem.num_vessels(), kNoBerth);
+            chosen_start_.assign(problem.num_vessels(), TimeType{0});
+            root_step_ = options.initial_step;
+        }
+
+        /// \brief Optimizes the multipliers from zero for the root `state` and remembers them.
+        ///
+        /// \param state The root state.
+        /// \param upper_bound The objective of the best known solution, if any. Steers the step size.
+        /// \return A lower bound on the objective of any completion of `state`, or infinity if
+        ///         some unassigned vessel has no feasible berth.
+        CostType solve_root(const state_type& state,
+                            const CostType upper_bound = std::numeric_limits<CostType>::infinity())
+        {
+            std::ranges::fill(multipliers_, CostType{0});
+            double step = options_.initial_step;
+            const CostType bound = optimize(state, upper_bound, options_.root_iterations, step);
+            root_multipliers_ = multipliers_;
+            root_step_ = step;
+            return bound;
+        }
+
+        /// \brief Bounds `state` with a few subgradient steps from the current multipliers.
+        ///
+        /// \param state The state to bound.
+        /// \param upper_bound The objective of the best known solution, if any. Once the bound
+        ///        reaches it, the remaining steps are skipped.
+        /// \return A lower bound on the objective of any completion of `state`, or infinity if
+        ///         some unassigned vessel has no feasible berth.
+        CostType evaluate(const state_type& state,
+                          const CostType upper_bound = std::numeric_limits<CostType>::infinity())
+        {
+            double step = root_step_;
+            return optimize(state, upper_bound, options_.node_iterations, step);
+        }
+
+        /// \name NodeBound hooks
+        /// @{
+
+        /// \brief Runs solve_root() with the incumbent objective as the step target.
+        CostType bound_root(const state_type& state, const incumbent_type& incumbent)
+        {
+            return solve_root(state, finite_or_infinity(incumbent.objective()));
+        }
+
+        /// \brief Runs evaluate(), warm-started from the multipliers the previous node left behind.
+        CostType bound_node(const state_type& state, const CostType upper_bound)
+        {
+            return evaluate(state, finite_or_infinity(upper_bound));
+        }
+
+        /// \brief The multipliers carry over between nodes unchanged, so moves need no bookkeeping.
+        LEVIATHAN_FORCE_INLINE void notify_apply(const state_type&, const move_type&) noexcept
+        {
+        }
+
+        LEVIATHAN_FORCE_INLINE void notify_backtrack(const state_type&, const undo_type&) noexcept
+        {
+        }
+
+        /// @}
+
+        /// \brief Restores the multipliers found by the last solve_root().
+        LEVIATHAN_FORCE_INLINE void reset_to_root()
+        {
+            multipliers_ = root_multipliers_;
+        }
+
+        /// \brief Returns the number of periods that carry a multiplier.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_t horizon() const noexcept
+        {
+            return horizon_;
+        }
+
+        /// \brief Returns the multipliers of a berth, one per period of the horizon.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const CostType> multipliers(const IndexType b_idx) const
+        {
+            DCHECK_GE(b_idx, 0);
+            DCHECK_LT(static_cast<size_t>(b_idx), problem_->num_berths());
+            return std::span<const CostType>(multipliers_.data() + static_cast<size_t>(b_idx) * stride_, horizon_);
+        }
+
+        /// \brief Returns the berth the last evaluation chose for an unassigned vessel.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE IndexType chosen_berth(const IndexType v_idx) const
+        {
+            DCHECK_GE(v_idx, 0);
+            DCHECK_LT(static_cast<size_t>(v_idx), problem_->num_vessels());
+            return chosen_berth_[v_idx];
+        }
+
+        /// \brief Returns the start time the last evaluation chose for an unassigned vessel.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE TimeType chosen_start(const IndexType v_idx) const
+        {
+            DCHECK_GE(v_idx, 0);
+            DCHECK_LT(static_cast<size_t>(v_idx), problem_->num_vessels());
+            return chosen_start_[v_idx];
+        }
+
+        /// \brief Returns the total bytes allocated (capacity) by the bound.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_t allocated_memory_bytes() const noexcept
+        {
+            return (multipliers_.capacity() + root_multipliers_.capacity() + prefix_.capacity() +
+                    subgradient_.capacity()) * sizeof(CostType) +
+                chosen_berth_.capacity() * sizeof(IndexType) + chosen_start_.capacity() * sizeof(TimeType);
+        }
+
+    private:
+        using row_type = leviathan::memory::AlignedVector<CostType>;
+
+        [[nodiscard]] static size_t default_horizon(const problem_type& problem)
+        {
+            TimeType latest_ready = 0;
+            TimeType total_processing = 0;
+            for (IndexType v = 0; v < static_cast<IndexType>(problem.num_vessels()); ++v)
+            {
+                latest_ready = std::max(latest_ready, problem.ready_time(v));
+                const auto row = problem.processing_times_row(v);
+                total_processing += row.empty() ? TimeType{0} : std::ranges::max(row);
+            }
+            return static_cast<size_t>(latest_ready + total_processing);
+        }
+
+        /// \brief Maps the "no solution" objective of the incumbent to the "no upper bound" of optimize().
+        [[nodiscard]] static LEVIATHAN_FORCE_INLINE CostType finite_or_infinity(const CostType upper_bound) noexcept
+        {
+            return upper_bound == incumbent_type::kNoSolution ? std::numeric_limits<CostType>::infinity() : upper_bound;
+        }
+
+        [[nodiscard]] static constexpr size_t round_up_to_cache_line(const size_t count) noexcept
+        {
+            constexpr size_t kPerLine = LEVIATHAN_CACHE_LINE_SIZE / sizeof(CostType);
+            return (count + kPerLine - 1) / kPerLine * kPerLine;
+        }
+
+        CostType optimize(const state_type& state, const CostType upper_bound, const std::uint32_t iterations,
+                          double& step)
+        {
+            DCHECK_EQ(state.berth_free_times.size(), problem_->num_berths());
+            DCHECK_EQ(state.vessel_assignments.size(), problem_->num_vessels());
+
+            CostType best = -std::numeric_limits<CostType>::infinity();
+            std::uint32_t stalled = 0;
+            for (std::uint32_t k = 0;; ++k)
+            {
+                rebuild_prefix();
+                const CostType value = lagrangian_value(state);
+                if (value == std::numeric_limits<CostType>::infinity())
+                {
+                    return value;
+                }
+                if (value > best)
+                {
+                    best = value;
+                    stalled = 0;
+                }
+                else if (++stalled >= options_.patience)
+                {
+                    step *= 0.5;
+                    stalled = 0;
+                }
+
+                if (k == iterations)
+                {
+                    break;
+                }
+                const CostType target = upper_bound == std::numeric_limits<CostType>::infinity()
+                                            ? best + std::max(std::abs(best) * CostType{0.05}, CostType{1})
+                                            : upper_bound - state.current_objective;
+                if (value >= target || !take_step(state, value, target, step))
+                {
+                    break;
+                }
+            }
+            return state.current_objective + best;
+        }
+
+        LEVIATHAN_FORCE_INLINE void rebuild_prefix() noexcept
+        {
+            for (size_t b = 0; b < problem_->num_berths(); ++b)
+            {
+                const CostType* lambda = multipliers_.data() + b * stride_;
+                CostType* prefix = prefix_.data() + b * stride_;
+                prefix[0] = 0;
+                for (size_t t = 0; t < horizon_; ++t)
+                {
+                    prefix[t + 1] = prefix[t] + lambda[t];
+                }
+            }
+        }
+
+        /// \brief Evaluates the Lagrangian function at the current multipliers and records each vessel's choice.
+        CostType lagrangian_value(const state_type& state)
+        {
+            const auto horizon = static_cast<TimeType>(horizon_);
+            CostType value = 0;
+            for (size_t b = 0; b < problem_->num_berths(); ++b)
+            {
+                const CostType* prefix = prefix_.data() + b * stride_;
+                const auto open = static_cast<size_t>(std::min(state.berth_free_times[b], horizon));
+                value -= prefix[horizon_] - prefix[open];
+            }
+
+            const bool feasible = state.for_each_unassigned([&](const IndexType v)
+            {
+                const TimeType ready = problem_->ready_time(v);
+                const CostType weight = problem_->weight(v);
+                CostType best = std::numeric_limits<CostType>::infinity();
+                IndexType best_berth = kNoBerth;
+                TimeType best_start = 0;
+                const auto consider = [&](const CostType cost, const IndexType b, const TimeType start)
+                {
+                    if (cost < best)
+                    {
+                        best = cost;
+                        best_berth = b;
+                        best_start = start;
+                    }
+                };
+
+                for (IndexType b = 0; b < static_cast<IndexType>(problem_->num_berths()); ++b)
+                {
+                    const TimeType duration = problem_->processing_time(v, b);
+                    const TimeType earliest = std::max(ready, state.berth_free_times[b]);
+                    DCHECK_GE(earliest, 0);
+                    const CostType* prefix = prefix_.data() + static_cast<size_t>(b) * stride_;
+                    const auto& timeline = problem_->timeline(b);
+
+                    for (auto it = std::lower_bound(timeline.begin(), timeline.end(), earliest);
+                         it != timeline.end(); ++it)
+                    {
+                        const TimeType first = std::max(it->start_inclusive, earliest);
+                        const TimeType last = it->end_exclusive - duration;
+                        if (last < first)
+                        {
+                            continue;
+                        }
+
+                        // Starts whose whole stay is priced: one vectorized scan over the prefix sums.
+                        const TimeType priced_last = std::min(last, horizon - duration);
+                        if (first <= priced_last)
+                        {
+                            const auto count = static_cast<size_t>(priced_last - first + 1);
+                            const auto offset = static_cast<size_t>(first);
+                            const SlopedMinimum<CostType> cheapest = min_sloped_difference<CostType>(
+                                std::span<const CostType>(prefix + offset, count),
+                                std::span<const CostType>(prefix + offset + static_cast<size_t>(duration), count),
+                                weight, level_);
+                            const TimeType start = first + static_cast<TimeType>(cheapest.index);
+                            consider(problem_->cost(v, first + duration) + cheapest.value, b, start);
+                        }
+
+                        // Starts whose stay runs past the horizon only pay for the priced part.
+                        const TimeType tail_last = std::min(last, horizon - 1);
+                        for (TimeType start = std::max(first, horizon - duration + 1); start <= tail_last; ++start)
+                        {
+                            consider(problem_->cost(v, start + duration) + prefix[horizon_] -
+                                     prefix[static_cast<size_t>(start)], b, start);
+                        }
+
+                        // Beyond the horizon nothing is priced, so the earliest such start is the cheapest,
+                        // and every later window is dominated by it.
+                        if (last >= horizon)
+                        {
+                            const TimeType start = std::max(first, horizon);
+                            consider(problem_->cost(v, start + duration), b, start);
+                            break;
+                        }
+                    }
+                }
+
+                if (best_berth == kNoBerth)
+                {
+                    return false;
+                }
+                chosen_berth_[v] = best_berth;
+                chosen_start_[v] = best_start;
+                value += best;
+                return true;
+            });
+            return feasible ? value : std::numeric_limits<CostType>::infinity();
+        }
+
+        /// \brief Moves the multipliers along the projected subgradient. Returns false if it vanishes.
+        bool take_step(const state_type& state, const CostType value, const CostType target, const double step)
+        {
+            const auto horizon = static_cast<TimeType>(horizon_);
+            std::ranges::fill(subgradient_, CostType{0});
+
+            // Occupancy of every priced period, as a difference array.
+            state.for_each_unassigned([&](const IndexType v)
+            {
+                if (chosen_start_[v] >= horizon)
+                {
+                    return;
+                }
+                const IndexType b = chosen_berth_[v];
+                CostType* row = subgradient_.data() + static_cast<size_t>(b) * stride_;
+                const TimeType end = std::min(chosen_start_[v] + problem_->processing_time(v, b), horizon);
+                row[static_cast<size_t>(chosen_start_[v])] += CostType{1};
+                row[static_cast<size_t>(end)] -= CostType{1};
+            });
+
+            // Subgradient: occupancy - 1 for the periods still open, projected onto lambda >= 0.
+            CostType norm = 0;
+            for (size_t b = 0; b < problem_->num_berths(); ++b)
+            {
+                CostType* row = subgradient_.data() + b * stride_;
+                const CostType* lambda = multipliers_.data() + b * stride_;
+                const auto open = static_cast<size_t>(std::min(state.berth_free_times[b], horizon));
+                CostType occupancy = 0;
+                for (size_t t = 0; t < horizon_; ++t)
+                {
+                    occupancy += row[t];
+                    CostType g = t >= open ? occupancy - CostType{1} : CostType{0};
+                    if (g < CostType{0} && lambda[t] == CostType{0})
+                    {
+                        g = 0;
+                    }
+                    row[t] = g;
+                    norm += g * g;
+                }
+                row[horizon_] = 0;
+            }
+            if (norm == CostType{0})
+            {
+                return false;
+            }
+
+            const auto scale = static_cast<CostType>(step) * (target - value) / norm;
+            CostType* lambda = multipliers_.data();
+            const CostType* gradient = subgradient_.data();
+            for (size_t i = 0; i < multipliers_.size(); ++i)
+            {
+                lambda[i] = std::max(CostType{0}, lambda[i] + scale * gradient[i]);
+            }
+            return true;
+        }
+
+        const problem_type* problem_;
+        LagrangianBoundOptions options_;
+        size_t horizon_;
+        size_t stride_;
+        leviathan::system::SimdLevel level_;
+        double root_step_ = 0.0;
+
+        // One cache-aligned row of stride_ periods per berth; stride_ is a whole number of cache lines.
+        row_type multipliers_;
+        row_type root_multipliers_;
+        row_type prefix_;
+        row_type subgradient_;
+
+        std::vector<IndexType> chosen_berth_;
+        std::vector<TimeType> chosen_start_;
+    };
+}
+
+#endif // LEVIATHAN_BNB_LAGRANGIAN_BOUND_H_
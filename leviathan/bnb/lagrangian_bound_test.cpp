@@ -0,0 +1,159 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <random>
+#include <vector>
+#include "leviathan/bnb/lagrangian_bound.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/test_util.h"
+
+using namespace leviathan::bnb::testing;
+
+namespace
+{
+    using State = leviathan::bnb::SearchState<Time, Index, Cost>;
+    using Bound = leviathan::bnb::LagrangianBound<Time, Index, Cost>;
+    using Move = leviathan::bnb::SearchMove<Time, Index, Cost>;
+    using leviathan::bnb::LagrangianBoundOptions;
+
+}
+
+TEST(LagrangianBoundTest, ZeroMultipliersGiveEarliestFinishBound)
+{
+    const TestProblem problem = make_random_problem(4, 8, 3);
+    State state(problem.num_berths(), problem.num_vessels());
+    state.apply_move(0, 1, 20, 30, problem.cost(0, 30));
+
+    Cost expected = state.current_objective;
+    for (Index v = 1; v < static_cast<Index>(problem.num_vessels()); ++v)
+    {
+        Cost cheapest = std::numeric_limits<Cost>::max();
+        for (Index b = 0; b < static_cast<Index>(problem.num_berths()); ++b)
+        {
+            const Time duration = problem.processing_time(v, b);
+            const std::optional<Time> start = problem.timeline(b).find_earliest_start(
+                std::max(problem.ready_time(v), state.berth_free_times[b]), duration);
+            ASSERT_TRUE(start.has_value());
+            cheapest = std::min(cheapest, problem.cost(v, *start + duration));
+        }
+        expected += cheapest;
+    }
+
+    Bound bound(problem, LagrangianBoundOptions{.node_iterations = 0});
+    EXPECT_DOUBLE_EQ(bound.evaluate(state), expected);
+}
+
+TEST(LagrangianBoundTest, RootOptimizationPricesCongestedBerth)
+{
+    // Four identical vessels on one berth: the optimum is 5 + 10 + 15 + 20 = 50, while
+    // ignoring the overlap gives 4 * 5 = 20.
+    const TestProblem problem({0, 0, 0, 0}, {1.0, 1.0, 1.0, 1.0}, {5, 5, 5, 5}, {{{0, 1000}}});
+    const State state(problem.num_berths(), problem.num_vessels());
+    Bound bound(problem);
+
+    const Cost root = bound.solve_root(state);
+    EXPECT_GT(root, 40.0);
+    EXPECT_LE(root, 50.0 + 1e-9);
+}
+
+TEST(LagrangianBoundTest, BoundIsBelowCompletionOptimum)
+{
+    std::mt19937 rng(21);
+    for (uint32_t seed = 0; seed < 12; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 6, 2);
+        State state(problem.num_berths(), problem.num_vessels());
+        Bound bound(problem);
+
+        const Cost optimum = brute_force_optimum(problem);
+        EXPECT_LE(bound.solve_root(state), optimum + 1e-6);
+        EXPECT_LE(bound.solve_root(state, optimum), optimum + 1e-6);
+        while (const std::optional<Move> move = random_move(problem, state, rng))
+        {
+            state.apply_move(move->vessel, move->berth, move->start_time, move->finish_time, move->cost_delta);
+            EXPECT_LE(bound.evaluate(state), completion_optimum(problem, state) + 1e-6);
+        }
+    }
+}
+
+TEST(LagrangianBoundTest, RootBoundIsAtLeastTheZeroMultiplierBound)
+{
+    for (uint32_t seed = 0; seed < 10; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 10, 3);
+        const State state(problem.num_berths(), problem.num_vessels());
+        Bound bound(problem, LagrangianBoundOptions{.node_iterations = 0});
+
+        const Cost trivial = bound.evaluate(state);
+        EXPECT_GE(bound.solve_root(state), trivial);
+    }
+}
+
+TEST(LagrangianBoundTest, UnservableVesselGivesInfinity)
+{
+    // The berth closes before the second vessel fits.
+    const TestProblem problem({0, 0}, {1.0, 1.0}, {5, 5}, {{{0, 8}}});
+    State state(problem.num_berths(), problem.num_vessels());
+    state.apply_move(0, 0, 0, 5, problem.cost(0, 5));
+
+    Bound bound(problem);
+    EXPECT_EQ(bound.evaluate(state), std::numeric_limits<Cost>::infinity());
+}
+
+TEST(LagrangianBoundTest, MultiplierRowsAreCacheAligned)
+{
+    const TestProblem problem = make_random_problem(1, 7, 5);
+    const State state(problem.num_berths(), problem.num_vessels());
+    Bound bound(problem, LagrangianBoundOptions{.horizon = 37});
+    static_cast<void>(bound.solve_root(state));
+
+    EXPECT_EQ(bound.horizon(), 37u);
+    for (Index b = 0; b < static_cast<Index>(problem.num_berths()); ++b)
+    {
+        EXPECT_EQ(bound.multipliers(b).size(), 37u);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(bound.multipliers(b).data()) % LEVIATHAN_CACHE_LINE_SIZE, 0u);
+    }
+}
+
+TEST(LagrangianBoundTest, ResetToRootRestoresMultipliers)
+{
+    std::mt19937 rng(8);
+    const TestProblem problem = make_random_problem(2, 8, 2);
+    State state(problem.num_berths(), problem.num_vessels());
+    Bound bound(problem);
+    static_cast<void>(bound.solve_root(state));
+    const std::vector<Cost> root(bound.multipliers(0).begin(), bound.multipliers(0).end());
+
+    while (const std::optional<Move> move = random_move(problem, state, rng))
+    {
+        state.apply_move(move->vessel, move->berth, move->start_time, move->finish_time, move->cost_delta);
+        static_cast<void>(bound.evaluate(state));
+    }
+    bound.reset_to_root();
+    EXPECT_TRUE(std::ranges::equal(bound.multipliers(0), root));
+}
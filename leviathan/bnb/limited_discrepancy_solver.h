@@ -0,0 +1,380 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_LIMITED_DISCREPANCY_SOLVER_H_
+#define LEVIATHAN_BNB_LIMITED_DISCREPANCY_SOLVER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_stack.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/search_statistics.h"
+#include "leviathan/bnb/search_trail.h"
+#include "leviathan/bnb/shared_incumbent.h"
+
+namespace leviathan::bnb
+{
+    /// \brief Tuning knobs of the LimitedDiscrepancySolver.
+    struct LimitedDiscrepancySolverOptions
+    {
+        /// Highest discrepancy count to explore; the search is complete only if this is not cut short.
+        std::size_t max_discrepancies = std::numeric_limits<std::size_t>::max();
+        /// Maximum number of nodes to enter, summed over all iterations, before the search stops.
+        std::uint64_t node_limit = std::numeric_limits<std::uint64_t>::max();
+        /// Reserve the stack for the deepest possible probe (max_dive_entries()) instead of at
+        /// most kDiveReserveCap moves.
+        bool reserve_max_dive = false;
+    };
+
+    /// \brief Branch-and-bound that explores the tree in order of increasing discrepancy count.
+    ///
+    /// A discrepancy is taking any child of a frame other than the first one the brancher
+    /// emitted. Iteration k visits exactly the leaves whose path has k discrepancies (improved
+    /// LDS), so the paths that agree with the child ordering are tried first, and a wrong choice
+    /// near the root costs one discrepancy instead of the whole subtree below the right choice.
+    /// Every leaf belongs to exactly one iteration, so running all of them is a complete search;
+    /// iterations stop early as soon as one of them did not have to cut off a single child
+    /// for lack of budget.
+    ///
+    /// Each iteration is an ordinary depth-first loop over the same SearchStack, SearchTrail and
+    /// SearchState. The budget is enforced while generating a frame: with no budget left only the
+    /// first child is kept, and when the remaining depth could not absorb the budget the first
+    /// child is dropped. The remaining budget of every open frame is kept in a side array indexed
+    /// by frame depth, so the stack entries stay plain moves.
+    ///
+    /// \tparam BrancherType The branching rule, see the Brancher concept.
+    template <typename TimeType, typename IndexType, typename CostType, typename BrancherType>
+        requires Brancher<BrancherType, TimeType, IndexType, CostType>
+    class LimitedDiscrepancySolver
+    {
+    public:
+        using state_type = SearchState<TimeType, IndexType, CostType>;
+        using move_type = SearchMove<TimeType, IndexType, CostType>;
+        using undo_type = SearchUndo<TimeType, IndexType, CostType>;
+        using stack_type = SearchStack<move_type>;
+        using trail_type = SearchTrail<undo_type>;
+        using incumbent_type = SharedIncumbent<TimeType, IndexType, CostType>;
+        using size_type = std::size_t;
+
+        static constexpr CostType kNoSolution = incumbent_type::kNoSolution;
+
+        /// \brief Constructs a solver for an instance of the given size.
+        ///
+        /// \param num_berths The number of berths of the instance.
+        /// \param num_vessels The number of vessels of the instance.
+        /// \param brancher The branching rule used to expand nodes.
+        /// \param options The discrepancy and node limits.
+        LEVIATHAN_FORCE_INLINE LimitedDiscrepancySolver(const size_type num_berths, const size_type num_vessels,
+                                                        BrancherType brancher,
+                                                        const LimitedDiscrepancySolverOptions options = {})
+            : state_(num_berths, num_vessels),
+              brancher_(std::move(brancher)),
+              options_(options),
+              frames_(num_vessels + 1),
+              owned_incumbent_(num_vessels),
+              best_assignments_(num_vessels, state_type::kUnassignedVessel),
+              best_start_times_(num_vessels, 0)
+        {
+            stack_.reserve(dive_reserve_entries(num_berths, num_vessels, options_.reserve_max_dive),
+                           num_vessels + 1);
+            trail_.reserve(num_vessels, num_vessels);
+        }
+
+        /// \brief Returns the root state. May be modified before solve() (e.g. initial berth free times).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE state_type& state() noexcept
+        {
+            return state_;
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const state_type& state() const noexcept
+        {
+            return state_;
+        }
+
+        /// \brief Resets the incumbent to an upper bound; only strictly better solutions will be reported.
+        ///
+        /// Must not be called while another solver searches with the same incumbent.
+        LEVIATHAN_FORCE_INLINE void set_upper_bound(const CostType upper_bound) noexcept
+        {
+            incumbent_->reset(upper_bound);
+            has_solution_ = false;
+        }
+
+        /// \brief Prunes against and publishes to an external incumbent instead of the owned one.
+        ///
+        /// \param incumbent The shared incumbent. Must outlive the solver.
+        LEVIATHAN_FORCE_INLINE void attach_incumbent(incumbent_type& incumbent) noexcept
+        {
+            incumbent_ = &incumbent;
+        }
+
+        /// \brief Returns the incumbent the solver prunes against.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE incumbent_type& incumbent() noexcept
+        {
+            return *incumbent_;
+        }
+
+        /// \brief Makes the search stop (as if a limit was hit) once `flag` becomes true.
+        ///
+        /// \param flag The stop flag, usually raised by another thread. Must outlive the solver.
+        LEVIATHAN_FORCE_INLINE void attach_stop_flag(const std::atomic<bool>& flag) noexcept
+        {
+            stop_flag_ = &flag;
+        }
+
+        /// \brief Runs the iterations 0, 1, 2, ... from the current root state.
+        ///
+        /// On return the state is restored to the root, regardless of whether the
+        /// search finished or hit a limit.
+        SearchStatus solve()
+        {
+            DCHECK(trail_.empty());
+            statistics_ = {};
+            iterations_ = 0;
+            root_unassigned_ = static_cast<size_type>(state_.num_unassigned());
+
+            if (root_unassigned_ == 0)
+            {
+                record_solution();
+                return finish(true);
+            }
+
+            const size_type last = std::min(options_.max_discrepancies, root_unassigned_);
+            for (size_type discrepancies = 0; discrepancies <= last; ++discrepancies)
+            {
+                truncated_ = false;
+                if (!run_iteration(discrepancies))
+                {
+                    return finish(false);
+                }
+                ++iterations_;
+                if (!truncated_)
+                {
+                    return finish(true);
+                }
+            }
+            return finish(false);
+        }
+
+        /// \brief Returns the number of iterations completed by the last solve() call.
+        ///
+        /// After a complete search this is one more than the largest discrepancy count explored.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type iterations() const noexcept
+        {
+            return iterations_;
+        }
+
+        /// \brief Returns true if this solver has found a solution.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool has_solution() const noexcept
+        {
+            return has_solution_;
+        }
+
+        /// \brief Returns the objective of the incumbent (or the upper bound if none was found).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType best_objective() const noexcept
+        {
+            return incumbent_->objective();
+        }
+
+        /// \brief Returns the berth of every vessel in the best solution found by this solver.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const IndexType> best_assignments() const noexcept
+        {
+            return best_assignments_;
+        }
+
+        /// \brief Returns the start time of every vessel in the best solution found by this solver.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const TimeType> best_start_times() const noexcept
+        {
+            return best_start_times_;
+        }
+
+        /// \brief Returns the counters of the last solve() call, summed over all iterations.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const SearchStatistics& statistics() const noexcept
+        {
+            return statistics_;
+        }
+
+        /// \brief Returns the total bytes allocated by the stack, the trail and the frame budgets.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type allocated_memory_bytes() const noexcept
+        {
+            return stack_.allocated_memory_bytes() + trail_.allocated_memory_bytes() +
+                frames_.capacity() * sizeof(FrameBudget);
+        }
+
+    private:
+        /// \brief The discrepancy budget of an open frame.
+        struct FrameBudget
+        {
+            /// Discrepancies still to be spent below the node that owns the frame.
+            size_type remaining;
+            /// True while the first child of the frame is still on top of it.
+            bool first_pending;
+        };
+
+        /// \brief Visits all leaves with exactly `discrepancies` discrepancies.
+        ///
+        /// \return False if the node limit or the stop flag ended the iteration.
+        bool run_iteration(const size_type discrepancies)
+        {
+            expand(discrepancies);
+            while (!stack_.empty())
+            {
+                if (stack_.current_frame_size() == 0)
+                {
+                    stack_.pop_frame();
+                    if (!trail_.empty())
+                    {
+                        backtrack_decision(state_, trail_);
+                    }
+                    continue;
+                }
+
+                FrameBudget& frame = frames_[stack_.depth() - 1];
+                const size_type remaining = frame.first_pending ? frame.remaining : frame.remaining - 1;
+                frame.first_pending = false;
+
+                const move_type move = stack_.top();
+                stack_.pop_entry();
+
+                if (move.lower_bound >= incumbent_->objective())
+                {
+                    ++statistics_.pruned;
+                    continue;
+                }
+
+                if (LEVIATHAN_UNLIKELY(statistics_.nodes >= options_.node_limit ||
+                    stop_flag_->load(std::memory_order_relaxed)))
+                {
+                    unwind();
+                    return false;
+                }
+
+                apply_decision(state_, trail_, move);
+                ++statistics_.nodes;
+                statistics_.max_depth = std::max<std::uint64_t>(statistics_.max_depth, trail_.depth());
+
+                if (trail_.depth() == root_unassigned_)
+                {
+                    DCHECK_EQ(remaining, 0u);
+                    record_solution();
+                    backtrack_decision(state_, trail_);
+                    continue;
+                }
+
+                expand(remaining);
+            }
+            return true;
+        }
+
+        /// \brief Generates the children of the current state that fit the remaining budget.
+        ///
+        /// The first child keeps the budget and is only admissible while the levels below it can
+        /// still spend all of it; every other child consumes one discrepancy.
+        LEVIATHAN_FORCE_INLINE void expand(const size_type remaining)
+        {
+            stack_.fill_frame([this](stack_type& stack)
+            {
+                brancher_.branch(state_, stack);
+            });
+
+            const size_type levels_below = root_unassigned_ - trail_.depth() - 1;
+            bool first_pending = stack_.current_frame_size() > 0;
+            if (remaining == 0)
+            {
+                const CostType objective = incumbent_->objective();
+                while (stack_.current_frame_size() > 1)
+                {
+                    truncated_ |= stack_.top().lower_bound < objective;
+                    stack_.pop_entry();
+                }
+            }
+
+            std::ranges::reverse(stack_.current_frame_entries());
+            if (first_pending && levels_below < remaining)
+            {
+                stack_.pop_entry();
+                first_pending = false;
+            }
+            frames_[stack_.depth() - 1] = FrameBudget{remaining, first_pending};
+        }
+
+        LEVIATHAN_FORCE_INLINE void record_solution()
+        {
+            if (!incumbent_->try_improve(state_))
+            {
+                return;
+            }
+            std::ranges::copy(state_.vessel_assignments, best_assignments_.begin());
+            std::ranges::copy(state_.vessel_start_times, best_start_times_.begin());
+            has_solution_ = true;
+            ++statistics_.solutions;
+        }
+
+        /// \brief Undoes all applied moves and drops all pending children.
+        LEVIATHAN_FORCE_INLINE void unwind()
+        {
+            while (!trail_.empty())
+            {
+                backtrack_decision(state_, trail_);
+            }
+            stack_.clear();
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE SearchStatus finish(const bool exhausted) const noexcept
+        {
+            const bool has_incumbent = incumbent_->has_solution();
+            if (exhausted)
+            {
+                return has_incumbent ? SearchStatus::kOptimal : SearchStatus::kInfeasible;
+            }
+            return has_incumbent ? SearchStatus::kFeasible : SearchStatus::kLimitReached;
+        }
+
+        state_type state_;
+        stack_type stack_;
+        trail_type trail_;
+        BrancherType brancher_;
+        LimitedDiscrepancySolverOptions options_;
+        SearchStatistics statistics_;
+        std::vector<FrameBudget> frames_;
+        size_type root_unassigned_ = 0;
+        size_type iterations_ = 0;
+        bool truncated_ = false;
+
+        incumbent_type owned_incumbent_;
+        incumbent_type* incumbent_ = &owned_incumbent_;
+        std::atomic<bool> never_stop_{false};
+        const std::atomic<bool>* stop_flag_ = &never_stop_;
+        bool has_solution_ = false;
+        std::vector<IndexType> best_assignments_;
+        std::vector<TimeType> best_start_times_;
+    };
+}
+
+#endif // LEVIATHAN_BNB_LIMITED_DISCREPANCY_SOLVER_H_
@@ -0,0 +1,115 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "leviathan/bnb/assignment_brancher.h"
+#include "leviathan/bnb/depth_first_solver.h"
+#include "leviathan/bnb/limited_discrepancy_solver.h"
+#include "leviathan/bnb/test_util.h"
+
+using namespace leviathan::bnb::testing;
+using Brancher = leviathan::bnb::AssignmentBrancher<Time, Index, Cost>;
+using Solver = leviathan::bnb::LimitedDiscrepancySolver<Time, Index, Cost, Brancher>;
+using leviathan::bnb::SearchStatus;
+
+TEST(LimitedDiscrepancySolverTest, MatchesBruteForceOnRandomInstances)
+{
+    for (uint32_t seed = 0; seed < 20; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 5, 2);
+        Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+
+        ASSERT_EQ(solver.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(solver.best_objective(), brute_force_optimum(problem)) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(evaluate_schedule(problem, solver.best_assignments(), solver.best_start_times()),
+                         solver.best_objective()) << "seed " << seed;
+        EXPECT_GE(solver.iterations(), 1u);
+    }
+}
+
+TEST(LimitedDiscrepancySolverTest, ZeroDiscrepanciesIsTheGreedyDive)
+{
+    const TestProblem problem = make_random_problem(42, 8, 3);
+    Solver lds(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.max_discrepancies = 0});
+    leviathan::bnb::DepthFirstSolver<Time, Index, Cost, Brancher> dfs(
+        problem.num_berths(), problem.num_vessels(), Brancher(problem), {.node_limit = problem.num_vessels()});
+
+    ASSERT_EQ(lds.solve(), SearchStatus::kFeasible);
+    ASSERT_EQ(dfs.solve(), SearchStatus::kFeasible);
+    EXPECT_EQ(lds.statistics().nodes, problem.num_vessels());
+    EXPECT_EQ(lds.iterations(), 1u);
+    EXPECT_DOUBLE_EQ(lds.best_objective(), dfs.best_objective());
+}
+
+TEST(LimitedDiscrepancySolverTest, StateIsRestoredAfterSolve)
+{
+    const TestProblem problem = make_random_problem(7, 5, 3);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+
+    ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+    EXPECT_EQ(solver.state().current_objective, 0.0);
+    for (Index v = 0; v < static_cast<Index>(problem.num_vessels()); ++v)
+    {
+        EXPECT_FALSE(solver.state().is_assigned(v));
+    }
+    for (const Time t : solver.state().berth_free_times)
+    {
+        EXPECT_EQ(t, 0);
+    }
+}
+
+TEST(LimitedDiscrepancySolverTest, NodeLimitStopsAndUnwinds)
+{
+    const TestProblem problem = make_random_problem(3, 6, 2);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.node_limit = 10});
+
+    const SearchStatus status = solver.solve();
+    EXPECT_TRUE(status == SearchStatus::kFeasible || status == SearchStatus::kLimitReached);
+    EXPECT_EQ(solver.statistics().nodes, 10);
+    EXPECT_EQ(solver.state().current_objective, 0.0);
+    EXPECT_EQ(solver.state().last_assigned_vessel, Solver::state_type::kUnassignedVessel);
+}
+
+TEST(LimitedDiscrepancySolverTest, InfeasibleInstance)
+{
+    // Both vessels need 30 time units but the only berth is open for 50.
+    const TestProblem problem({0, 0}, {1.0, 1.0}, {30, 30}, {{0, 50}});
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+
+    EXPECT_EQ(solver.solve(), SearchStatus::kInfeasible);
+    EXPECT_FALSE(solver.has_solution());
+}
+
+TEST(LimitedDiscrepancySolverTest, NoAllocationAfterFirstSolve)
+{
+    const TestProblem problem = make_random_problem(5, 6, 3);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+
+    ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+    const size_t bytes = solver.allocated_memory_bytes();
+    const Cost objective = solver.best_objective();
+
+    solver.set_upper_bound(Solver::kNoSolution);
+    ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+    EXPECT_EQ(solver.allocated_memory_bytes(), bytes);
+    EXPECT_EQ(solver.best_objective(), objective);
+}
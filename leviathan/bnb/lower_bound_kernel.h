@@ -0,0 +1,514 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_LOWER_BOUND_KERNEL_H_
+#define LEVIATHAN_BNB_LOWER_BOUND_KERNEL_H_
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+#include "leviathan/base/system_info.h"
+#include "leviathan/bnb/problem.h"
+#include "leviathan/bnb/search_state.h"
+
+#if LEVIATHAN_ARCH_X86_64
+#include <immintrin.h>
+#endif
+
+namespace leviathan::bnb
+{
+    using leviathan::system::SimdLevel;
+
+    /// \brief Time types the vectorized kernels support: 32- and 64-bit signed integers.
+    template <typename TimeType>
+    concept SimdTimeType = std::same_as<TimeType, std::int32_t> || std::same_as<TimeType, std::int64_t>;
+
+    /// \brief Returns min over b of `max(free_times[b], ready) + processing_times[b]`, one berth at a time.
+    ///
+    /// This is the earliest time a vessel can finish if berth windows are ignored.
+    /// Returns the largest TimeType value if there are no berths.
+    template <typename TimeType>
+    [[nodiscard]] TimeType earliest_finish_scalar(const std::span<const TimeType> free_times, const TimeType ready,
+                                                  const std::span<const TimeType> processing_times) noexcept
+    {
+        DCHECK_EQ(free_times.size(), processing_times.size());
+        TimeType best = std::numeric_limits<TimeType>::max();
+        for (std::size_t b = 0; b < free_times.size(); ++b)
+        {
+            best = std::min(best, static_cast<TimeType>(std::max(free_times[b], ready) + processing_times[b]));
+        }
+        return best;
+    }
+
+    /// \brief Lowers every element of `target` to the corresponding element of `source`, one at a time.
+    template <typename TimeType>
+    LEVIATHAN_FORCE_INLINE void elementwise_min_scalar(const std::span<TimeType> target,
+                                                       const std::span<const TimeType> source) noexcept
+    {
+        DCHECK_EQ(target.size(), source.size());
+        for (std::size_t i = 0; i < target.size(); ++i)
+        {
+            target[i] = std::min(target[i], source[i]);
+        }
+    }
+
+    /// \brief The smallest value of a sloped difference and the first index attaining it.
+    template <typename T>
+    struct SlopedMinimum
+    {
+        T value;
+        std::size_t index;
+    };
+
+    /// \brief Returns min over i of `slope * i + exit[i] - entry[i]`, one element at a time.
+    ///
+    /// With `entry` and `exit` pointing into a prefix sum at a start time s and at s + duration,
+    /// this is the cheapest start for a job whose cost grows linearly in s and which pays the
+    /// summed prices of the periods it occupies. Ties resolve to the smallest index. Returns an
+    /// infinite value and index 0 for empty input.
+    template <std::floating_point T>
+    [[nodiscard]] SlopedMinimum<T> min_sloped_difference_scalar(const std::span<const T> entry,
+                                                                const std::span<const T> exit,
+                                                                const T slope) noexcept
+    {
+        DCHECK_EQ(entry.size(), exit.size());
+        SlopedMinimum<T> best{std::numeric_limits<T>::infinity(), 0};
+        for (std::size_t i = 0; i < entry.size(); ++i)
+        {
+            const T value = (slope * static_cast<T>(i) + exit[i]) - entry[i];
+            if (value < best.value)
+            {
+                best = SlopedMinimum<T>{value, i};
+            }
+        }
+        return best;
+    }
+
+#if LEVIATHAN_ARCH_X86_64
+// GCC 12 warns about the undefined pass-through operand inside its own AVX-512 intrinsics (GCC PR 105593).
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    namespace internal
+    {
+        template <SimdTimeType TimeType>
+        LEVIATHAN_TARGET_AVX2 TimeType earliest_finish_avx2(const TimeType* free_times, const TimeType ready,
+                                                            const TimeType* processing_times,
+                                                            const std::size_t size) noexcept
+        {
+            constexpr std::size_t kLanes = 32 / sizeof(TimeType);
+            std::size_t b = 0;
+            TimeType best = std::numeric_limits<TimeType>::max();
+
+            if (size >= kLanes)
+            {
+                __m256i acc;
+                __m256i vready;
+                if constexpr (sizeof(TimeType) == 4)
+                {
+                    acc = _mm256_set1_epi32(std::numeric_limits<TimeType>::max());
+                    vready = _mm256_set1_epi32(ready);
+                }
+                else
+                {
+                    acc = _mm256_set1_epi64x(std::numeric_limits<TimeType>::max());
+                    vready = _mm256_set1_epi64x(ready);
+                }
+
+                for (; b + kLanes <= size; b += kLanes)
+                {
+                    const __m256i free = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(free_times + b));
+                    const __m256i proc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(processing_times + b));
+                    if constexpr (sizeof(TimeType) == 4)
+                    {
+                        acc = _mm256_min_epi32(acc, _mm256_add_epi32(_mm256_max_epi32(free, vready), proc));
+                    }
+                    else
+                    {
+                        // AVX2 has no 64-bit min/max; select with a signed compare instead.
+                        const __m256i start = _mm256_blendv_epi8(vready, free, _mm256_cmpgt_epi64(free, vready));
+                        const __m256i finish = _mm256_add_epi64(start, proc);
+                        acc = _mm256_blendv_epi8(acc, finish, _mm256_cmpgt_epi64(acc, finish));
+                    }
+                }
+
+                alignas(32) TimeType lanes[kLanes];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+                for (const TimeType lane : lanes)
+                {
+                    best = std::min(best, lane);
+                }
+            }
+
+            for (; b < size; ++b)
+            {
+                best = std::min(best, static_cast<TimeType>(std::max(free_times[b], ready) + processing_times[b]));
+            }
+            return best;
+        }
+
+        template <SimdTimeType TimeType>
+        LEVIATHAN_TARGET_AVX512 TimeType earliest_finish_avx512(const TimeType* free_times, const TimeType ready,
+                                                                const TimeType* processing_times,
+                                                                const std::size_t size) noexcept
+        {
+            constexpr std::size_t kLanes = 64 / sizeof(TimeType);
+            std::size_t b = 0;
+
+            if constexpr (sizeof(TimeType) == 4)
+            {
+                __m512i acc = _mm512_set1_epi32(std::numeric_limits<TimeType>::max());
+                const __m512i vready = _mm512_set1_epi32(ready);
+                for (; b + kLanes <= size; b += kLanes)
+                {
+                    const __m512i free = _mm512_loadu_si512(free_times + b);
+                    const __m512i proc = _mm512_loadu_si512(processing_times + b);
+                    acc = _mm512_min_epi32(acc, _mm512_add_epi32(_mm512_max_epi32(free, vready), proc));
+                }
+                if (b < size)
+                {
+                    // Masked tail: inactive lanes keep the accumulator unchanged.
+                    const auto mask = static_cast<__mmask16>((1u << (size - b)) - 1);
+                    const __m512i free = _mm512_maskz_loadu_epi32(mask, free_times + b);
+                    const __m512i proc = _mm512_maskz_loadu_epi32(mask, processing_times + b);
+                    acc = _mm512_mask_min_epi32(acc, mask, acc,
+                                                _mm512_add_epi32(_mm512_max_epi32(free, vready), proc));
+                }
+                return static_cast<TimeType>(_mm512_reduce_min_epi32(acc));
+            }
+            else
+            {
+                __m512i acc = _mm512_set1_epi64(std::numeric_limits<TimeType>::max());
+                const __m512i vready = _mm512_set1_epi64(ready);
+                for (; b + kLanes <= size; b += kLanes)
+                {
+                    const __m512i free = _mm512_loadu_si512(free_times + b);
+                    const __m512i proc = _mm512_loadu_si512(processing_times + b);
+                    acc = _mm512_min_epi64(acc, _mm512_add_epi64(_mm512_max_epi64(free, vready), proc));
+                }
+                if (b < size)
+                {
+                    const auto mask = static_cast<__mmask8>((1u << (size - b)) - 1);
+                    const __m512i free = _mm512_maskz_loadu_epi64(mask, free_times + b);
+                    const __m512i proc = _mm512_maskz_loadu_epi64(mask, processing_times + b);
+                    acc = _mm512_mask_min_epi64(acc, mask, acc,
+                                                _mm512_add_epi64(_mm512_max_epi64(free, vready), proc));
+                }
+                return static_cast<TimeType>(_mm512_reduce_min_epi64(acc));
+            }
+        }
+
+        template <SimdTimeType TimeType>
+        LEVIATHAN_TARGET_AVX2 void elementwise_min_avx2(TimeType* target, const TimeType* source,
+                                                        const std::size_t size) noexcept
+        {
+            constexpr std::size_t kLanes = 32 / sizeof(TimeType);
+            std::size_t i = 0;
+            for (; i + kLanes <= size; i += kLanes)
+            {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target + i));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+                __m256i lower;
+                if constexpr (sizeof(TimeType) == 4)
+                {
+                    lower = _mm256_min_epi32(a, b);
+                }
+                else
+                {
+                    lower = _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), lower);
+            }
+            for (; i < size; ++i)
+            {
+                target[i] = std::min(target[i], source[i]);
+            }
+        }
+
+        template <SimdTimeType TimeType>
+        LEVIATHAN_TARGET_AVX512 void elementwise_min_avx512(TimeType* target, const TimeType* source,
+                                                            const std::size_t size) noexcept
+        {
+            constexpr std::size_t kLanes = 64 / sizeof(TimeType);
+            for (std::size_t i = 0; i < size; i += kLanes)
+            {
+                // The last block is masked, so rows shorter than a register need a single instruction.
+                const std::size_t count = std::min(kLanes, size - i);
+                if constexpr (sizeof(TimeType) == 4)
+                {
+                    const auto mask = static_cast<__mmask16>((1u << count) - 1);
+                    const __m512i a = _mm512_maskz_loadu_epi32(mask, target + i);
+                    const __m512i b = _mm512_maskz_loadu_epi32(mask, source + i);
+                    _mm512_mask_storeu_epi32(target + i, mask, _mm512_min_epi32(a, b));
+                }
+                else
+                {
+                    const auto mask = static_cast<__mmask8>((1u << count) - 1);
+                    const __m512i a = _mm512_maskz_loadu_epi64(mask, target + i);
+                    const __m512i b = _mm512_maskz_loadu_epi64(mask, source + i);
+                    _mm512_mask_storeu_epi64(target + i, mask, _mm512_min_epi64(a, b));
+                }
+            }
+        }
+
+        // Folds per-lane minima (each the first index of its lane) into the overall first minimum.
+        template <std::size_t kLanes>
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE SlopedMinimum<double> fold_lanes(const double (&values)[kLanes],
+                                                                              const double (&indices)[kLanes]) noexcept
+        {
+            SlopedMinimum<double> best{std::numeric_limits<double>::infinity(), 0};
+            for (std::size_t lane = 0; lane < kLanes; ++lane)
+            {
+                const auto index = static_cast<std::size_t>(indices[lane]);
+                if (values[lane] < best.value || (values[lane] == best.value && index < best.index))
+                {
+                    best = SlopedMinimum<double>{values[lane], index};
+                }
+            }
+            return best;
+        }
+
+        LEVIATHAN_TARGET_AVX2 inline SlopedMinimum<double> min_sloped_difference_avx2(
+            const double* entry, const double* exit, const double slope, const std::size_t size) noexcept
+        {
+            constexpr std::size_t kLanes = 4;
+            std::size_t i = 0;
+            SlopedMinimum<double> best{std::numeric_limits<double>::infinity(), 0};
+
+            if (size >= kLanes)
+            {
+                const __m256d vslope = _mm256_set1_pd(slope);
+                const __m256d step = _mm256_set1_pd(static_cast<double>(kLanes));
+                __m256d index = _mm256_setr_pd(0.0, 1.0, 2.0, 3.0);
+                __m256d best_value = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+                __m256d best_index = _mm256_setzero_pd();
+                for (; i + kLanes <= size; i += kLanes)
+                {
+                    const __m256d sloped = _mm256_add_pd(_mm256_mul_pd(vslope, index), _mm256_loadu_pd(exit + i));
+                    const __m256d value = _mm256_sub_pd(sloped, _mm256_loadu_pd(entry + i));
+                    const __m256d better = _mm256_cmp_pd(value, best_value, _CMP_LT_OQ);
+                    best_value = _mm256_blendv_pd(best_value, value, better);
+                    best_index = _mm256_blendv_pd(best_index, index, better);
+                    index = _mm256_add_pd(index, step);
+                }
+
+                alignas(32) double values[kLanes];
+                alignas(32) double indices[kLanes];
+                _mm256_store_pd(values, best_value);
+                _mm256_store_pd(indices, best_index);
+                best = fold_lanes(values, indices);
+            }
+
+            for (; i < size; ++i)
+            {
+                const double value = (slope * static_cast<double>(i) + exit[i]) - entry[i];
+                if (value < best.value)
+                {
+                    best = SlopedMinimum<double>{value, i};
+                }
+            }
+            return best;
+        }
+
+        LEVIATHAN_TARGET_AVX512 inline SlopedMinimum<double> min_sloped_difference_avx512(
+            const double* entry, const double* exit, const double slope, const std::size_t size) noexcept
+        {
+            constexpr std::size_t kLanes = 8;
+            const __m512d vslope = _mm512_set1_pd(slope);
+            const __m512d step = _mm512_set1_pd(static_cast<double>(kLanes));
+            __m512d index = _mm512_setr_pd(0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0);
+            __m512d best_value = _mm512_set1_pd(std::numeric_limits<double>::infinity());
+            __m512d best_index = _mm512_setzero_pd();
+
+            std::size_t i = 0;
+            for (; i + kLanes <= size; i += kLanes)
+            {
+                const __m512d sloped = _mm512_add_pd(_mm512_mul_pd(vslope, index), _mm512_loadu_pd(exit + i));
+                const __m512d value = _mm512_sub_pd(sloped, _mm512_loadu_pd(entry + i));
+                const __mmask8 better = _mm512_cmp_pd_mask(value, best_value, _CMP_LT_OQ);
+                best_value = _mm512_mask_blend_pd(better, best_value, value);
+                best_index = _mm512_mask_blend_pd(better, best_index, index);
+                index = _mm512_add_pd(index, step);
+            }
+            if (i < size)
+            {
+                // Masked tail: inactive lanes never compare as better.
+                const auto mask = static_cast<__mmask8>((1u << (size - i)) - 1);
+                const __m512d sloped = _mm512_add_pd(_mm512_mul_pd(vslope, index),
+                                                     _mm512_maskz_loadu_pd(mask, exit + i));
+                const __m512d value = _mm512_sub_pd(sloped, _mm512_maskz_loadu_pd(mask, entry + i));
+                const __mmask8 better = _mm512_mask_cmp_pd_mask(mask, value, best_value, _CMP_LT_OQ);
+                best_value = _mm512_mask_blend_pd(better, best_value, value);
+                best_index = _mm512_mask_blend_pd(better, best_index, index);
+            }
+
+            alignas(64) double values[kLanes];
+            alignas(64) double indices[kLanes];
+            _mm512_store_pd(values, best_value);
+            _mm512_store_pd(indices, best_index);
+            return fold_lanes(values, indices);
+        }
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+    /// \brief Vectorized earliest_finish_scalar() using the given instruction set.
+    ///
+    /// 32- and 64-bit time types use AVX2 or AVX-512 if `level` asks for it; every other
+    /// combination (and every non-x86 target) runs the scalar loop. `level` must not exceed
+    /// what leviathan::system::get_simd_level() reports.
+    template <typename TimeType>
+    [[nodiscard]] LEVIATHAN_FORCE_INLINE TimeType earliest_finish(const std::span<const TimeType> free_times,
+                                                                  const TimeType ready,
+                                                                  const std::span<const TimeType> processing_times,
+                                                                  const SimdLevel level) noexcept
+    {
+        DCHECK_EQ(free_times.size(), processing_times.size());
+#if LEVIATHAN_ARCH_X86_64
+        if constexpr (SimdTimeType<TimeType>)
+        {
+            switch (level)
+            {
+            case SimdLevel::kAvx512:
+                return internal::earliest_finish_avx512(free_times.data(), ready, processing_times.data(),
+                                                        free_times.size());
+            case SimdLevel::kAvx2:
+                return internal::earliest_finish_avx2(free_times.data(), ready, processing_times.data(),
+                                                      free_times.size());
+            case SimdLevel::kScalar:
+                break;
+            }
+        }
+#endif
+        static_cast<void>(level);
+        return earliest_finish_scalar(free_times, ready, processing_times);
+    }
+
+    /// \brief earliest_finish() with the widest instruction set of this machine.
+    template <typename TimeType>
+    [[nodiscard]] LEVIATHAN_FORCE_INLINE TimeType earliest_finish(const std::span<const TimeType> free_times,
+                                                                  const TimeType ready,
+                                                                  const std::span<const TimeType> processing_times)
+    noexcept
+    {
+        return earliest_finish(free_times, ready, processing_times, leviathan::system::get_simd_level());
+    }
+
+    /// \brief Vectorized min_sloped_difference_scalar() using the given instruction set.
+    ///
+    /// Double precision input uses AVX2 or AVX-512 if `level` asks for it; every other type (and
+    /// every non-x86 target) runs the scalar loop. Ties resolve to the smallest index on every path.
+    template <std::floating_point T>
+    [[nodiscard]] LEVIATHAN_FORCE_INLINE SlopedMinimum<T> min_sloped_difference(const std::span<const T> entry,
+                                                                                const std::span<const T> exit,
+                                                                                const T slope,
+                                                                                const SimdLevel level) noexcept
+    {
+        DCHECK_EQ(entry.size(), exit.size());
+#if LEVIATHAN_ARCH_X86_64
+        if constexpr (std::same_as<T, double>)
+        {
+            switch (level)
+            {
+            case SimdLevel::kAvx512:
+                return internal::min_sloped_difference_avx512(entry.data(), exit.data(), slope, entry.size());
+            case SimdLevel::kAvx2:
+                return internal::min_sloped_difference_avx2(entry.data(), exit.data(), slope, entry.size());
+            case SimdLevel::kScalar:
+                break;
+            }
+        }
+#endif
+        static_cast<void>(level);
+        return min_sloped_difference_scalar(entry, exit, slope);
+    }
+
+    /// \brief Vectorized elementwise_min_scalar() using the given instruction set.
+    ///
+    /// 32- and 64-bit time types use AVX2 or AVX-512 if `level` asks for it; every other
+    /// combination (and every non-x86 target) runs the scalar loop.
+    template <typename TimeType>
+    LEVIATHAN_FORCE_INLINE void elementwise_min(const std::span<TimeType> target, const std::span<const TimeType> source,
+                                                const SimdLevel level) noexcept
+    {
+        DCHECK_EQ(target.size(), source.size());
+#if LEVIATHAN_ARCH_X86_64
+        if constexpr (SimdTimeType<TimeType>)
+        {
+            switch (level)
+            {
+            case SimdLevel::kAvx512:
+                internal::elementwise_min_avx512(target.data(), source.data(), target.size());
+                return;
+            case SimdLevel::kAvx2:
+                internal::elementwise_min_avx2(target.data(), source.data(), target.size());
+                return;
+            case SimdLevel::kScalar:
+                break;
+            }
+        }
+#endif
+        static_cast<void>(level);
+        elementwise_min_scalar(target, source);
+    }
+
+    /// \brief The classic berth allocation bound: every unassigned vessel finishes as early as any berth allows.
+    ///
+    /// Returns `state.current_objective` plus, for every unassigned vessel v,
+    /// `weight[v] * (earliest_finish(berth_free_times, ready[v], proc[v]) - ready[v])`. Berth
+    /// windows and the interaction between vessels are ignored, so this is a valid lower bound
+    /// on the objective of any completion of `state`. Costs O(vessels * berths / lanes).
+    template <typename TimeType, typename IndexType, typename CostType>
+    [[nodiscard]] CostType earliest_finish_bound(const Problem<TimeType, IndexType, CostType>& problem,
+                                                 const SearchState<TimeType, IndexType, CostType>& state,
+                                                 const SimdLevel level = leviathan::system::get_simd_level())
+    noexcept
+    {
+        DCHECK_EQ(state.berth_free_times.size(), problem.num_berths());
+        DCHECK_EQ(state.vessel_assignments.size(), problem.num_vessels());
+
+        const std::span<const TimeType> free_times = state.berth_free_times;
+        const auto num_vessels = static_cast<IndexType>(problem.num_vessels());
+        CostType bound = state.current_objective;
+        for (IndexType v = 0; v < num_vessels; ++v)
+        {
+            if (state.is_assigned(v))
+            {
+                continue;
+            }
+            const TimeType ready = problem.ready_time(v);
+            const TimeType finish = earliest_finish(free_times, ready, problem.processing_times_row(v), level);
+            bound += problem.cost(v, finish);
+        }
+        return bound;
+    }
+}
+
+#endif // LEVIATHAN_BNB_LOWER_BOUND_KERNEL_H_
@@ -0,0 +1,86 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+#include "leviathan/base/system_info.h"
+#include "leviathan/bnb/lower_bound_kernel.h"
+
+// Compares the scalar, AVX2 and AVX-512 paths of earliest_finish() for one vessel across
+// typical berth counts. Levels the machine does not support are reported as skipped.
+
+namespace
+{
+    using leviathan::system::SimdLevel;
+
+    template <typename TimeType>
+    void run_earliest_finish(benchmark::State& state, const SimdLevel level)
+    {
+        if (leviathan::system::get_simd_level() < level)
+        {
+            state.SkipWithError("instruction set not supported on this machine");
+            return;
+        }
+
+        const auto num_berths = static_cast<size_t>(state.range(0));
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int32_t> dist(0, 1000);
+        std::vector<TimeType> free_times(num_berths);
+        std::vector<TimeType> processing_times(num_berths);
+        for (size_t b = 0; b < num_berths; ++b)
+        {
+            free_times[b] = static_cast<TimeType>(dist(rng));
+            processing_times[b] = static_cast<TimeType>(dist(rng) + 1);
+        }
+        const std::span<const TimeType> free_span(free_times);
+        const std::span<const TimeType> proc_span(processing_times);
+        TimeType ready = 500;
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(ready);
+            TimeType finish = leviathan::bnb::earliest_finish(free_span, ready, proc_span, level);
+            benchmark::DoNotOptimize(finish);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_EarliestFinish32(benchmark::State& state, const SimdLevel level)
+    {
+        run_earliest_finish<int32_t>(state, level);
+    }
+
+    void BM_EarliestFinish64(benchmark::State& state, const SimdLevel level)
+    {
+        run_earliest_finish<int64_t>(state, level);
+    }
+}
+
+BENCHMARK_CAPTURE(BM_EarliestFinish32, scalar, SimdLevel::kScalar)->ArgName("berths")->Arg(20)->Arg(100)->Arg(500);
+BENCHMARK_CAPTURE(BM_EarliestFinish32, avx2, SimdLevel::kAvx2)->ArgName("berths")->Arg(20)->Arg(100)->Arg(500);
+BENCHMARK_CAPTURE(BM_EarliestFinish32, avx512, SimdLevel::kAvx512)->ArgName("berths")->Arg(20)->Arg(100)->Arg(500);
+BENCHMARK_CAPTURE(BM_EarliestFinish64, scalar, SimdLevel::kScalar)->ArgName("berths")->Arg(20)->Arg(100)->Arg(500);
+BENCHMARK_CAPTURE(BM_EarliestFinish64, avx2, SimdLevel::kAvx2)->ArgName("berths")->Arg(20)->Arg(100)->Arg(500);
+BENCHMARK_CAPTURE(BM_EarliestFinish64, avx512, SimdLevel::kAvx512)->ArgName("berths")->Arg(20)->Arg(100)->Arg(500);
@@ -0,0 +1,206 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "leviathan/bnb/lower_bound_kernel.h"
+#include "leviathan/bnb/test_util.h"
+
+using namespace leviathan::bnb::testing;
+using leviathan::bnb::SimdLevel;
+
+namespace
+{
+    // All instruction sets this machine can run, scalar first.
+    std::vector<SimdLevel> supported_levels()
+    {
+        std::vector<SimdLevel> levels = {SimdLevel::kScalar};
+        const SimdLevel best = leviathan::system::get_simd_level();
+        if (best == SimdLevel::kAvx2 || best == SimdLevel::kAvx512)
+        {
+            levels.push_back(SimdLevel::kAvx2);
+        }
+        if (best == SimdLevel::kAvx512)
+        {
+            levels.push_back(SimdLevel::kAvx512);
+        }
+        return levels;
+    }
+
+    template <typename T>
+    void check_matches_scalar()
+    {
+        std::mt19937_64 rng(99);
+        std::uniform_int_distribution<T> time(-1000, 1000000);
+        std::uniform_int_distribution<T> duration(1, 5000);
+
+        for (size_t size = 0; size <= 70; ++size)
+        {
+            std::vector<T> free_times(size);
+            std::vector<T> processing(size);
+            for (size_t b = 0; b < size; ++b)
+            {
+                free_times[b] = time(rng);
+                processing[b] = duration(rng);
+            }
+            const T ready = time(rng);
+            const T expected = leviathan::bnb::earliest_finish_scalar<T>(free_times, ready, processing);
+
+            for (const SimdLevel level : supported_levels())
+            {
+                EXPECT_EQ(leviathan::bnb::earliest_finish<T>(free_times, ready, processing, level), expected)
+                    << "size " << size << " level " << static_cast<int>(level);
+            }
+        }
+    }
+}
+
+TEST(LowerBoundKernelTest, ScalarReference)
+{
+    const std::vector<int64_t> free_times = {10, 0, 30};
+    const std::vector<int64_t> processing = {5, 20, 1};
+
+    // Berth 0: max(10, 4) + 5 = 15, berth 1: max(0, 4) + 20 = 24, berth 2: 30 + 1 = 31.
+    EXPECT_EQ(leviathan::bnb::earliest_finish_scalar<int64_t>(free_times, 4, processing), 15);
+    EXPECT_EQ(leviathan::bnb::earliest_finish_scalar<int64_t>({}, 4, {}), INT64_MAX);
+}
+
+TEST(LowerBoundKernelTest, Int32MatchesScalar)
+{
+    check_matches_scalar<int32_t>();
+}
+
+TEST(LowerBoundKernelTest, Int64MatchesScalar)
+{
+    check_matches_scalar<int64_t>();
+}
+
+TEST(LowerBoundKernelTest, NarrowTimeTypesFallBackToScalar)
+{
+    const std::vector<int16_t> free_times = {3, 1};
+    const std::vector<int16_t> processing = {2, 9};
+    EXPECT_EQ(leviathan::bnb::earliest_finish<int16_t>(free_times, 2, processing), 5);
+}
+
+TEST(LowerBoundKernelTest, SlopedDifferenceScalarReference)
+{
+    const std::vector<double> entry = {0.0, 1.0, 5.0, 6.0};
+    const std::vector<double> exit = {4.0, 6.0, 7.0, 9.0};
+
+    // 0 + 4 - 0 = 4, 2 + 6 - 1 = 7, 4 + 7 - 5 = 6, 6 + 9 - 6 = 9.
+    const auto best = leviathan::bnb::min_sloped_difference_scalar<double>(entry, exit, 2.0);
+    EXPECT_DOUBLE_EQ(best.value, 4.0);
+    EXPECT_EQ(best.index, 0u);
+
+    // Without the slope, index 2 is cheapest.
+    EXPECT_EQ(leviathan::bnb::min_sloped_difference_scalar<double>(entry, exit, 0.0).index, 2u);
+}
+
+TEST(LowerBoundKernelTest, SlopedDifferenceMatchesScalar)
+{
+    std::mt19937_64 rng(3);
+    // Small integers keep every path exact and produce plenty of ties.
+    std::uniform_int_distribution<int> value(0, 20);
+
+    for (size_t size = 0; size <= 70; ++size)
+    {
+        std::vector<double> entry(size);
+        std::vector<double> exit(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            entry[i] = static_cast<double>(value(rng));
+            exit[i] = static_cast<double>(value(rng));
+        }
+        for (const double slope : {0.0, 1.0, -1.0})
+        {
+            const auto expected = leviathan::bnb::min_sloped_difference_scalar<double>(entry, exit, slope);
+            for (const SimdLevel level : supported_levels())
+            {
+                const auto actual = leviathan::bnb::min_sloped_difference<double>(entry, exit, slope, level);
+                EXPECT_EQ(actual.value, expected.value) << "size " << size << " level " << static_cast<int>(level);
+                EXPECT_EQ(actual.index, expected.index) << "size " << size << " level " << static_cast<int>(level);
+            }
+        }
+    }
+}
+
+TEST(LowerBoundKernelTest, ElementwiseMinMatchesScalar)
+{
+    std::mt19937_64 rng(12);
+    std::uniform_int_distribution<int64_t> time(-1000, 1000000);
+
+    for (size_t size = 0; size <= 40; ++size)
+    {
+        std::vector<int64_t> target(size);
+        std::vector<int64_t> source(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            target[i] = time(rng);
+            source[i] = time(rng);
+        }
+        std::vector<int64_t> expected = target;
+        leviathan::bnb::elementwise_min_scalar<int64_t>(expected, source);
+
+        for (const SimdLevel level : supported_levels())
+        {
+            std::vector<int64_t> actual64 = target;
+            leviathan::bnb::elementwise_min<int64_t>(actual64, source, level);
+            EXPECT_EQ(actual64, expected) << "size " << size << " level " << static_cast<int>(level);
+
+            std::vector<int32_t> actual32(target.begin(), target.end());
+            const std::vector<int32_t> source32(source.begin(), source.end());
+            leviathan::bnb::elementwise_min<int32_t>(actual32, source32, level);
+            EXPECT_TRUE(std::ranges::equal(actual32, expected)) << "size " << size << " level "
+                                                                << static_cast<int>(level);
+        }
+    }
+}
+
+TEST(LowerBoundKernelTest, BoundIsBelowTheOptimum)
+{
+    for (uint32_t seed = 0; seed < 10; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 5, 2);
+        const leviathan::bnb::SearchState<Time, Index, Cost> root(problem.num_berths(), problem.num_vessels());
+
+        const Cost bound = leviathan::bnb::earliest_finish_bound(problem, root);
+        EXPECT_GT(bound, 0.0) << "seed " << seed;
+        EXPECT_LE(bound, brute_force_optimum(problem)) << "seed " << seed;
+        for (const SimdLevel level : supported_levels())
+        {
+            EXPECT_EQ(leviathan::bnb::earliest_finish_bound(problem, root, level), bound) << "seed " << seed;
+        }
+    }
+}
+
+TEST(LowerBoundKernelTest, BoundCountsOnlyUnassignedVessels)
+{
+    // Vessel 0 occupies berth 1 until 12. Vessel 1 (ready 5, weight 2) finishes at
+    // max(0, 5) + 6 = 11 on berth 0 or max(12, 5) + 3 = 15 on berth 1.
+    const TestProblem problem({0, 5}, {1.0, 2.0}, {12, 4, 6, 3}, {{0, 100}, {0, 100}});
+    leviathan::bnb::SearchState<Time, Index, Cost> state(problem.num_berths(), problem.num_vessels());
+    state.apply_move(0, 1, 8, 12, problem.cost(0, 12));
+
+    EXPECT_DOUBLE_EQ(leviathan::bnb::earliest_finish_bound(problem, state), 12.0 + 2.0 * 6.0);
+}
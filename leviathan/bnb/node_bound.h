@@ -0,0 +1,99 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_NODE_BOUND_H_
+#define LEVIATHAN_BNB_NODE_BOUND_H_
+
+#include <concepts>
+#include <limits>
+#include "leviathan/base/config.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/shared_incumbent.h"
+
+namespace leviathan::bnb
+{
+    /// \brief A lower bound that a solver evaluates on the nodes it enters.
+    ///
+    /// The solver drives the bound through four hooks:
+    /// - `bound_root(state, incumbent)` once per search, on the root of the searched subtree.
+    ///   The bound (re)initializes itself there and may publish a schedule it found on the way
+    ///   (e.g. from a primal heuristic) to the incumbent.
+    /// - `notify_apply(state, move)` after every move applied below that root, and
+    ///   `notify_backtrack(state, undo)` after every such move is reverted, so incremental
+    ///   bounds follow the dive.
+    /// - `bound_node(state, upper_bound)` on every inner node entered, before it is expanded,
+    ///   with the current incumbent objective. A node whose bound reaches it is not expanded.
+    ///
+    /// Both bounding hooks return a lower bound on the objective of any completion of the state,
+    /// including `state.current_objective`. Bounds that are too expensive for every node return
+    /// `std::numeric_limits<CostType>::lowest()` on the nodes they skip.
+    ///
+    /// \tparam StateType The state the solver searches, SearchState or FixedSearchState.
+    template <typename B, typename TimeType, typename IndexType, typename CostType,
+              typename StateType = SearchState<TimeType, IndexType, CostType>>
+    concept NodeBound = requires(B& bound,
+                                 const StateType& state,
+                                 const SearchMove<TimeType, IndexType, CostType>& move,
+                                 const SearchUndo<TimeType, IndexType, CostType>& undo,
+                                 SharedIncumbent<TimeType, IndexType, CostType>& incumbent,
+                                 const CostType upper_bound)
+    {
+        { bound.bound_root(state, incumbent) } -> std::convertible_to<CostType>;
+        { bound.bound_node(state, upper_bound) } -> std::convertible_to<CostType>;
+        bound.notify_apply(state, move);
+        bound.notify_backtrack(state, undo);
+    };
+
+    /// \brief The NodeBound that bounds nothing; solvers skip its hooks entirely.
+    ///
+    /// Accepts any state type.
+    template <typename TimeType, typename IndexType, typename CostType>
+    struct NoNodeBound
+    {
+        template <typename StateType>
+        [[nodiscard]] static LEVIATHAN_FORCE_INLINE CostType bound_root(
+            const StateType&, SharedIncumbent<TimeType, IndexType, CostType>&) noexcept
+        {
+            return std::numeric_limits<CostType>::lowest();
+        }
+
+        template <typename StateType>
+        [[nodiscard]] static LEVIATHAN_FORCE_INLINE CostType bound_node(const StateType&, const CostType) noexcept
+        {
+            return std::numeric_limits<CostType>::lowest();
+        }
+
+        template <typename StateType>
+        static LEVIATHAN_FORCE_INLINE void notify_apply(const StateType&,
+                                                        const SearchMove<TimeType, IndexType, CostType>&) noexcept
+        {
+        }
+
+        template <typename StateType>
+        static LEVIATHAN_FORCE_INLINE void notify_backtrack(const StateType&,
+                                                            const SearchUndo<TimeType, IndexType, CostType>&) noexcept
+        {
+        }
+    };
+}
+
+#endif // LEVIATHAN_BNB_NODE_BOUND_H_
@@ -0,0 +1,564 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_PARALLEL_SOLVER_H_
+#define LEVIATHAN_BNB_PARALLEL_SOLVER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_stack.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/search_statistics.h"
+#include "leviathan/bnb/search_trail.h"
+#include "leviathan/bnb/shared_incumbent.h"
+
+namespace leviathan::bnb
+{
+    /// \brief Tuning knobs of the ParallelSolver.
+    struct ParallelSolverOptions
+    {
+        /// Number of worker threads; 0 selects std::thread::hardware_concurrency().
+        std::size_t num_threads = 0;
+        /// Maximum number of nodes (summed over all workers) to enter before the search stops.
+        std::uint64_t node_limit = std::numeric_limits<std::uint64_t>::max();
+        /// Reserve every worker's stack for the deepest possible dive (max_dive_entries()) instead
+        /// of at most kDiveReserveCap moves. That is O(B * V^2) moves per worker.
+        bool reserve_max_dive = false;
+    };
+
+    /// \brief Work-stealing parallel depth-first branch-and-bound.
+    ///
+    /// Every worker owns a private SearchStack, SearchTrail and SearchState and runs the
+    /// same depth-first loop as the DepthFirstSolver. Workers never touch each other's search
+    /// structures: an idle worker posts a steal request to a victim, and the victim itself
+    /// hands over the first pending sibling of its shallowest non-empty frame, together with
+    /// the decision path leading to it. The thief rebuilds the state by replaying that path.
+    ///
+    /// Termination is detected by counting idle workers. A donor counts its thief as busy
+    /// before publishing the work, so the count only reaches the number of workers once
+    /// no work is left anywhere.
+    ///
+    /// All workers prune against one SharedIncumbent, so a solution found on any thread
+    /// tightens the bound of every other thread with the next relaxed load.
+    ///
+    /// \tparam BrancherType The branching rule, see the Brancher concept. Each worker gets a copy.
+    template <typename TimeType, typename IndexType, typename CostType, typename BrancherType>
+        requires Brancher<BrancherType, TimeType, IndexType, CostType> && std::copy_constructible<BrancherType>
+    class ParallelSolver
+    {
+    public:
+        using state_type = SearchState<TimeType, IndexType, CostType>;
+        using move_type = SearchMove<TimeType, IndexType, CostType>;
+        using undo_type = SearchUndo<TimeType, IndexType, CostType>;
+        using stack_type = SearchStack<move_type>;
+        using trail_type = SearchTrail<undo_type>;
+        using incumbent_type = SharedIncumbent<TimeType, IndexType, CostType>;
+        using size_type = std::size_t;
+
+        static constexpr CostType kNoSolution = incumbent_type::kNoSolution;
+
+    private:
+        static constexpr int kNoThief = -1;
+        static constexpr std::uint64_t kSyncInterval = 256;
+
+        enum class Response : int
+        {
+            kWaiting,
+            kNoWork,
+            kWork,
+        };
+
+        struct alignas(LEVIATHAN_CACHE_LINE_SIZE) Worker
+        {
+            Worker(const size_type num_berths, const size_type num_vessels, const BrancherType& brancher_prototype,
+                   const bool reserve_max_dive)
+                : state(num_berths, num_vessels),
+                  brancher(brancher_prototype)
+            {
+                stack.reserve(dive_reserve_entries(num_berths, num_vessels, reserve_max_dive), num_vessels + 1);
+                trail.reserve(num_vessels, num_vessels);
+                path.reserve(num_vessels);
+                inbox.reserve(num_vessels);
+            }
+
+            state_type state;
+            stack_type stack;
+            trail_type trail;
+            BrancherType brancher;
+
+            /// Moves currently applied to the state, root first.
+            std::vector<move_type> path;
+            /// Length of the replayed prefix the current subtree hangs below.
+            size_type base_depth = 0;
+            std::uint64_t unsynced_nodes = 0;
+            SearchStatistics statistics;
+
+            /// Decision path received from a donor; valid once `response` is kWork.
+            std::vector<move_type> inbox;
+
+            alignas(LEVIATHAN_CACHE_LINE_SIZE) std::atomic<int> request{kNoThief};
+            alignas(LEVIATHAN_CACHE_LINE_SIZE) std::atomic<Response> response{Response::kWaiting};
+        };
+
+    public:
+        /// \brief Constructs a solver for an instance of the given size.
+        ///
+        /// \param num_berths The number of berths of the instance.
+        /// \param num_vessels The number of vessels of the instance.
+        /// \param brancher The branching rule; copied into every worker.
+        /// \param options The thread count and search limits.
+        ParallelSolver(const size_type num_berths, const size_type num_vessels, const BrancherType& brancher,
+                       const ParallelSolverOptions options = {})
+            : root_(num_berths, num_vessels),
+              options_(options),
+              owned_incumbent_(num_vessels),
+              best_assignments_(num_vessels, state_type::kUnassignedVessel),
+              best_start_times_(num_vessels, 0)
+        {
+            size_type threads = options_.num_threads;
+            if (threads == 0)
+            {
+                threads = std::max<size_type>(std::thread::hardware_concurrency(), 1);
+            }
+            workers_.reserve(threads);
+            for (size_type i = 0; i < threads; ++i)
+            {
+                workers_.push_back(std::make_unique<Worker>(num_berths, num_vessels, brancher,
+                                                            options_.reserve_max_dive));
+            }
+        }
+
+        /// \brief Returns the root state. May be modified before solve() (e.g. initial berth free times).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE state_type& state() noexcept
+        {
+            return root_;
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const state_type& state() const noexcept
+        {
+            return root_;
+        }
+
+        /// \brief Resets the incumbent to an upper bound; only strictly better solutions will be reported.
+        ///
+        /// Must not be called while another solver searches with the same incumbent.
+        LEVIATHAN_FORCE_INLINE void set_upper_bound(const CostType upper_bound) noexcept
+        {
+            incumbent_->reset(upper_bound);
+        }
+
+        /// \brief Prunes against and publishes to an external incumbent instead of the owned one.
+        ///
+        /// \param incumbent The shared incumbent. Must outlive the solver.
+        LEVIATHAN_FORCE_INLINE void attach_incumbent(incumbent_type& incumbent) noexcept
+        {
+            incumbent_ = &incumbent;
+        }
+
+        /// \brief Returns the incumbent the workers prune against.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE incumbent_type& incumbent() noexcept
+        {
+            return *incumbent_;
+        }
+
+        /// \brief Makes the search stop (as if a limit was hit) once `flag` becomes true.
+        ///
+        /// Workers observe the flag when they synchronize their node counts.
+        ///
+        /// \param flag The stop flag, usually raised by another thread. Must outlive the solver.
+        LEVIATHAN_FORCE_INLINE void attach_stop_flag(const std::atomic<bool>& flag) noexcept
+        {
+            stop_flag_ = &flag;
+        }
+
+        /// \brief Returns the number of worker threads.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type num_threads() const noexcept
+        {
+            return workers_.size();
+        }
+
+        /// \brief Runs the search on all workers. The calling thread acts as worker 0.
+        SearchStatus solve()
+        {
+            const size_type num_workers = workers_.size();
+            root_unassigned_ = static_cast<size_type>(root_.num_unassigned());
+            stop_.store(false, std::memory_order_relaxed);
+            total_nodes_.store(0, std::memory_order_relaxed);
+
+            for (const auto& worker : workers_)
+            {
+                worker->state = root_;
+                worker->stack.clear();
+                worker->inbox.clear();
+                worker->unsynced_nodes = 0;
+                worker->statistics = {};
+                worker->request.store(kNoThief, std::memory_order_relaxed);
+                worker->response.store(Response::kWaiting, std::memory_order_relaxed);
+            }
+
+            // Worker 0 starts with the root; everybody else starts out idle.
+            idle_count_.store(static_cast<int>(num_workers) - 1, std::memory_order_release);
+
+            std::vector<std::thread> threads;
+            threads.reserve(num_workers - 1);
+            for (size_type i = 1; i < num_workers; ++i)
+            {
+                threads.emplace_back([this, i]
+                {
+                    run_worker(i, false);
+                });
+            }
+            run_worker(0, true);
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+
+            statistics_ = {};
+            for (const auto& worker : workers_)
+            {
+                statistics_.nodes += worker->statistics.nodes;
+                statistics_.pruned += worker->statistics.pruned;
+                statistics_.solutions += worker->statistics.solutions;
+                statistics_.steals += worker->statistics.steals;
+                statistics_.max_depth = std::max(statistics_.max_depth, worker->statistics.max_depth);
+            }
+
+            const bool has_incumbent = incumbent_->has_solution();
+            if (has_incumbent)
+            {
+                incumbent_->read(best_assignments_, best_start_times_);
+            }
+
+            const bool exhausted = !stop_.load(std::memory_order_relaxed);
+            if (exhausted)
+            {
+                return has_incumbent ? SearchStatus::kOptimal : SearchStatus::kInfeasible;
+            }
+            return has_incumbent ? SearchStatus::kFeasible : SearchStatus::kLimitReached;
+        }
+
+        /// \brief Returns true if the incumbent holds a solution.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool has_solution() const noexcept
+        {
+            return incumbent_->has_solution();
+        }
+
+        /// \brief Returns the objective of the incumbent (or the upper bound if none was found).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType best_objective() const noexcept
+        {
+            return incumbent_->objective();
+        }
+
+        /// \brief Returns the berth of every vessel in the incumbent.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const IndexType> best_assignments() const noexcept
+        {
+            return best_assignments_;
+        }
+
+        /// \brief Returns the start time of every vessel in the incumbent.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const TimeType> best_start_times() const noexcept
+        {
+            return best_start_times_;
+        }
+
+        /// \brief Returns the counters of the last solve() call, summed over all workers.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const SearchStatistics& statistics() const noexcept
+        {
+            return statistics_;
+        }
+
+        /// \brief Returns the counters of a single worker.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const SearchStatistics& worker_statistics(const size_type i) const
+        {
+            DCHECK_LT(i, workers_.size());
+            return workers_[i]->statistics;
+        }
+
+    private:
+        void run_worker(const size_type id, bool has_work)
+        {
+            Worker& worker = *workers_[id];
+            while (true)
+            {
+                if (has_work)
+                {
+                    explore(worker);
+                    idle_count_.fetch_add(1, std::memory_order_acq_rel);
+                }
+                if (!acquire_work(id))
+                {
+                    return;
+                }
+                has_work = true;
+            }
+        }
+
+        /// \brief Replays the inbox path and searches the subtree below it depth-first.
+        void explore(Worker& worker)
+        {
+            for (const move_type& move : worker.inbox)
+            {
+                push_move(worker, move);
+            }
+            worker.base_depth = worker.path.size();
+
+            if (worker.path.size() == root_unassigned_)
+            {
+                record_solution(worker);
+                unwind(worker);
+                return;
+            }
+
+            expand(worker);
+            while (!worker.stack.empty())
+            {
+                if (LEVIATHAN_UNLIKELY(worker.request.load(std::memory_order_relaxed) != kNoThief))
+                {
+                    serve_request(worker);
+                }
+
+                if (worker.stack.current_frame_size() == 0)
+                {
+                    worker.stack.pop_frame();
+                    if (worker.path.size() > worker.base_depth)
+                    {
+                        pop_move(worker);
+                    }
+                    continue;
+                }
+
+                const move_type move = worker.stack.top();
+                worker.stack.pop_entry();
+
+                if (move.lower_bound >= incumbent_->objective())
+                {
+                    ++worker.statistics.pruned;
+                    continue;
+                }
+
+                if (LEVIATHAN_UNLIKELY(++worker.unsynced_nodes >= kSyncInterval) && !synchronize(worker))
+                {
+                    break;
+                }
+
+                push_move(worker, move);
+                ++worker.statistics.nodes;
+                worker.statistics.max_depth = std::max<std::uint64_t>(worker.statistics.max_depth,
+                                                                      worker.path.size());
+
+                if (worker.path.size() == root_unassigned_)
+                {
+                    record_solution(worker);
+                    pop_move(worker);
+                    continue;
+                }
+
+                expand(worker);
+            }
+
+            unwind(worker);
+        }
+
+        /// \brief Hands the first pending sibling of the shallowest non-empty frame to the requesting thief.
+        void serve_request(Worker& worker)
+        {
+            const int thief_id = worker.request.load(std::memory_order_acquire);
+            Worker& thief = *workers_[static_cast<size_type>(thief_id)];
+
+            // Keep at least one pending decision for ourselves.
+            if (worker.stack.size() >= 2)
+            {
+                for (size_type k = 0; k < worker.stack.depth(); ++k)
+                {
+                    const auto frame = worker.stack.frame_entries(k);
+                    if (frame.empty() || frame.front().lower_bound >= incumbent_->objective())
+                    {
+                        continue;
+                    }
+
+                    // Frame k holds the children of the node reached by the first base_depth + k moves.
+                    const auto prefix = static_cast<std::ptrdiff_t>(worker.base_depth + k);
+                    thief.inbox.assign(worker.path.begin(), worker.path.begin() + prefix);
+                    thief.inbox.push_back(frame.front());
+                    worker.stack.erase_entry(k, 0);
+
+                    idle_count_.fetch_sub(1, std::memory_order_acq_rel);
+                    worker.request.store(kNoThief, std::memory_order_relaxed);
+                    thief.response.store(Response::kWork, std::memory_order_release);
+                    return;
+                }
+            }
+
+            worker.request.store(kNoThief, std::memory_order_relaxed);
+            thief.response.store(Response::kNoWork, std::memory_order_release);
+        }
+
+        /// \brief Declines a pending steal request while the worker has nothing to give.
+        LEVIATHAN_FORCE_INLINE void decline_request(Worker& worker)
+        {
+            const int thief_id = worker.request.load(std::memory_order_acquire);
+            if (thief_id != kNoThief)
+            {
+                worker.request.store(kNoThief, std::memory_order_relaxed);
+                workers_[static_cast<size_type>(thief_id)]->response.store(Response::kNoWork,
+                                                                          std::memory_order_release);
+            }
+        }
+
+        /// \brief Steals work from other workers until some is received or the search is over.
+        ///
+        /// \return true if the inbox holds a new subtree, false on termination.
+        bool acquire_work(const size_type id)
+        {
+            Worker& worker = *workers_[id];
+            const auto num_workers = static_cast<int>(workers_.size());
+            size_type victim = id;
+
+            while (true)
+            {
+                decline_request(worker);
+                if (stop_.load(std::memory_order_relaxed) ||
+                    idle_count_.load(std::memory_order_acquire) == num_workers)
+                {
+                    return false;
+                }
+
+                victim = (victim + 1) % workers_.size();
+                if (victim == id)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                worker.response.store(Response::kWaiting, std::memory_order_relaxed);
+                int expected = kNoThief;
+                if (!workers_[victim]->request.compare_exchange_strong(expected, static_cast<int>(id),
+                                                                       std::memory_order_acq_rel))
+                {
+                    continue;
+                }
+
+                Response response;
+                while ((response = worker.response.load(std::memory_order_acquire)) == Response::kWaiting)
+                {
+                    // Two idle workers may target each other; always answer our own requests while waiting.
+                    decline_request(worker);
+                    if (stop_.load(std::memory_order_relaxed) ||
+                        idle_count_.load(std::memory_order_acquire) == num_workers)
+                    {
+                        return false;
+                    }
+                    std::this_thread::yield();
+                }
+
+                if (response == Response::kWork)
+                {
+                    ++worker.statistics.steals;
+                    return true;
+                }
+            }
+        }
+
+        /// \brief Publishes the local node count and checks the stop flag.
+        ///
+        /// \return false if the search has to stop.
+        bool synchronize(Worker& worker)
+        {
+            const std::uint64_t total = total_nodes_.fetch_add(worker.unsynced_nodes, std::memory_order_relaxed) +
+                worker.unsynced_nodes;
+            worker.unsynced_nodes = 0;
+            if (total >= options_.node_limit || stop_flag_->load(std::memory_order_relaxed))
+            {
+                stop_.store(true, std::memory_order_relaxed);
+            }
+            return !stop_.load(std::memory_order_relaxed);
+        }
+
+        LEVIATHAN_FORCE_INLINE void record_solution(Worker& worker)
+        {
+            if (incumbent_->try_improve(worker.state))
+            {
+                ++worker.statistics.solutions;
+            }
+        }
+
+        LEVIATHAN_FORCE_INLINE void expand(Worker& worker)
+        {
+            worker.stack.fill_frame([&worker](stack_type& stack)
+            {
+                worker.brancher.branch(worker.state, stack);
+            });
+            std::ranges::reverse(worker.stack.current_frame_entries());
+        }
+
+        LEVIATHAN_FORCE_INLINE void push_move(Worker& worker, const move_type& move)
+        {
+            apply_decision(worker.state, worker.trail, move);
+            worker.path.push_back(move);
+        }
+
+        LEVIATHAN_FORCE_INLINE void pop_move(Worker& worker)
+        {
+            backtrack_decision(worker.state, worker.trail);
+            worker.path.pop_back();
+        }
+
+        /// \brief Undoes every applied move, including the replayed prefix, and drops pending work.
+        LEVIATHAN_FORCE_INLINE void unwind(Worker& worker)
+        {
+            while (!worker.path.empty())
+            {
+                pop_move(worker);
+            }
+            worker.stack.clear();
+        }
+
+        state_type root_;
+        ParallelSolverOptions options_;
+        std::vector<std::unique_ptr<Worker>> workers_;
+        SearchStatistics statistics_;
+        size_type root_unassigned_ = 0;
+
+        alignas(LEVIATHAN_CACHE_LINE_SIZE) std::atomic<int> idle_count_{0};
+        alignas(LEVIATHAN_CACHE_LINE_SIZE) std::atomic<bool> stop_{false};
+        alignas(LEVIATHAN_CACHE_LINE_SIZE) std::atomic<std::uint64_t> total_nodes_{0};
+
+        incumbent_type owned_incumbent_;
+        incumbent_type* incumbent_ = &owned_incumbent_;
+        std::atomic<bool> never_stop_{false};
+        const std::atomic<bool>* stop_flag_ = &never_stop_;
+        std::vector<IndexType> best_assignments_;
+        std::vector<TimeType> best_start_times_;
+    };
+}
+
+#endif // LEVIATHAN_BNB_PARALLEL_SOLVER_H_
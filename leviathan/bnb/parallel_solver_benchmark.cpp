@@ -0,0 +1,81 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include "leviathan/bnb/assignment_brancher.h"
+#include "leviathan/bnb/deterministic_solver.h"
+#include "leviathan/bnb/parallel_solver.h"
+#include "leviathan/bnb/test_util.h"
+
+// Compares the node throughput of the work-stealing solver and the deterministic
+// epoch-based solver on the same instance. The gap between the two is the price of
+// reproducibility: bounds only propagate at epoch boundaries and threads wait at the barrier.
+
+namespace
+{
+    using namespace leviathan::bnb::testing;
+    using Brancher = leviathan::bnb::AssignmentBrancher<Time, Index, Cost>;
+
+    constexpr uint32_t kSeed = 42;
+    constexpr size_t kVessels = 8;
+    constexpr size_t kBerths = 3;
+
+    void BM_WorkStealingSolver(benchmark::State& state)
+    {
+        const TestProblem problem = make_random_problem(kSeed, kVessels, kBerths);
+        const auto threads = static_cast<size_t>(state.range(0));
+        std::uint64_t nodes = 0;
+
+        for (auto _ : state)
+        {
+            leviathan::bnb::ParallelSolver<Time, Index, Cost, Brancher> solver(
+                problem.num_berths(), problem.num_vessels(), Brancher(problem), {.num_threads = threads});
+            benchmark::DoNotOptimize(solver.solve());
+            nodes += solver.statistics().nodes;
+        }
+
+        state.counters["nodes"] = benchmark::Counter(static_cast<double>(nodes), benchmark::Counter::kAvgIterations);
+        state.counters["nodes_per_second"] = benchmark::Counter(static_cast<double>(nodes),
+                                                                benchmark::Counter::kIsRate);
+    }
+
+    void BM_DeterministicSolver(benchmark::State& state)
+    {
+        const TestProblem problem = make_random_problem(kSeed, kVessels, kBerths);
+        const auto threads = static_cast<size_t>(state.range(0));
+        std::uint64_t nodes = 0;
+
+        for (auto _ : state)
+        {
+            leviathan::bnb::DeterministicSolver<Time, Index, Cost, Brancher> solver(
+                problem.num_berths(), problem.num_vessels(), Brancher(problem), {.num_threads = threads});
+            benchmark::DoNotOptimize(solver.solve());
+            nodes += solver.statistics().nodes;
+        }
+
+        state.counters["nodes"] = benchmark::Counter(static_cast<double>(nodes), benchmark::Counter::kAvgIterations);
+        state.counters["nodes_per_second"] = benchmark::Counter(static_cast<double>(nodes),
+                                                                benchmark::Counter::kIsRate);
+    }
+}
+
+BENCHMARK(BM_WorkStealingSolver)->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DeterministicSolver)->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,101 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "leviathan/bnb/assignment_brancher.h"
+#include "leviathan/bnb/depth_first_solver.h"
+#include "leviathan/bnb/parallel_solver.h"
+#include "leviathan/bnb/test_util.h"
+
+using namespace leviathan::bnb::testing;
+using Brancher = leviathan::bnb::AssignmentBrancher<Time, Index, Cost>;
+using Solver = leviathan::bnb::ParallelSolver<Time, Index, Cost, Brancher>;
+using DfsSolver = leviathan::bnb::DepthFirstSolver<Time, Index, Cost, Brancher>;
+using leviathan::bnb::SearchStatus;
+
+TEST(ParallelSolverTest, SingleThreadMatchesBruteForce)
+{
+    for (uint32_t seed = 0; seed < 10; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 5, 2);
+        Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.num_threads = 1});
+
+        ASSERT_EQ(solver.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(solver.best_objective(), brute_force_optimum(problem)) << "seed " << seed;
+    }
+}
+
+TEST(ParallelSolverTest, MultipleThreadsMatchBruteForce)
+{
+    for (uint32_t seed = 0; seed < 10; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 5, 2);
+        Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.num_threads = 4});
+
+        ASSERT_EQ(solver.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(solver.best_objective(), brute_force_optimum(problem)) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(evaluate_schedule(problem, solver.best_assignments(), solver.best_start_times()),
+                         solver.best_objective()) << "seed " << seed;
+    }
+}
+
+TEST(ParallelSolverTest, WorkIsSharedOnLargerInstances)
+{
+    const TestProblem problem = make_random_problem(42, 8, 3);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.num_threads = 4});
+    DfsSolver reference(problem.num_berths(), problem.num_vessels(), Brancher(problem));
+
+    ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+    ASSERT_EQ(reference.solve(), SearchStatus::kOptimal);
+    EXPECT_DOUBLE_EQ(solver.best_objective(), reference.best_objective());
+    EXPECT_GT(solver.statistics().steals, 0);
+
+    std::uint64_t nodes = 0;
+    for (size_t i = 0; i < solver.num_threads(); ++i)
+    {
+        nodes += solver.worker_statistics(i).nodes;
+    }
+    EXPECT_EQ(nodes, solver.statistics().nodes);
+}
+
+TEST(ParallelSolverTest, RepeatedSolvesAreConsistent)
+{
+    const TestProblem problem = make_random_problem(17, 6, 3);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.num_threads = 3});
+
+    ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+    const Cost first = solver.best_objective();
+
+    solver.set_upper_bound(Solver::kNoSolution);
+    ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+    EXPECT_DOUBLE_EQ(solver.best_objective(), first);
+}
+
+TEST(ParallelSolverTest, NodeLimitStops)
+{
+    const TestProblem problem = make_random_problem(3, 9, 3);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem),
+                  {.num_threads = 4, .node_limit = 1000});
+
+    const SearchStatus status = solver.solve();
+    EXPECT_TRUE(status == SearchStatus::kFeasible || status == SearchStatus::kLimitReached);
+}
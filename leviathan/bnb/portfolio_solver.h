@@ -0,0 +1,248 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_PORTFOLIO_SOLVER_H_
+#define LEVIATHAN_BNB_PORTFOLIO_SOLVER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/search_statistics.h"
+#include "leviathan/bnb/shared_incumbent.h"
+
+namespace leviathan::bnb
+{
+    /// \brief The outcome of one member of a portfolio run.
+    struct PortfolioMemberReport
+    {
+        /// The name the member was registered under.
+        std::string name;
+        /// The status the member's own solve() returned.
+        SearchStatus status = SearchStatus::kLimitReached;
+        /// The member's own counters.
+        SearchStatistics statistics;
+        /// True for the member whose exhausted search ended the race.
+        bool won = false;
+        /// Wall-clock time the member spent in solve().
+        std::chrono::nanoseconds elapsed{0};
+    };
+
+    /// \brief Races differently configured solvers against each other on separate threads.
+    ///
+    /// Every member is an existing solver (DepthFirstSolver, BestFirstSolver, ParallelSolver, ...)
+    /// set up by the caller with its own brancher and options. The portfolio attaches its shared
+    /// incumbent and a common stop flag to each of them, so a solution found by one member
+    /// immediately tightens the pruning of all others. The first member that exhausts its tree
+    /// proves the incumbent optimal (or the instance infeasible), raises the stop flag and wins;
+    /// the remaining members stop at their next node.
+    ///
+    /// The per-member reports record which configuration won, how far each got and how many of
+    /// the improving solutions it contributed, which is what is needed to trim a portfolio.
+    template <typename TimeType, typename IndexType, typename CostType>
+    class PortfolioSolver
+    {
+    public:
+        using incumbent_type = SharedIncumbent<TimeType, IndexType, CostType>;
+        using size_type = std::size_t;
+
+        static constexpr CostType kNoSolution = incumbent_type::kNoSolution;
+        static constexpr size_type kNoWinner = static_cast<size_type>(-1);
+
+        /// \brief Constructs an empty portfolio for an instance with the given number of vessels.
+        explicit PortfolioSolver(const size_type num_vessels)
+            : incumbent_(num_vessels),
+              best_assignments_(num_vessels, SearchState<TimeType, IndexType, CostType>::kUnassignedVessel),
+              best_start_times_(num_vessels, 0)
+        {
+        }
+
+        PortfolioSolver(const PortfolioSolver&) = delete;
+        PortfolioSolver& operator=(const PortfolioSolver&) = delete;
+
+        /// \brief Registers a solver as a member of the portfolio.
+        ///
+        /// The solver must solve the same instance, must outlive the portfolio and must not be
+        /// used elsewhere while solve() runs. Its incumbent and stop flag are replaced by the
+        /// portfolio's.
+        ///
+        /// \param name A label for the member's report.
+        /// \param solver The configured solver.
+        template <typename SolverType>
+        void add(const std::string_view name, SolverType& solver)
+        {
+            solver.attach_incumbent(incumbent_);
+            solver.attach_stop_flag(stop_);
+            members_.push_back(Member{
+                [&solver]() { return solver.solve(); },
+                [&solver]() { return solver.statistics(); },
+            });
+            PortfolioMemberReport& report = reports_.emplace_back();
+            report.name = name;
+        }
+
+        /// \brief Returns the number of members.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type size() const noexcept
+        {
+            return members_.size();
+        }
+
+        /// \brief Resets the shared incumbent to an upper bound; only strictly better solutions will be reported.
+        LEVIATHAN_FORCE_INLINE void set_upper_bound(const CostType upper_bound) noexcept
+        {
+            incumbent_.reset(upper_bound);
+        }
+
+        /// \brief Returns the incumbent shared by all members.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE incumbent_type& incumbent() noexcept
+        {
+            return incumbent_;
+        }
+
+        /// \brief Runs all members concurrently until one of them finishes its search.
+        ///
+        /// The calling thread runs member 0. If no member exhausts its tree (all hit their own
+        /// limits), the result reports whatever the shared incumbent holds.
+        SearchStatus solve()
+        {
+            DCHECK(!members_.empty());
+            stop_.store(false, std::memory_order_relaxed);
+            winner_.store(kNoWinner, std::memory_order_relaxed);
+
+            std::vector<std::thread> threads;
+            threads.reserve(members_.size() - 1);
+            for (size_type i = 1; i < members_.size(); ++i)
+            {
+                threads.emplace_back([this, i]() { run(i); });
+            }
+            run(0);
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+
+            if (incumbent_.has_solution())
+            {
+                incumbent_.read(best_assignments_, best_start_times_);
+            }
+
+            const size_type winner = winner_.load(std::memory_order_relaxed);
+            if (winner != kNoWinner)
+            {
+                return reports_[winner].status;
+            }
+            return incumbent_.has_solution() ? SearchStatus::kFeasible : SearchStatus::kLimitReached;
+        }
+
+        /// \brief Returns the index of the member that ended the last race, or kNoWinner.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type winner() const noexcept
+        {
+            return winner_.load(std::memory_order_relaxed);
+        }
+
+        /// \brief Returns the report of member `i` for the last solve().
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const PortfolioMemberReport& report(const size_type i) const noexcept
+        {
+            DCHECK_LT(i, reports_.size());
+            return reports_[i];
+        }
+
+        /// \brief Returns the reports of all members for the last solve(), in registration order.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const PortfolioMemberReport> reports() const noexcept
+        {
+            return reports_;
+        }
+
+        /// \brief Returns true if any member found a solution.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool has_solution() const noexcept
+        {
+            return incumbent_.has_solution();
+        }
+
+        /// \brief Returns the objective of the incumbent (or the upper bound if none was found).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType best_objective() const noexcept
+        {
+            return incumbent_.objective();
+        }
+
+        /// \brief Returns the berth of every vessel in the best schedule.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const IndexType> best_assignments() const noexcept
+        {
+            return best_assignments_;
+        }
+
+        /// \brief Returns the start time of every vessel in the best schedule.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const TimeType> best_start_times() const noexcept
+        {
+            return best_start_times_;
+        }
+
+    private:
+        /// \brief The type-erased entry points of a member solver.
+        struct Member
+        {
+            std::function<SearchStatus()> solve;
+            std::function<SearchStatistics()> statistics;
+        };
+
+        void run(const size_type i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const SearchStatus status = members_[i].solve();
+            const auto end = std::chrono::steady_clock::now();
+
+            PortfolioMemberReport& report = reports_[i];
+            report.status = status;
+            report.statistics = members_[i].statistics();
+            report.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+            report.won = false;
+
+            if (status == SearchStatus::kOptimal || status == SearchStatus::kInfeasible)
+            {
+                size_type expected = kNoWinner;
+                if (winner_.compare_exchange_strong(expected, i, std::memory_order_relaxed))
+                {
+                    report.won = true;
+                    stop_.store(true, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        incumbent_type incumbent_;
+        std::atomic<bool> stop_{false};
+        std::atomic<size_type> winner_{kNoWinner};
+        std::vector<Member> members_;
+        std::vector<PortfolioMemberReport> reports_;
+        std::vector<IndexType> best_assignments_;
+        std::vector<TimeType> best_start_times_;
+    };
+}
+
+#endif // LEVIATHAN_BNB_PORTFOLIO_SOLVER_H_
@@ -0,0 +1,123 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include "leviathan/bnb/assignment_brancher.h"
+#include "leviathan/bnb/best_first_solver.h"
+#include "leviathan/bnb/depth_first_solver.h"
+#include "leviathan/bnb/parallel_solver.h"
+#include "leviathan/bnb/portfolio_solver.h"
+#include "leviathan/bnb/test_util.h"
+
+using namespace leviathan::bnb::testing;
+using Brancher = leviathan::bnb::AssignmentBrancher<Time, Index, Cost>;
+using Portfolio = leviathan::bnb::PortfolioSolver<Time, Index, Cost>;
+using leviathan::bnb::SearchStatus;
+
+namespace
+{
+    /// Explores the children of AssignmentBrancher in reverse order, a deliberately poor configuration.
+    struct ReversedBrancher
+    {
+        Brancher inner;
+
+        void branch(const leviathan::bnb::SearchState<Time, Index, Cost>& state,
+                    leviathan::bnb::SearchStack<leviathan::bnb::SearchMove<Time, Index, Cost>>& stack)
+        {
+            inner.branch(state, stack);
+            std::ranges::reverse(stack.current_frame_entries());
+        }
+    };
+}
+
+TEST(PortfolioSolverTest, MatchesBruteForce)
+{
+    for (uint32_t seed = 0; seed < 10; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 5, 2);
+        leviathan::bnb::DepthFirstSolver<Time, Index, Cost, Brancher> dfs(
+            problem.num_berths(), problem.num_vessels(), Brancher(problem));
+        leviathan::bnb::BestFirstSolver<Time, Index, Cost, Brancher> best_first(
+            problem.num_berths(), problem.num_vessels(), Brancher(problem));
+        leviathan::bnb::DepthFirstSolver<Time, Index, Cost, ReversedBrancher> reversed(
+            problem.num_berths(), problem.num_vessels(), ReversedBrancher{Brancher(problem)});
+
+        Portfolio portfolio(problem.num_vessels());
+        portfolio.add("dfs", dfs);
+        portfolio.add("best-first", best_first);
+        portfolio.add("dfs-reversed", reversed);
+        ASSERT_EQ(portfolio.size(), 3u);
+
+        ASSERT_EQ(portfolio.solve(), SearchStatus::kOptimal) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(portfolio.best_objective(), brute_force_optimum(problem)) << "seed " << seed;
+        EXPECT_DOUBLE_EQ(evaluate_schedule(problem, portfolio.best_assignments(), portfolio.best_start_times()),
+                         portfolio.best_objective()) << "seed " << seed;
+
+        ASSERT_NE(portfolio.winner(), Portfolio::kNoWinner);
+        const auto reports = portfolio.reports();
+        EXPECT_EQ(std::ranges::count_if(reports, [](const auto& report) { return report.won; }), 1);
+        EXPECT_TRUE(reports[portfolio.winner()].won);
+        EXPECT_EQ(reports[portfolio.winner()].status, SearchStatus::kOptimal);
+        EXPECT_EQ(reports[1].name, "best-first");
+    }
+}
+
+TEST(PortfolioSolverTest, InfeasibleUnderUpperBound)
+{
+    const TestProblem problem = make_random_problem(3, 5, 2);
+    leviathan::bnb::DepthFirstSolver<Time, Index, Cost, Brancher> dfs(
+        problem.num_berths(), problem.num_vessels(), Brancher(problem));
+    leviathan::bnb::BestFirstSolver<Time, Index, Cost, Brancher> best_first(
+        problem.num_berths(), problem.num_vessels(), Brancher(problem));
+
+    Portfolio portfolio(problem.num_vessels());
+    portfolio.add("dfs", dfs);
+    portfolio.add("best-first", best_first);
+    portfolio.set_upper_bound(brute_force_optimum(problem));
+
+    EXPECT_EQ(portfolio.solve(), SearchStatus::kInfeasible);
+    EXPECT_FALSE(portfolio.has_solution());
+}
+
+TEST(PortfolioSolverTest, ReportsLimitWhenNoMemberFinishes)
+{
+    const TestProblem problem = make_random_problem(7, 8, 3);
+    leviathan::bnb::DepthFirstSolver<Time, Index, Cost, Brancher> dfs(
+        problem.num_berths(), problem.num_vessels(), Brancher(problem), {.node_limit = 10});
+    leviathan::bnb::ParallelSolver<Time, Index, Cost, Brancher> parallel(
+        problem.num_berths(), problem.num_vessels(), Brancher(problem), {.num_threads = 2, .node_limit = 10});
+
+    Portfolio portfolio(problem.num_vessels());
+    portfolio.add("dfs", dfs);
+    portfolio.add("parallel", parallel);
+
+    const SearchStatus status = portfolio.solve();
+    EXPECT_TRUE(status == SearchStatus::kFeasible || status == SearchStatus::kLimitReached);
+    EXPECT_EQ(portfolio.winner(), Portfolio::kNoWinner);
+    for (const auto& report : portfolio.reports())
+    {
+        EXPECT_FALSE(report.won);
+        EXPECT_GT(report.statistics.nodes, 0u);
+    }
+}
@@ -0,0 +1,494 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef LEVIATHAN_BNB_PREEMPTIVE_BOUND_H_
+#define LEVIATHAN_BNB_PREEMPTIVE_BOUND_H_
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+#include "leviathan/bnb/problem.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/shared_incumbent.h"
+
+namespace leviathan::bnb
+{
+    /// \brief Preemptive relaxation bound over the availability windows of the berths.
+    ///
+    /// Each berth is a single machine that is open inside its BerthTimeline windows from its
+    /// free time on. Allowing preemption and letting a vessel's work (its shortest processing
+    /// time) be spread over any open berths turns the berths into one preemptive machine whose
+    /// capacity at time t is the number of open berths. On that machine, always working on the
+    /// released vessel with the highest weight per unit of work minimizes the weighted mean busy
+    /// time, and since a vessel that is served without interruption finishes half its
+    /// processing time after its mean busy time, the result is a lower bound on the weighted
+    /// flow time of the unassigned vessels. Unlike free-time sums, the bound charges vessels for
+    /// queueing behind each other and for closed windows.
+    ///
+    /// Fixing every vessel to its best berth up front would not be a relaxation (a vessel
+    /// served elsewhere would be charged for waiting it never does), so vessels stay fractional
+    /// across berths instead.
+    ///
+    /// The bound keeps the two orders the sweep consumes across moves instead of rebuilding them
+    /// at every node. The unassigned vessels sit in a doubly linked list in ready-time order, so
+    /// apply_move() unlinks the assigned vessel and backtrack_move() relinks it in O(1) (moves
+    /// must be reverted in reverse order). The berths are kept sorted by the time they next open,
+    /// and a move repositions only the berth whose free time it changed. The sweep itself, which
+    /// pools the berths into one machine, still runs at every value() call: it walks both orders
+    /// and keeps heaps only of released vessels and of windows already opened, in
+    /// O((unassigned + windows crossed) log(unassigned + berths)) per node.
+    ///
+    /// As a NodeBound, the bound rebuilds both orders on the root of a search, follows the
+    /// solver's moves with apply_move() and backtrack_move(), and runs the sweep on every node
+    /// the solver enters.
+    ///
+    /// Weights must be non-negative.
+    template <typename TimeType, typename IndexType, typename CostType>
+    class PreemptiveBound
+    {
+    public:
+        using problem_type = Problem<TimeType, IndexType, CostType>;
+        using state_type = SearchState<TimeType, IndexType, CostType>;
+        using move_type = SearchMove<TimeType, IndexType, CostType>;
+        using undo_type = SearchUndo<TimeType, IndexType, CostType>;
+        using incumbent_type = SharedIncumbent<TimeType, IndexType, CostType>;
+
+        /// \brief Returned by value() if the open windows cannot hold the remaining work.
+        static constexpr CostType kInfeasible = std::numeric_limits<CostType>::has_infinity
+                                                    ? std::numeric_limits<CostType>::infinity()
+                                                    : std::numeric_limits<CostType>::max();
+
+        /// \brief Allocates the bound without building its orders; reset() or bound_root() must come first.
+        ///
+        /// \param problem The problem instance. Must outlive the bound.
+        explicit PreemptiveBound(const problem_type& problem)
+            : problem_(&problem)
+        {
+            const size_t num_vessels = problem.num_vessels();
+            const size_t num_berths = problem.num_berths();
+            by_ready_.resize(num_vessels);
+            for (size_t v = 0; v < num_vessels; ++v)
+            {
+                by_ready_[v] = static_cast<IndexType>(v);
+            }
+            std::ranges::stable_sort(by_ready_, [&problem](const IndexType a, const IndexType b)
+            {
+                return problem.ready_time(a) < problem.ready_time(b);
+            });
+            rank_.resize(num_vessels);
+            for (size_t r = 0; r < num_vessels; ++r)
+            {
+                rank_[by_ready_[r]] = r;
+            }
+            next_.resize(num_vessels + 1);
+            previous_.resize(num_vessels + 1);
+
+            first_window_.resize(num_berths);
+            open_from_.resize(num_berths);
+            by_opening_.resize(num_berths);
+            opening_rank_.resize(num_berths);
+            for (size_t b = 0; b < num_berths; ++b)
+            {
+                by_opening_[b] = static_cast<IndexType>(b);
+                opening_rank_[b] = b;
+            }
+            remaining_work_.resize(num_vessels);
+            released_.reserve(num_vessels);
+            changes_.reserve(num_berths);
+            window_.resize(num_berths);
+        }
+
+        /// \brief Builds both orders for `state`.
+        ///
+        /// \param problem The problem instance. Must outlive the bound.
+        /// \param state The state the bound starts from, usually the root.
+        PreemptiveBound(const problem_type& problem, const state_type& state)
+            : PreemptiveBound(problem)
+        {
+            reset(state);
+        }
+
+        /// \brief Rebuilds the unassigned vessel list and the berth order for `state`.
+        void reset(const state_type& state)
+        {
+            DCHECK_EQ(state.berth_free_times.size(), problem_->num_berths());
+            DCHECK_EQ(state.vessel_assignments.size(), problem_->num_vessels());
+
+            size_t last = head();
+            for (size_t r = 0; r < by_ready_.size(); ++r)
+            {
+                if (!state.is_assigned(by_ready_[r]))
+                {
+                    next_[last] = r;
+                    previous_[r] = last;
+                    last = r;
+                }
+            }
+            next_[last] = head();
+            previous_[head()] = last;
+
+            for (size_t b = 0; b < problem_->num_berths(); ++b)
+            {
+                refresh_berth(state, static_cast<IndexType>(b));
+            }
+            std::ranges::sort(by_opening_, [this](const IndexType a, const IndexType b)
+            {
+                return opens_before(a, b);
+            });
+            for (size_t k = 0; k < by_opening_.size(); ++k)
+            {
+                opening_rank_[by_opening_[k]] = k;
+            }
+        }
+
+        /// \brief Follows a move just applied to `state`: unlinks the vessel and repositions the berth.
+        LEVIATHAN_FORCE_INLINE void apply_move(const state_type& state, const IndexType v_idx, const IndexType b_idx)
+        {
+            DCHECK(state.is_assigned(v_idx));
+            const size_t r = rank_[v_idx];
+            next_[previous_[r]] = next_[r];
+            previous_[next_[r]] = previous_[r];
+            update_berth(state, b_idx);
+        }
+
+        /// \brief Follows the most recent apply_move() being reverted on `state`.
+        LEVIATHAN_FORCE_INLINE void backtrack_move(const state_type& state, const IndexType v_idx,
+                                                   const IndexType b_idx)
+        {
+            DCHECK(!state.is_assigned(v_idx));
+            // The neighbours of a vessel unlinked last are still its neighbours.
+            const size_t r = rank_[v_idx];
+            next_[previous_[r]] = r;
+            previous_[next_[r]] = r;
+            update_berth(state, b_idx);
+        }
+
+        /// \brief Returns the lower bound on the cost still to be added by the unassigned vessels.
+        [[nodiscard]] CostType value(const state_type& state)
+        {
+            DCHECK_EQ(state.vessel_assignments.size(), problem_->num_vessels());
+
+            // Per-vessel constant part: weight * (work / 2 - ready). The sweep adds weight * mean busy time.
+            double total = 0.0;
+            size_t pending = 0;
+            for (size_t r = next_[head()]; r != head(); r = next_[r])
+            {
+                const IndexType v = by_ready_[r];
+                DCHECK(!state.is_assigned(v));
+                const auto weight = static_cast<double>(problem_->weight(v));
+                const auto work = static_cast<double>(problem_->min_processing_time(v));
+                DCHECK_GE(weight, 0.0);
+                remaining_work_[v] = work;
+                total += weight * (0.5 * work - static_cast<double>(problem_->ready_time(v)));
+                ++pending;
+            }
+            DCHECK_EQ(pending, state.num_unassigned());
+            if (pending == 0)
+            {
+                return CostType{0};
+            }
+
+            // Berths open in by_opening_ order; the heap only holds the later changes of opened berths.
+            changes_.clear();
+            released_.clear();
+            int capacity = 0;
+            size_t next_opening = 0;
+            size_t next_release = next_[head()];
+            double now = -std::numeric_limits<double>::infinity();
+            while (pending > 0)
+            {
+                // Apply every release and capacity change that is due.
+                double release_time = std::numeric_limits<double>::infinity();
+                double change_time = std::numeric_limits<double>::infinity();
+                while (true)
+                {
+                    release_time = next_release != head()
+                                       ? static_cast<double>(problem_->ready_time(by_ready_[next_release]))
+                                       : std::numeric_limits<double>::infinity();
+                    const double opening_time = next_opening < by_opening_.size() &&
+                                                has_window(by_opening_[next_opening])
+                                                    ? static_cast<double>(open_from_[by_opening_[next_opening]])
+                                                    : std::numeric_limits<double>::infinity();
+                    const double heap_time = changes_.empty()
+                                                 ? std::numeric_limits<double>::infinity()
+                                                 : static_cast<double>(changes_.front().first);
+                    change_time = std::min(opening_time, heap_time);
+                    if (release_time <= now)
+                    {
+                        release(by_ready_[next_release], total, pending);
+                        next_release = next_[next_release];
+                    }
+                    else if (opening_time <= now)
+                    {
+                        open_berth(by_opening_[next_opening++], capacity);
+                    }
+                    else if (heap_time <= now)
+                    {
+                        std::ranges::pop_heap(changes_, std::greater<>{});
+                        toggle_berth(capacity);
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+                const double next_event = std::min(release_time, change_time);
+
+                if (released_.empty() || capacity == 0)
+                {
+                    if (next_event == std::numeric_limits<double>::infinity())
+                    {
+                        // Work is left but no berth will ever open again.
+                        return kInfeasible;
+                    }
+                    now = next_event;
+                    continue;
+                }
+
+                // All capacity goes to the densest released vessel until it finishes or an event occurs.
+                const auto [density, v] = released_.front();
+                const auto rate = static_cast<double>(capacity);
+                const double finish = now + remaining_work_[v] / rate;
+                const double until = std::min(finish, next_event);
+                total += density * rate * 0.5 * (until - now) * (until + now);
+                if (finish <= next_event)
+                {
+                    std::ranges::pop_heap(released_);
+                    released_.pop_back();
+                    --pending;
+                }
+                else
+                {
+                    remaining_work_[v] -= rate * (until - now);
+                }
+                now = until;
+            }
+            return to_cost(total);
+        }
+
+        /// \brief Returns `state.current_objective` plus value().
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType lower_bound(const state_type& state)
+        {
+            const CostType remaining = value(state);
+            return remaining == kInfeasible ? kInfeasible : state.current_objective + remaining;
+        }
+
+        /// \name NodeBound hooks
+        /// @{
+
+        /// \brief Rebuilds both orders for the root of a search and bounds it.
+        CostType bound_root(const state_type& state, const incumbent_type&)
+        {
+            reset(state);
+            return lower_bound(state);
+        }
+
+        CostType bound_node(const state_type& state, const CostType)
+        {
+            return lower_bound(state);
+        }
+
+        LEVIATHAN_FORCE_INLINE void notify_apply(const state_type& state, const move_type& move)
+        {
+            apply_move(state, move.vessel, move.berth);
+        }
+
+        LEVIATHAN_FORCE_INLINE void notify_backtrack(const state_type& state, const undo_type& undo)
+        {
+            backtrack_move(state, undo.vessel, undo.berth);
+        }
+
+        /// @}
+
+        /// \brief Returns the total bytes allocated (capacity) by the bound.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_t allocated_memory_bytes() const noexcept
+        {
+            return (by_ready_.capacity() + by_opening_.capacity()) * sizeof(IndexType) +
+                (rank_.capacity() + next_.capacity() + previous_.capacity() + opening_rank_.capacity() +
+                    first_window_.capacity() + window_.capacity()) * sizeof(size_t) +
+                open_from_.capacity() * sizeof(TimeType) + remaining_work_.capacity() * sizeof(double) +
+                released_.capacity() * sizeof(std::pair<double, IndexType>) +
+                changes_.capacity() * sizeof(std::pair<TimeType, IndexType>);
+        }
+
+    private:
+        /// \brief The sentinel of the unassigned vessel list, whose other nodes are ranks in by_ready_.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_t head() const noexcept
+        {
+            return by_ready_.size();
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_t num_windows(const IndexType b_idx) const noexcept
+        {
+            return static_cast<size_t>(problem_->timeline(b_idx).end() - problem_->timeline(b_idx).begin());
+        }
+
+        /// \brief Returns true if the berth opens again after its free time.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool has_window(const IndexType b_idx) const noexcept
+        {
+            return first_window_[b_idx] < num_windows(b_idx);
+        }
+
+        /// \brief The berth order: by opening time, berths that never open again last, ties by index.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool opens_before(const IndexType a, const IndexType b) const noexcept
+        {
+            const bool a_opens = has_window(a);
+            const bool b_opens = has_window(b);
+            if (a_opens != b_opens)
+            {
+                return a_opens;
+            }
+            if (a_opens && open_from_[a] != open_from_[b])
+            {
+                return open_from_[a] < open_from_[b];
+            }
+            return a < b;
+        }
+
+        /// \brief Recomputes where a berth opens after its free time changed.
+        LEVIATHAN_FORCE_INLINE void refresh_berth(const state_type& state, const IndexType b_idx)
+        {
+            DCHECK_GE(b_idx, 0);
+            DCHECK_LT(static_cast<size_t>(b_idx), problem_->num_berths());
+            const auto& timeline = problem_->timeline(b_idx);
+            const TimeType free_time = state.berth_free_times[b_idx];
+            const auto it = std::lower_bound(timeline.begin(), timeline.end(), free_time);
+            first_window_[b_idx] = static_cast<size_t>(it - timeline.begin());
+            open_from_[b_idx] = it == timeline.end() ? free_time : std::max(it->start_inclusive, free_time);
+        }
+
+        /// \brief Refreshes a berth and moves it to its new place in by_opening_.
+        LEVIATHAN_FORCE_INLINE void update_berth(const state_type& state, const IndexType b_idx)
+        {
+            refresh_berth(state, b_idx);
+            size_t k = opening_rank_[b_idx];
+            while (k > 0 && opens_before(b_idx, by_opening_[k - 1]))
+            {
+                by_opening_[k] = by_opening_[k - 1];
+                opening_rank_[by_opening_[k]] = k;
+                --k;
+            }
+            while (k + 1 < by_opening_.size() && opens_before(by_opening_[k + 1], b_idx))
+            {
+                by_opening_[k] = by_opening_[k + 1];
+                opening_rank_[by_opening_[k]] = k;
+                ++k;
+            }
+            by_opening_[k] = b_idx;
+            opening_rank_[b_idx] = k;
+        }
+
+        /// \brief Opens a berth at its cached opening time and schedules the end of that window.
+        LEVIATHAN_FORCE_INLINE void open_berth(const IndexType b_idx, int& capacity)
+        {
+            window_[b_idx] = first_window_[b_idx];
+            const auto& window = *(problem_->timeline(b_idx).begin() + static_cast<std::ptrdiff_t>(window_[b_idx]));
+            ++capacity;
+            changes_.emplace_back(window.end_exclusive, b_idx);
+            std::ranges::push_heap(changes_, std::greater<>{});
+        }
+
+        /// \brief Makes a vessel available to the sweep.
+        LEVIATHAN_FORCE_INLINE void release(const IndexType v, double& total, size_t& pending)
+        {
+            const auto weight = static_cast<double>(problem_->weight(v));
+            const auto work = static_cast<double>(problem_->min_processing_time(v));
+            if (work > 0.0)
+            {
+                released_.emplace_back(weight / work, v);
+                std::ranges::push_heap(released_);
+                return;
+            }
+            // Without work the vessel is done at its ready time.
+            total += weight * static_cast<double>(problem_->ready_time(v));
+            --pending;
+        }
+
+        /// \brief Applies the change at the back of `changes_`: opens or closes its berth and schedules the next change.
+        LEVIATHAN_FORCE_INLINE void toggle_berth(int& capacity)
+        {
+            const auto [at, b] = changes_.back();
+            changes_.pop_back();
+            const auto& window = *(problem_->timeline(b).begin() + static_cast<std::ptrdiff_t>(window_[b]));
+            if (at < window.end_exclusive)
+            {
+                // Opening: the window stays open until its end.
+                ++capacity;
+                changes_.emplace_back(window.end_exclusive, b);
+                std::ranges::push_heap(changes_, std::greater<>{});
+                return;
+            }
+
+            --capacity;
+            if (++window_[b] < num_windows(b))
+            {
+                const auto& next = *(problem_->timeline(b).begin() + static_cast<std::ptrdiff_t>(window_[b]));
+                changes_.emplace_back(next.start_inclusive, b);
+                std::ranges::push_heap(changes_, std::greater<>{});
+            }
+        }
+
+        [[nodiscard]] static LEVIATHAN_FORCE_INLINE CostType to_cost(const double value) noexcept
+        {
+            if constexpr (std::floating_point<CostType>)
+            {
+                return static_cast<CostType>(value);
+            }
+            else
+            {
+                // Integral costs: any completion costs a whole number at least the relaxation value.
+                return static_cast<CostType>(std::ceil(value - 1e-9));
+            }
+        }
+
+        const problem_type* problem_;
+
+        // Vessels by ready time, the rank of every vessel in that order, and the doubly linked
+        // list of the unassigned ranks (head() is both ends).
+        std::vector<IndexType> by_ready_;
+        std::vector<size_t> rank_;
+        std::vector<size_t> next_;
+        std::vector<size_t> previous_;
+
+        // Per-berth cache: the first window that ends after the free time, and when the berth opens.
+        std::vector<size_t> first_window_;
+        std::vector<TimeType> open_from_;
+        // Berths sorted by opens_before(), and the position of every berth in that order.
+        std::vector<IndexType> by_opening_;
+        std::vector<size_t> opening_rank_;
+
+        // Scratch buffers of the sweep, allocated once.
+        std::vector<double> remaining_work_;
+        std::vector<std::pair<double, IndexType>> released_;
+        std::vector<std::pair<TimeType, IndexType>> changes_;
+        std::vector<size_t> window_;
+    };
+}
+
+#endif // LEVIATHAN_BNB_PREEMPTIVE_BOUND_H_
@@ -0,0 +1,85 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <benchmark/benchmark.h>
+#include <optional>
+#include <random>
+#include "leviathan/bnb/preemptive_bound.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/search_trail.h"
+#include "leviathan/bnb/test_util.h"
+
+// Measures the per-node cost of the preemptive bound on 8 berths for growing vessel counts:
+// one child visit (apply, bound, backtrack) against rebuilding the bound's orders from scratch.
+
+namespace
+{
+    using namespace leviathan::bnb::testing;
+    using State = leviathan::bnb::SearchState<Time, Index, Cost>;
+    using Bound = leviathan::bnb::PreemptiveBound<Time, Index, Cost>;
+    using Move = leviathan::bnb::SearchMove<Time, Index, Cost>;
+    using Undo = leviathan::bnb::SearchUndo<Time, Index, Cost>;
+    using Trail = leviathan::bnb::SearchTrail<Undo>;
+
+    void BM_PreemptiveBoundNode(benchmark::State& state)
+    {
+        const TestProblem problem = make_random_problem(7, static_cast<size_t>(state.range(0)), 8);
+        State node(problem.num_berths(), problem.num_vessels());
+        Bound bound(problem, node);
+        Trail trail;
+        std::mt19937 rng(3);
+        const std::optional<Move> move = random_move(problem, node, rng);
+
+        Cost value = 0.0;
+        for (auto _ : state)
+        {
+            leviathan::bnb::apply_decision(node, trail, *move);
+            bound.apply_move(node, move->vessel, move->berth);
+            value = bound.value(node);
+            benchmark::DoNotOptimize(value);
+            leviathan::bnb::backtrack_decision(node, trail, [&](const Undo& undo)
+            {
+                bound.backtrack_move(node, undo.vessel, undo.berth);
+            });
+        }
+
+        state.counters["bound"] = value;
+        state.counters["bytes"] = static_cast<double>(bound.allocated_memory_bytes());
+    }
+
+    void BM_PreemptiveBoundRebuild(benchmark::State& state)
+    {
+        const TestProblem problem = make_random_problem(7, static_cast<size_t>(state.range(0)), 8);
+        const State root(problem.num_berths(), problem.num_vessels());
+        Bound bound(problem, root);
+
+        for (auto _ : state)
+        {
+            bound.reset(root);
+            benchmark::DoNotOptimize(bound.value(root));
+        }
+    }
+}
+
+BENCHMARK(BM_PreemptiveBoundNode)->ArgName("vessels")->Arg(16)->Arg(128)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PreemptiveBoundRebuild)->ArgName("vessels")->Arg(16)->Arg(128)->Arg(1024)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,126 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+#include "leviathan/bnb/preemptive_bound.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/search_trail.h"
+#include "leviathan/bnb/test_util.h"
+
+using namespace leviathan::bnb::testing;
+
+namespace
+{
+    using State = leviathan::bnb::SearchState<Time, Index, Cost>;
+    using Bound = leviathan::bnb::PreemptiveBound<Time, Index, Cost>;
+    using Move = leviathan::bnb::SearchMove<Time, Index, Cost>;
+    using Trail = leviathan::bnb::SearchTrail<leviathan::bnb::SearchUndo<Time, Index, Cost>>;
+}
+
+TEST(PreemptiveBoundTest, QueueOnOneBerthIsExact)
+{
+    // Four identical vessels on one berth: 5 + 10 + 15 + 20 = 50.
+    const TestProblem problem({0, 0, 0, 0}, {1.0, 1.0, 1.0, 1.0}, {5, 5, 5, 5}, {{{0, 1000}}});
+    const State state(problem.num_berths(), problem.num_vessels());
+    Bound bound(problem, state);
+
+    EXPECT_DOUBLE_EQ(bound.value(state), 50.0);
+}
+
+TEST(PreemptiveBoundTest, ChargesClosedWindows)
+{
+    // The only berth is closed in [2, 10): a vessel of length 4 cannot finish before 12.
+    const std::vector<leviathan::bnb::AvailableWindow<Time>> windows = {{0, 2}, {10, 100}};
+    const TestProblem problem({0}, {1.0}, {4}, {leviathan::bnb::BerthTimeline<Time>(windows)});
+    const State state(problem.num_berths(), problem.num_vessels());
+    Bound bound(problem, state);
+
+    // Preemptively, 2 units are done in [0, 2) and 2 in [10, 12): mean busy time 6, plus 2.
+    EXPECT_DOUBLE_EQ(bound.value(state), 8.0);
+}
+
+TEST(PreemptiveBoundTest, ClosedBerthsMakeTheNodeInfeasible)
+{
+    const TestProblem problem({0, 0}, {1.0, 1.0}, {5, 5}, {{{0, 8}}});
+    State state(problem.num_berths(), problem.num_vessels());
+    state.apply_move(0, 0, 0, 5, problem.cost(0, 5));
+
+    Bound bound(problem, state);
+    EXPECT_EQ(bound.value(state), Bound::kInfeasible);
+    EXPECT_EQ(bound.lower_bound(state), Bound::kInfeasible);
+}
+
+TEST(PreemptiveBoundTest, BoundIsBelowCompletionOptimum)
+{
+    std::mt19937 rng(17);
+    for (uint32_t seed = 0; seed < 15; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 6, 2);
+        State state(problem.num_berths(), problem.num_vessels());
+        Bound bound(problem, state);
+
+        EXPECT_LE(bound.lower_bound(state), brute_force_optimum(problem) + 1e-9);
+        while (const std::optional<Move> move = random_move(problem, state, rng))
+        {
+            state.apply_move(move->vessel, move->berth, move->start_time, move->finish_time, move->cost_delta);
+            bound.apply_move(state, move->vessel, move->berth);
+            EXPECT_LE(bound.lower_bound(state), completion_optimum(problem, state) + 1e-9);
+        }
+    }
+}
+
+TEST(PreemptiveBoundTest, FollowingTheMovesMatchesRebuild)
+{
+    std::mt19937 rng(2);
+    const TestProblem problem = make_random_problem(9, 12, 4);
+    State state(problem.num_berths(), problem.num_vessels());
+    Bound bound(problem, state);
+
+    Trail trail;
+    std::vector<Cost> values = {bound.value(state)};
+    while (const std::optional<Move> move = random_move(problem, state, rng))
+    {
+        leviathan::bnb::apply_decision(state, trail, *move);
+        bound.apply_move(state, move->vessel, move->berth);
+        Bound fresh(problem, state);
+        EXPECT_DOUBLE_EQ(bound.value(state), fresh.value(state));
+        values.push_back(bound.value(state));
+    }
+
+    while (!trail.empty())
+    {
+        values.pop_back();
+        leviathan::bnb::backtrack_decision(state, trail, [&](const leviathan::bnb::SearchUndo<Time, Index, Cost>& undo)
+        {
+            bound.backtrack_move(state, undo.vessel, undo.berth);
+        });
+        Bound fresh(problem, state);
+        EXPECT_DOUBLE_EQ(bound.value(state), fresh.value(state));
+        EXPECT_DOUBLE_EQ(bound.value(state), values.back());
+    }
+}
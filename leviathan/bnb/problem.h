@@ -0,0 +1,194 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_PROBLEM_H_
+#define LEVIATHAN_BNB_PROBLEM_H_
+
+#include <algorithm>
+#include <vector>
+#include <span>
+#include <utility>
+#include <concepts>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+#include "leviathan/bnb/berth_timeline.h"
+
+namespace leviathan::bnb
+{
+    /// \brief Immutable description of a Berth Allocation Problem instance.
+    ///
+    /// Vessels become ready at their ready time and occupy a berth for a berth-dependent
+    /// processing time. Every berth is only available inside the windows of its BerthTimeline.
+    /// The objective is the weighted flow time, i.e. the sum of weight * (finish - ready).
+    ///
+    /// Processing times are stored row-major (vessel-major) in a single flat vector,
+    /// so that all berth alternatives of a vessel are contiguous in memory.
+    template <typename TimeType, typename IndexType, typename CostType>
+        requires std::integral<TimeType> && std::is_signed_v<TimeType> &&
+        std::integral<IndexType> && std::is_signed_v<IndexType> &&
+        std::is_arithmetic_v<CostType>
+    class Problem
+    {
+    public:
+        using time_type = TimeType;
+        using index_type = IndexType;
+        using cost_type = CostType;
+        using timeline_type = BerthTimeline<TimeType>;
+
+        Problem() = default;
+
+        /// \brief Constructs a problem instance.
+        ///
+        /// \param ready_times The ready (arrival) time of each vessel.
+        /// \param weights The cost weight of each vessel.
+        /// \param processing_times The flat vessel-major matrix of processing times (vessels x berths).
+        /// \param timelines The availability timeline of each berth.
+        LEVIATHAN_FORCE_INLINE Problem(std::vector<TimeType> ready_times,
+                                       std::vector<CostType> weights,
+                                       std::vector<TimeType> processing_times,
+                                       std::vector<timeline_type> timelines)
+            : ready_times_(std::move(ready_times)),
+              weights_(std::move(weights)),
+              processing_times_(std::move(processing_times)),
+              timelines_(std::move(timelines)),
+              min_processing_times_(ready_times_.size(), 0)
+        {
+            DCHECK_EQ(ready_times_.size(), weights_.size());
+            DCHECK_EQ(processing_times_.size(), ready_times_.size() * timelines_.size());
+
+            if (!timelines_.empty())
+            {
+                for (size_t v = 0; v < ready_times_.size(); ++v)
+                {
+                    min_processing_times_[v] = std::ranges::min(processing_times_row(static_cast<IndexType>(v)));
+                }
+            }
+        }
+
+        /// \brief Returns the number of berths.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_t num_berths() const noexcept
+        {
+            return timelines_.size();
+        }
+
+        /// \brief Returns the number of vessels.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_t num_vessels() const noexcept
+        {
+            return ready_times_.size();
+        }
+
+        /// \brief Returns the ready time of a vessel.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE TimeType ready_time(const IndexType v_idx) const
+        {
+            DCHECK_GE(v_idx, 0);
+            DCHECK_LT(static_cast<size_t>(v_idx), num_vessels());
+            return ready_times_[v_idx];
+        }
+
+        /// \brief Returns the cost weight of a vessel.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType weight(const IndexType v_idx) const
+        {
+            DCHECK_GE(v_idx, 0);
+            DCHECK_LT(static_cast<size_t>(v_idx), num_vessels());
+            return weights_[v_idx];
+        }
+
+        /// \brief Returns the processing time of a vessel on a berth.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE TimeType processing_time(const IndexType v_idx,
+                                                                      const IndexType b_idx) const
+        {
+            DCHECK_GE(b_idx, 0);
+            DCHECK_LT(static_cast<size_t>(b_idx), num_berths());
+            return processing_times_row(v_idx)[b_idx];
+        }
+
+        /// \brief Returns the processing times of a vessel on all berths.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const TimeType> processing_times_row(
+            const IndexType v_idx) const
+        {
+            DCHECK_GE(v_idx, 0);
+            DCHECK_LT(static_cast<size_t>(v_idx), num_vessels());
+            const size_t berths = num_berths();
+            return std::span<const TimeType>(processing_times_.data() + static_cast<size_t>(v_idx) * berths, berths);
+        }
+
+        /// \brief Returns the shortest processing time of a vessel over all berths.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE TimeType min_processing_time(const IndexType v_idx) const
+        {
+            DCHECK_GE(v_idx, 0);
+            DCHECK_LT(static_cast<size_t>(v_idx), num_vessels());
+            return min_processing_times_[v_idx];
+        }
+
+        /// \brief Returns the availability timeline of a berth.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const timeline_type& timeline(const IndexType b_idx) const
+        {
+            DCHECK_GE(b_idx, 0);
+            DCHECK_LT(static_cast<size_t>(b_idx), num_berths());
+            return timelines_[b_idx];
+        }
+
+        /// \brief Returns the cost of serving a vessel that finishes at the given time.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType cost(const IndexType v_idx, const TimeType finish_time) const
+        {
+            return weight(v_idx) * static_cast<CostType>(finish_time - ready_time(v_idx));
+        }
+
+        /// \name Raw Data Access
+        /// @{
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const TimeType> ready_times() const noexcept
+        {
+            return ready_times_;
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const CostType> weights() const noexcept
+        {
+            return weights_;
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const TimeType> processing_times() const noexcept
+        {
+            return processing_times_;
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const TimeType> min_processing_times() const noexcept
+        {
+            return min_processing_times_;
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const timeline_type> timelines() const noexcept
+        {
+            return timelines_;
+        }
+
+        /// @}
+
+    private:
+        std::vector<TimeType> ready_times_;
+        std::vector<CostType> weights_;
+        std::vector<TimeType> processing_times_;
+        std::vector<timeline_type> timelines_;
+        std::vector<TimeType> min_processing_times_;
+    };
+}
+
+#endif // LEVIATHAN_BNB_PROBLEM_H_
@@ -0,0 +1,74 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "leviathan/bnb/problem.h"
+
+using Time = int64_t;
+using Index = int32_t;
+using Cost = double;
+using TestProblem = leviathan::bnb::Problem<Time, Index, Cost>;
+using Timeline = leviathan::bnb::BerthTimeline<Time>;
+
+TEST(ProblemTest, Dimensions)
+{
+    const TestProblem problem({0, 5, 10}, {1.0, 2.0, 3.0}, {1, 2, 3, 4, 5, 6}, {Timeline(0, 100), Timeline(0, 50)});
+
+    EXPECT_EQ(problem.num_vessels(), 3);
+    EXPECT_EQ(problem.num_berths(), 2);
+}
+
+TEST(ProblemTest, VesselMajorProcessingTimes)
+{
+    const TestProblem problem({0, 5, 10}, {1.0, 2.0, 3.0}, {1, 2, 3, 4, 5, 6}, {Timeline(0, 100), Timeline(0, 50)});
+
+    EXPECT_EQ(problem.processing_time(0, 0), 1);
+    EXPECT_EQ(problem.processing_time(0, 1), 2);
+    EXPECT_EQ(problem.processing_time(2, 0), 5);
+    EXPECT_EQ(problem.processing_time(2, 1), 6);
+
+    const auto row = problem.processing_times_row(1);
+    ASSERT_EQ(row.size(), 2);
+    EXPECT_EQ(row[0], 3);
+    EXPECT_EQ(row[1], 4);
+}
+
+TEST(ProblemTest, WeightedFlowTimeCost)
+{
+    const TestProblem problem({0, 5, 10}, {1.0, 2.0, 3.0}, {1, 2, 3, 4, 5, 6}, {Timeline(0, 100), Timeline(0, 50)});
+
+    // Vessel 1 is ready at 5 with weight 2: finishing at 12 costs 2 * 7.
+    EXPECT_EQ(problem.cost(1, 12), 14.0);
+    EXPECT_EQ(problem.ready_time(2), 10);
+    EXPECT_EQ(problem.weight(2), 3.0);
+    EXPECT_EQ(problem.timeline(1).begin()->end_exclusive, 50);
+}
+
+TEST(ProblemTest, MinProcessingTimes)
+{
+    const TestProblem problem({0, 5, 10}, {1.0, 2.0, 3.0}, {4, 2, 3, 9, 5, 5}, {Timeline(0, 100), Timeline(0, 50)});
+
+    EXPECT_EQ(problem.min_processing_time(0), 2);
+    EXPECT_EQ(problem.min_processing_time(1), 3);
+    EXPECT_EQ(problem.min_processing_time(2), 5);
+    EXPECT_EQ(problem.min_processing_times().size(), 3);
+}
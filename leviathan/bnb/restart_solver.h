@@ -0,0 +1,428 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_RESTART_SOLVER_H_
+#define LEVIATHAN_BNB_RESTART_SOLVER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_stack.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/search_statistics.h"
+#include "leviathan/bnb/search_trail.h"
+#include "leviathan/bnb/shared_incumbent.h"
+
+namespace leviathan::bnb
+{
+    /// \brief The growth of the per-run node limit of a RestartSolver.
+    enum class RestartSchedule
+    {
+        /// base * luby(i): 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, ...
+        kLuby,
+        /// base * factor^i.
+        kGeometric,
+    };
+
+    /// \brief Returns the i-th element (0-based) of the Luby sequence 1, 1, 2, 1, 1, 2, 4, ...
+    [[nodiscard]] constexpr std::uint64_t luby(std::uint64_t i) noexcept
+    {
+        // Find the smallest complete block 2^k - 1 that contains position i + 1, then recurse
+        // into the repeated prefix until i + 1 is the last element of a block.
+        std::uint64_t size = 1;
+        std::uint64_t power = 1;
+        while (size < i + 1)
+        {
+            size = 2 * size + 1;
+            power *= 2;
+        }
+        while (size - 1 != i)
+        {
+            size = (size - 1) / 2;
+            power /= 2;
+            i %= size;
+        }
+        return power;
+    }
+
+    /// \brief Tuning knobs of the RestartSolver.
+    struct RestartSolverOptions
+    {
+        /// How the node limit of a run grows from restart to restart.
+        RestartSchedule schedule = RestartSchedule::kLuby;
+        /// Node limit of the first run (and the unit of the Luby schedule).
+        std::uint64_t base_nodes = 1024;
+        /// Growth factor of the geometric schedule.
+        double geometric_factor = 1.5;
+        /// Children whose bounds differ from the best of their group by at most this fraction of
+        /// its magnitude count as ties and are visited in random order.
+        double tie_tolerance = 0.0;
+        /// Seed of the tie-breaking generator.
+        std::uint64_t seed = 0;
+        /// Maximum number of nodes to enter, summed over all runs, before the search stops.
+        std::uint64_t node_limit = std::numeric_limits<std::uint64_t>::max();
+        /// Reserve the stack for the deepest possible run (max_dive_entries()) instead of at most
+        /// kDiveReserveCap moves. Capacity gained by one run is kept by all later runs either way.
+        bool reserve_max_dive = false;
+    };
+
+    /// \brief Depth-first branch-and-bound with randomized tie-breaking and restarts.
+    ///
+    /// The search is split into runs whose node limits follow a Luby or geometric schedule.
+    /// Within a run it is the DepthFirstSolver loop, except that after the brancher has filled a
+    /// frame, children with (near-)equal bounds are shuffled, so that every run dives into a
+    /// different part of the tree. When a run hits its limit the state is reset to the root by
+    /// copy-assignment, the stack and the trail are emptied with clear(), which keeps their
+    /// capacity, and the next run starts. The incumbent survives restarts and prunes every
+    /// later run.
+    ///
+    /// The first run that exhausts its tree ends the search with a proof, just like an
+    /// uninterrupted depth-first search. Since the node limits grow without bound, this is
+    /// guaranteed to happen eventually.
+    ///
+    /// \tparam BrancherType The branching rule, see the Brancher concept.
+    template <typename TimeType, typename IndexType, typename CostType, typename BrancherType>
+        requires Brancher<BrancherType, TimeType, IndexType, CostType>
+    class RestartSolver
+    {
+    public:
+        using state_type = SearchState<TimeType, IndexType, CostType>;
+        using move_type = SearchMove<TimeType, IndexType, CostType>;
+        using undo_type = SearchUndo<TimeType, IndexType, CostType>;
+        using stack_type = SearchStack<move_type>;
+        using trail_type = SearchTrail<undo_type>;
+        using incumbent_type = SharedIncumbent<TimeType, IndexType, CostType>;
+        using size_type = std::size_t;
+
+        static constexpr CostType kNoSolution = incumbent_type::kNoSolution;
+
+        /// \brief Constructs a solver for an instance of the given size.
+        ///
+        /// \param num_berths The number of berths of the instance.
+        /// \param num_vessels The number of vessels of the instance.
+        /// \param brancher The branching rule used to expand nodes.
+        /// \param options The restart schedule, tie-breaking and search limits.
+        RestartSolver(const size_type num_berths, const size_type num_vessels, BrancherType brancher,
+                      const RestartSolverOptions options = {})
+            : root_(num_berths, num_vessels),
+              state_(num_berths, num_vessels),
+              brancher_(std::move(brancher)),
+              options_(options),
+              owned_incumbent_(num_vessels),
+              best_assignments_(num_vessels, state_type::kUnassignedVessel),
+              best_start_times_(num_vessels, 0)
+        {
+            DCHECK_GT(options_.base_nodes, 0u);
+            DCHECK_GE(options_.geometric_factor, 1.0);
+            stack_.reserve(dive_reserve_entries(num_berths, num_vessels, options_.reserve_max_dive),
+                           num_vessels + 1);
+            trail_.reserve(num_vessels, num_vessels);
+        }
+
+        /// \brief Returns the root state. May be modified before solve() (e.g. initial berth free times).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE state_type& state() noexcept
+        {
+            return root_;
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const state_type& state() const noexcept
+        {
+            return root_;
+        }
+
+        /// \brief Resets the incumbent to an upper bound; only strictly better solutions will be reported.
+        ///
+        /// Must not be called while another solver searches with the same incumbent.
+        LEVIATHAN_FORCE_INLINE void set_upper_bound(const CostType upper_bound) noexcept
+        {
+            incumbent_->reset(upper_bound);
+            has_solution_ = false;
+        }
+
+        /// \brief Prunes against and publishes to an external incumbent instead of the owned one.
+        ///
+        /// \param incumbent The shared incumbent. Must outlive the solver.
+        LEVIATHAN_FORCE_INLINE void attach_incumbent(incumbent_type& incumbent) noexcept
+        {
+            incumbent_ = &incumbent;
+        }
+
+        /// \brief Returns the incumbent the solver prunes against.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE incumbent_type& incumbent() noexcept
+        {
+            return *incumbent_;
+        }
+
+        /// \brief Makes the search stop (as if a limit was hit) once `flag` becomes true.
+        ///
+        /// \param flag The stop flag, usually raised by another thread. Must outlive the solver.
+        LEVIATHAN_FORCE_INLINE void attach_stop_flag(const std::atomic<bool>& flag) noexcept
+        {
+            stop_flag_ = &flag;
+        }
+
+        /// \brief Runs restarts until one run exhausts its tree or the global limits are hit.
+        SearchStatus solve()
+        {
+            statistics_ = {};
+            restarts_ = 0;
+            rng_.seed(options_.seed);
+            root_unassigned_ = static_cast<size_type>(root_.num_unassigned());
+
+            for (std::uint64_t run = 0;; ++run)
+            {
+                const std::uint64_t run_limit = run_node_limit(run);
+                const std::uint64_t budget = options_.node_limit - statistics_.nodes;
+                const RunResult result = search(std::min(run_limit, budget), run_limit >= budget);
+                switch (result)
+                {
+                case RunResult::kExhausted:
+                    return finish(true);
+                case RunResult::kStopped:
+                    return finish(false);
+                case RunResult::kRestart:
+                    ++restarts_;
+                    break;
+                }
+            }
+        }
+
+        /// \brief Returns the node limit of run `run` (0-based) under the configured schedule.
+        [[nodiscard]] std::uint64_t run_node_limit(const std::uint64_t run) const noexcept
+        {
+            constexpr auto kMax = std::numeric_limits<std::uint64_t>::max();
+            if (options_.schedule == RestartSchedule::kLuby)
+            {
+                const std::uint64_t factor = luby(run);
+                return factor > kMax / options_.base_nodes ? kMax : factor * options_.base_nodes;
+            }
+            const double limit = static_cast<double>(options_.base_nodes) *
+                std::pow(options_.geometric_factor, static_cast<double>(run));
+            return limit >= static_cast<double>(kMax) ? kMax : static_cast<std::uint64_t>(limit);
+        }
+
+        /// \brief Returns the number of restarts performed by the last solve() call.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::uint64_t restarts() const noexcept
+        {
+            return restarts_;
+        }
+
+        /// \brief Returns true if this solver has found a solution.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool has_solution() const noexcept
+        {
+            return has_solution_;
+        }
+
+        /// \brief Returns the objective of the incumbent (or the upper bound if none was found).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType best_objective() const noexcept
+        {
+            return incumbent_->objective();
+        }
+
+        /// \brief Returns the berth of every vessel in the best solution found by this solver.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const IndexType> best_assignments() const noexcept
+        {
+            return best_assignments_;
+        }
+
+        /// \brief Returns the start time of every vessel in the best solution found by this solver.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const TimeType> best_start_times() const noexcept
+        {
+            return best_start_times_;
+        }
+
+        /// \brief Returns the counters of the last solve() call, summed over all runs.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const SearchStatistics& statistics() const noexcept
+        {
+            return statistics_;
+        }
+
+        /// \brief Returns the total bytes allocated by the stack and the trail.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type allocated_memory_bytes() const noexcept
+        {
+            return stack_.allocated_memory_bytes() + trail_.allocated_memory_bytes();
+        }
+
+    private:
+        /// \brief How a single run ended.
+        enum class RunResult
+        {
+            /// The run's tree was exhausted; the incumbent is proven.
+            kExhausted,
+            /// The run hit its own node limit.
+            kRestart,
+            /// The global node limit or the stop flag ended the search.
+            kStopped,
+        };
+
+        /// \brief Runs one depth-first search from the root with the given node limit.
+        ///
+        /// \param limit The number of nodes this run may enter.
+        /// \param final True if hitting `limit` exhausts the global node limit.
+        RunResult search(const std::uint64_t limit, const bool final)
+        {
+            state_ = root_;
+            stack_.clear();
+            trail_.clear();
+
+            if (root_unassigned_ == 0)
+            {
+                record_solution();
+                return RunResult::kExhausted;
+            }
+
+            std::uint64_t nodes = 0;
+            expand();
+            while (!stack_.empty())
+            {
+                if (stack_.current_frame_size() == 0)
+                {
+                    stack_.pop_frame();
+                    if (!trail_.empty())
+                    {
+                        backtrack_decision(state_, trail_);
+                    }
+                    continue;
+                }
+
+                const move_type move = stack_.top();
+                stack_.pop_entry();
+
+                if (move.lower_bound >= incumbent_->objective())
+                {
+                    ++statistics_.pruned;
+                    continue;
+                }
+
+                if (LEVIATHAN_UNLIKELY(stop_flag_->load(std::memory_order_relaxed)))
+                {
+                    return RunResult::kStopped;
+                }
+                if (LEVIATHAN_UNLIKELY(nodes >= limit))
+                {
+                    return final ? RunResult::kStopped : RunResult::kRestart;
+                }
+
+                apply_decision(state_, trail_, move);
+                ++nodes;
+                ++statistics_.nodes;
+                statistics_.max_depth = std::max<std::uint64_t>(statistics_.max_depth, trail_.depth());
+
+                if (trail_.depth() == root_unassigned_)
+                {
+                    record_solution();
+                    backtrack_decision(state_, trail_);
+                    continue;
+                }
+
+                expand();
+            }
+            return RunResult::kExhausted;
+        }
+
+        /// \brief Generates the children of the current state into a new frame.
+        ///
+        /// Runs of children whose bounds tie (within the tolerance) are shuffled before the frame
+        /// is reversed so that the preferred child sits on top of the stack.
+        LEVIATHAN_FORCE_INLINE void expand()
+        {
+            stack_.fill_frame([this](stack_type& stack)
+            {
+                brancher_.branch(state_, stack);
+            });
+
+            const std::span<move_type> children = stack_.current_frame_entries();
+            size_type first = 0;
+            while (first < children.size())
+            {
+                const CostType bound = children[first].lower_bound;
+                const double window = options_.tie_tolerance * std::abs(static_cast<double>(bound));
+                size_type last = first + 1;
+                while (last < children.size() &&
+                    static_cast<double>(children[last].lower_bound - bound) <= window)
+                {
+                    ++last;
+                }
+                if (last - first > 1)
+                {
+                    std::shuffle(children.begin() + first, children.begin() + last, rng_);
+                }
+                first = last;
+            }
+            std::ranges::reverse(children);
+        }
+
+        LEVIATHAN_FORCE_INLINE void record_solution()
+        {
+            if (!incumbent_->try_improve(state_))
+            {
+                return;
+            }
+            std::ranges::copy(state_.vessel_assignments, best_assignments_.begin());
+            std::ranges::copy(state_.vessel_start_times, best_start_times_.begin());
+            has_solution_ = true;
+            ++statistics_.solutions;
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE SearchStatus finish(const bool exhausted) noexcept
+        {
+            state_ = root_;
+            stack_.clear();
+            trail_.clear();
+            const bool has_incumbent = incumbent_->has_solution();
+            if (exhausted)
+            {
+                return has_incumbent ? SearchStatus::kOptimal : SearchStatus::kInfeasible;
+            }
+            return has_incumbent ? SearchStatus::kFeasible : SearchStatus::kLimitReached;
+        }
+
+        state_type root_;
+        state_type state_;
+        stack_type stack_;
+        trail_type trail_;
+        BrancherType brancher_;
+        RestartSolverOptions options_;
+        SearchStatistics statistics_;
+        std::mt19937_64 rng_;
+        size_type root_unassigned_ = 0;
+        std::uint64_t restarts_ = 0;
+
+        incumbent_type owned_incumbent_;
+        incumbent_type* incumbent_ = &owned_incumbent_;
+        std::atomic<bool> never_stop_{false};
+        const std::atomic<bool>* stop_flag_ = &never_stop_;
+        bool has_solution_ = false;
+        std::vector<IndexType> best_assignments_;
+        std::vector<TimeType> best_start_times_;
+    };
+}
+
+#endif // LEVIATHAN_BNB_RESTART_SOLVER_H_
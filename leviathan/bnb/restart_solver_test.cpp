@@ -0,0 +1,116 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <iterator>
+#include "leviathan/bnb/assignment_brancher.h"
+#include "leviathan/bnb/restart_solver.h"
+#include "leviathan/bnb/test_util.h"
+
+using namespace leviathan::bnb::testing;
+using Brancher = leviathan::bnb::AssignmentBrancher<Time, Index, Cost>;
+using Solver = leviathan::bnb::RestartSolver<Time, Index, Cost, Brancher>;
+using leviathan::bnb::RestartSchedule;
+using leviathan::bnb::SearchStatus;
+
+TEST(RestartSolverTest, LubySequence)
+{
+    constexpr uint64_t expected[] = {1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, 1};
+    for (uint64_t i = 0; i < std::size(expected); ++i)
+    {
+        EXPECT_EQ(leviathan::bnb::luby(i), expected[i]) << "i " << i;
+    }
+    static_assert(leviathan::bnb::luby(30) == 16);
+}
+
+TEST(RestartSolverTest, RunNodeLimits)
+{
+    const TestProblem problem = make_random_problem(0, 4, 2);
+    const Solver luby(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.base_nodes = 100});
+    EXPECT_EQ(luby.run_node_limit(0), 100u);
+    EXPECT_EQ(luby.run_node_limit(2), 200u);
+    EXPECT_EQ(luby.run_node_limit(6), 400u);
+
+    const Solver geometric(problem.num_berths(), problem.num_vessels(), Brancher(problem),
+                           {.schedule = RestartSchedule::kGeometric, .base_nodes = 100, .geometric_factor = 2.0});
+    EXPECT_EQ(geometric.run_node_limit(0), 100u);
+    EXPECT_EQ(geometric.run_node_limit(3), 800u);
+    EXPECT_EQ(geometric.run_node_limit(200), UINT64_MAX);
+}
+
+TEST(RestartSolverTest, MatchesBruteForceWithManyRestarts)
+{
+    for (uint32_t seed = 0; seed < 10; ++seed)
+    {
+        const TestProblem problem = make_random_problem(seed, 6, 2);
+        for (const RestartSchedule schedule : {RestartSchedule::kLuby, RestartSchedule::kGeometric})
+        {
+            Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem),
+                          {.schedule = schedule, .base_nodes = 8, .tie_tolerance = 0.1, .seed = seed});
+
+            ASSERT_EQ(solver.solve(), SearchStatus::kOptimal) << "seed " << seed;
+            EXPECT_DOUBLE_EQ(solver.best_objective(), brute_force_optimum(problem)) << "seed " << seed;
+            EXPECT_DOUBLE_EQ(evaluate_schedule(problem, solver.best_assignments(), solver.best_start_times()),
+                             solver.best_objective()) << "seed " << seed;
+            EXPECT_GT(solver.restarts(), 0u) << "seed " << seed;
+        }
+    }
+}
+
+TEST(RestartSolverTest, SameSeedIsReproducible)
+{
+    const TestProblem problem = make_random_problem(42, 8, 3);
+    const leviathan::bnb::RestartSolverOptions options = {.base_nodes = 64, .tie_tolerance = 0.2, .seed = 7};
+    Solver first(problem.num_berths(), problem.num_vessels(), Brancher(problem), options);
+    Solver second(problem.num_berths(), problem.num_vessels(), Brancher(problem), options);
+
+    ASSERT_EQ(first.solve(), SearchStatus::kOptimal);
+    ASSERT_EQ(second.solve(), SearchStatus::kOptimal);
+    EXPECT_EQ(first.statistics().nodes, second.statistics().nodes);
+    EXPECT_EQ(first.restarts(), second.restarts());
+}
+
+TEST(RestartSolverTest, RestartsKeepCapacity)
+{
+    const TestProblem problem = make_random_problem(5, 7, 3);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem), {.base_nodes = 16});
+
+    ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+    ASSERT_GT(solver.restarts(), 0u);
+    const size_t bytes = solver.allocated_memory_bytes();
+
+    solver.set_upper_bound(Solver::kNoSolution);
+    ASSERT_EQ(solver.solve(), SearchStatus::kOptimal);
+    EXPECT_EQ(solver.allocated_memory_bytes(), bytes);
+}
+
+TEST(RestartSolverTest, NodeLimitStops)
+{
+    const TestProblem problem = make_random_problem(3, 8, 3);
+    Solver solver(problem.num_berths(), problem.num_vessels(), Brancher(problem),
+                  {.base_nodes = 16, .node_limit = 100});
+
+    const SearchStatus status = solver.solve();
+    EXPECT_TRUE(status == SearchStatus::kFeasible || status == SearchStatus::kLimitReached);
+    EXPECT_EQ(solver.statistics().nodes, 100u);
+    EXPECT_EQ(solver.state().current_objective, 0.0);
+}
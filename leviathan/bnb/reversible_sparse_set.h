@@ -0,0 +1,151 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef LEVIATHAN_BNB_REVERSIBLE_SPARSE_SET_H_
+#define LEVIATHAN_BNB_REVERSIBLE_SPARSE_SET_H_
+
+#include <cstddef>
+#include <concepts>
+#include <span>
+#include <vector>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+
+namespace leviathan::bnb
+{
+    /// \brief A subset of {0, ..., n-1} with O(1) remove and restore.
+    ///
+    /// The members are the first size() entries of a dense permutation of the universe, and a
+    /// position array maps every value to its slot. remove() swaps a value to the end of the
+    /// member prefix and shrinks it; restore() swaps it back to the boundary and grows it.
+    /// When removals are undone in reverse order, the restored value already sits at the
+    /// boundary and restore() only moves the boundary, so the set needs no undo log of its
+    /// own. Only membership is restored; the order inside the prefix may differ.
+    ///
+    /// Iterating the members touches exactly size() contiguous values, in no particular order.
+    ///
+    /// \tparam IndexType The integral value type.
+    template <std::integral IndexType>
+    class ReversibleSparseSet
+    {
+    public:
+        using value_type = IndexType;
+        using size_type = std::size_t;
+        using const_iterator = typename std::vector<IndexType>::const_iterator;
+
+        ReversibleSparseSet() = default;
+
+        /// \brief Creates a set containing every value in {0, ..., universe-1}.
+        explicit ReversibleSparseSet(const size_type universe)
+            : dense_(universe),
+              position_(universe),
+              size_(universe)
+        {
+            for (size_type i = 0; i < universe; ++i)
+            {
+                dense_[i] = static_cast<IndexType>(i);
+                position_[i] = i;
+            }
+        }
+
+        /// \brief Returns the number of members.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type size() const noexcept
+        {
+            return size_;
+        }
+
+        /// \brief Returns true if the set has no members.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        /// \brief Returns the size of the universe the set was created with.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type universe() const noexcept
+        {
+            return dense_.size();
+        }
+
+        /// \brief Returns true if `value` is a member.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool contains(const IndexType value) const noexcept
+        {
+            DCHECK_GE(value, 0);
+            DCHECK_LT(static_cast<size_type>(value), universe());
+            return position_[value] < size_;
+        }
+
+        /// \brief Removes a member by swapping it to the end of the member prefix.
+        LEVIATHAN_FORCE_INLINE void remove(const IndexType value) noexcept
+        {
+            DCHECK(contains(value));
+            swap_slots(position_[value], --size_);
+        }
+
+        /// \brief Restores a removed value by swapping it to the boundary of the member prefix.
+        ///
+        /// In reverse order of removal the value already sits at the boundary and the swap is a no-op.
+        LEVIATHAN_FORCE_INLINE void restore(const IndexType value) noexcept
+        {
+            DCHECK(!contains(value));
+            swap_slots(position_[value], size_++);
+        }
+
+        /// \brief Makes every value of the universe a member again.
+        LEVIATHAN_FORCE_INLINE void reset() noexcept
+        {
+            size_ = dense_.size();
+        }
+
+        /// \brief Returns the members as a contiguous span.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const IndexType> values() const noexcept
+        {
+            return {dense_.data(), size_};
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const_iterator begin() const noexcept
+        {
+            return dense_.begin();
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const_iterator end() const noexcept
+        {
+            return dense_.begin() + static_cast<std::ptrdiff_t>(size_);
+        }
+
+    private:
+        LEVIATHAN_FORCE_INLINE void swap_slots(const size_type a, const size_type b) noexcept
+        {
+            const IndexType value_a = dense_[a];
+            const IndexType value_b = dense_[b];
+            dense_[a] = value_b;
+            dense_[b] = value_a;
+            position_[value_b] = a;
+            position_[value_a] = b;
+        }
+
+        std::vector<IndexType> dense_;
+        std::vector<size_type> position_;
+        size_type size_ = 0;
+    };
+}
+
+#endif // LEVIATHAN_BNB_REVERSIBLE_SPARSE_SET_H_
@@ -0,0 +1,116 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "leviathan/bnb/reversible_sparse_set.h"
+
+using Set = leviathan::bnb::ReversibleSparseSet<int32_t>;
+
+namespace
+{
+    std::vector<int32_t> sorted_values(const Set& set)
+    {
+        std::vector<int32_t> values(set.begin(), set.end());
+        std::ranges::sort(values);
+        return values;
+    }
+}
+
+TEST(ReversibleSparseSetTest, StartsFull)
+{
+    const Set set(5);
+    EXPECT_EQ(set.size(), 5u);
+    EXPECT_EQ(set.universe(), 5u);
+    EXPECT_FALSE(set.empty());
+    EXPECT_EQ(sorted_values(set), (std::vector<int32_t>{0, 1, 2, 3, 4}));
+    EXPECT_TRUE(Set().empty());
+}
+
+TEST(ReversibleSparseSetTest, RestoreInReverseOrderOnlyMovesTheBoundary)
+{
+    Set set(6);
+    set.remove(2);
+    set.remove(0);
+    const std::vector<int32_t> before = sorted_values(set);
+
+    set.remove(5);
+    set.remove(3);
+    EXPECT_EQ(sorted_values(set), (std::vector<int32_t>{1, 4}));
+    EXPECT_FALSE(set.contains(3));
+    EXPECT_TRUE(set.contains(4));
+
+    // The most recently removed value sits right past the members.
+    EXPECT_EQ(*set.end(), 3);
+    set.restore(3);
+    EXPECT_EQ(set.values().back(), 3);
+    set.restore(5);
+    EXPECT_EQ(set.values().back(), 5);
+    EXPECT_EQ(sorted_values(set), before);
+}
+
+TEST(ReversibleSparseSetTest, RestoreInAnyOrder)
+{
+    std::mt19937 rng(3);
+    Set set(100);
+    std::vector<bool> member(100, true);
+    for (int step = 0; step < 2000; ++step)
+    {
+        const auto v = static_cast<int32_t>(rng() % 100);
+        if (member[v])
+        {
+            set.remove(v);
+        }
+        else
+        {
+            set.restore(v);
+        }
+        member[v] = !member[v];
+    }
+
+    std::vector<int32_t> expected;
+    for (int32_t v = 0; v < 100; ++v)
+    {
+        EXPECT_EQ(set.contains(v), member[v]);
+        if (member[v])
+        {
+            expected.push_back(v);
+        }
+    }
+    EXPECT_EQ(sorted_values(set), expected);
+
+    set.reset();
+    EXPECT_EQ(set.size(), 100u);
+}
+
+#ifndef NDEBUG
+TEST(ReversibleSparseSetDeathTest, RemoveTwice)
+{
+    Set set(3);
+    set.remove(1);
+    EXPECT_DEATH(set.remove(1), "");
+    EXPECT_DEATH(set.restore(0), "");
+}
+#endif
@@ -0,0 +1,122 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_SEARCH_MOVE_H_
+#define LEVIATHAN_BNB_SEARCH_MOVE_H_
+
+#include <concepts>
+#include "leviathan/base/config.h"
+#include "leviathan/bnb/search_stack.h"
+#include "leviathan/bnb/search_state.h"
+#include "leviathan/bnb/search_trail.h"
+
+namespace leviathan::bnb
+{
+    /// \brief A single branching decision: assign a vessel to a berth at a fixed start time.
+    ///
+    /// Moves are the entries of the SearchStack. Besides the data needed by
+    /// SearchState::apply_move, every move carries a lower bound on the objective
+    /// of any schedule completed below it, so that it can be pruned without being applied.
+    template <typename TimeType, typename IndexType, typename CostType>
+    struct SearchMove
+    {
+        IndexType vessel;
+        IndexType berth;
+        TimeType start_time;
+        TimeType finish_time;
+        CostType cost_delta;
+        CostType lower_bound;
+    };
+
+    /// \brief The restoration entry recorded on the SearchTrail for every applied move.
+    ///
+    /// Mirrors the parameters of SearchState::backtrack_move.
+    template <typename TimeType, typename IndexType, typename CostType>
+    struct SearchUndo
+    {
+        IndexType vessel;
+        IndexType berth;
+        TimeType old_berth_free_time;
+        CostType old_objective;
+        IndexType old_last_vessel;
+    };
+
+    /// \brief A branching rule that generates the children of a search node.
+    ///
+    /// The brancher appends the children of `state` to the current (already pushed) frame
+    /// of the stack, in preference order: the first entry is the child explored first.
+    ///
+    /// \tparam StateType The state the brancher reads, SearchState or FixedSearchState.
+    template <typename B, typename TimeType, typename IndexType, typename CostType,
+              typename StateType = SearchState<TimeType, IndexType, CostType>>
+    concept Brancher = requires(B& brancher,
+                                const StateType& state,
+                                SearchStack<SearchMove<TimeType, IndexType, CostType>>& stack)
+    {
+        brancher.branch(state, stack);
+    };
+
+    /// \brief Applies a move to the state and records its undo entry in a new trail frame.
+    ///
+    /// Works on any state with the SearchState move interface, FixedSearchState included.
+    template <typename StateType, typename TimeType, typename IndexType, typename CostType>
+    LEVIATHAN_FORCE_INLINE void apply_decision(StateType& state,
+                                               SearchTrail<SearchUndo<TimeType, IndexType, CostType>>& trail,
+                                               const SearchMove<TimeType, IndexType, CostType>& move)
+    {
+        trail.push_frame();
+        trail.emplace(SearchUndo<TimeType, IndexType, CostType>{
+            move.vessel,
+            move.berth,
+            state.berth_free_times[move.berth],
+            state.current_objective,
+            state.last_assigned_vessel
+        });
+        state.apply_move(move.vessel, move.berth, move.start_time, move.finish_time, move.cost_delta);
+    }
+
+    /// \brief Reverts the most recently applied move and calls `on_undo(undo)` once the state is restored.
+    template <typename StateType, typename TimeType, typename IndexType, typename CostType, typename OnUndo>
+        requires std::invocable<OnUndo&, const SearchUndo<TimeType, IndexType, CostType>&>
+    LEVIATHAN_FORCE_INLINE void backtrack_decision(StateType& state,
+                                                   SearchTrail<SearchUndo<TimeType, IndexType, CostType>>& trail,
+                                                   OnUndo&& on_undo)
+    {
+        trail.backtrack([&state, &on_undo](const SearchUndo<TimeType, IndexType, CostType>& undo)
+        {
+            state.backtrack_move(undo.vessel, undo.berth, undo.old_berth_free_time, undo.old_objective,
+                                 undo.old_last_vessel);
+            on_undo(undo);
+        });
+    }
+
+    /// \brief Reverts the most recently applied move by backtracking the top trail frame.
+    template <typename StateType, typename TimeType, typename IndexType, typename CostType>
+    LEVIATHAN_FORCE_INLINE void backtrack_decision(StateType& state,
+                                                   SearchTrail<SearchUndo<TimeType, IndexType, CostType>>& trail)
+    {
+        backtrack_decision(state, trail, [](const SearchUndo<TimeType, IndexType, CostType>&)
+        {
+        });
+    }
+}
+
+#endif // LEVIATHAN_BNB_SEARCH_MOVE_H_
@@ -0,0 +1,71 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include "leviathan/bnb/search_move.h"
+
+using Time = int64_t;
+using Index = int32_t;
+using Cost = double;
+using State = leviathan::bnb::SearchState<Time, Index, Cost>;
+using Move = leviathan::bnb::SearchMove<Time, Index, Cost>;
+using Undo = leviathan::bnb::SearchUndo<Time, Index, Cost>;
+using Trail = leviathan::bnb::SearchTrail<Undo>;
+
+TEST(SearchMoveTest, ApplyDecisionRecordsUndo)
+{
+    State state(2, 2);
+    Trail trail;
+
+    leviathan::bnb::apply_decision(state, trail, Move{1, 0, 5, 12, 7.0, 7.0});
+
+    EXPECT_EQ(trail.depth(), 1);
+    EXPECT_TRUE(state.is_assigned(1));
+    EXPECT_EQ(state.get_assigned_berth(1), 0);
+    EXPECT_EQ(state.get_start_time(1), 5);
+    EXPECT_EQ(state.berth_free_times[0], 12);
+    EXPECT_EQ(state.current_objective, 7.0);
+    EXPECT_EQ(state.last_assigned_vessel, 1);
+}
+
+TEST(SearchMoveTest, BacktrackDecisionRestoresState)
+{
+    State state(2, 3);
+    Trail trail;
+
+    leviathan::bnb::apply_decision(state, trail, Move{0, 1, 0, 10, 10.0, 10.0});
+    leviathan::bnb::apply_decision(state, trail, Move{2, 1, 10, 25, 20.0, 30.0});
+    EXPECT_EQ(state.berth_free_times[1], 25);
+    EXPECT_EQ(state.current_objective, 30.0);
+
+    leviathan::bnb::backtrack_decision(state, trail);
+    EXPECT_FALSE(state.is_assigned(2));
+    EXPECT_EQ(state.berth_free_times[1], 10);
+    EXPECT_EQ(state.current_objective, 10.0);
+    EXPECT_EQ(state.last_assigned_vessel, 0);
+
+    leviathan::bnb::backtrack_decision(state, trail);
+    EXPECT_FALSE(state.is_assigned(0));
+    EXPECT_EQ(state.berth_free_times[1], 0);
+    EXPECT_EQ(state.current_objective, 0.0);
+    EXPECT_EQ(state.last_assigned_vessel, State::kUnassignedVessel);
+    EXPECT_TRUE(trail.empty());
+}
@@ -22,6 +22,8 @@
 #ifndef LEVIATHAN_BNB_SEARCH_STACK_H_
 #define LEVIATHAN_BNB_SEARCH_STACK_H_
 
+#include <algorithm>
+#include <cstddef>
 #include <vector>
 #include <span>
 #include <concepts>
@@ -189,6 +191,89 @@ namespace leviathan::bnb
             return frames_.empty() ? 0 : entries_.size() - frames_.back();
         }
 
+        /// \brief Returns the total number of entries across all frames.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type size() const noexcept
+        {
+            return entries_.size();
+        }
+
+        /// \brief Returns a slice of all decisions in the frame at the given depth.
+        ///
+        /// Frame 0 is the bottom (root) frame; frame depth() - 1 is the current frame.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<T> frame_entries(const size_type frame_index) noexcept
+        {
+            DCHECK_LT(frame_index, frames_.size());
+            const size_type start = frames_[frame_index];
+            const size_type end = frame_index + 1 < frames_.size() ? frames_[frame_index + 1] : entries_.size();
+            return std::span<T>(entries_.data() + start, end - start);
+        }
+
+        /// \brief Returns a slice of all decisions in the frame at the given depth.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const T> frame_entries(const size_type frame_index) const noexcept
+        {
+            DCHECK_LT(frame_index, frames_.size());
+            const size_type start = frames_[frame_index];
+            const size_type end = frame_index + 1 < frames_.size() ? frames_[frame_index + 1] : entries_.size();
+            return std::span<const T>(entries_.data() + start, end - start);
+        }
+
+        /// \brief Removes a single decision from an arbitrary frame.
+        ///
+        /// Shifts all later entries down by one and rewrites the offsets of all frames above.
+        /// This is linear in the number of entries above the removed one and meant for rare
+        /// operations such as handing work to another worker, not for the hot loop.
+        ///
+        /// \param frame_index The depth of the frame (0 is the bottom frame).
+        /// \param offset The position of the entry within that frame.
+        LEVIATHAN_FORCE_INLINE void erase_entry(const size_type frame_index, const size_type offset)
+        {
+            DCHECK_LT(offset, frame_entries(frame_index).size());
+            entries_.erase(entries_.begin() + static_cast<std::ptrdiff_t>(frames_[frame_index] + offset));
+            for (size_type i = frame_index + 1; i < frames_.size(); ++i)
+            {
+                --frames_[i];
+            }
+        }
+
+        /// \brief Removes every decision that satisfies `pred`, in all frames.
+        ///
+        /// Used to drop all pending siblings that a new incumbent has made useless at once,
+        /// instead of popping and testing them one by one later. The entries tape is compacted
+        /// in place, keeping the order of the remaining decisions, and every frame offset is
+        /// rewritten in the same linear pass. Frames are kept even if they become empty, so the
+        /// depth still matches the caller's trail.
+        ///
+        /// \param pred Called once per decision; \c true removes it.
+        /// \return The number of removed decisions.
+        template <typename Predicate>
+            requires std::predicate<Predicate&, const T&>
+        LEVIATHAN_FORCE_INLINE size_type erase_if(Predicate pred)
+        {
+            size_type write = 0;
+            size_type read = 0;
+            for (size_type frame = 0; frame < frames_.size(); ++frame)
+            {
+                // Read the end of this frame before its successor's offset is rewritten.
+                const size_type end = frame + 1 < frames_.size() ? frames_[frame + 1] : entries_.size();
+                frames_[frame] = write;
+                for (; read < end; ++read)
+                {
+                    if (pred(std::as_const(entries_[read])))
+                    {
+                        continue;
+                    }
+                    if (write != read)
+                    {
+                        entries_[write] = std::move(entries_[read]);
+                    }
+                    ++write;
+                }
+            }
+            const size_type removed = entries_.size() - write;
+            entries_.erase(entries_.begin() + static_cast<std::ptrdiff_t>(write), entries_.end());
+            return removed;
+        }
+
         /// \brief Resets the entire stack while retaining allocated capacity.
         LEVIATHAN_FORCE_INLINE void clear() noexcept
         {
@@ -394,6 +479,35 @@ namespace leviathan::bnb
         std::vector<T> entries_;
         std::vector<size_type> frames_;
     };
+
+    /// \brief Default cap on the stack entries a solver reserves for its dives at construction.
+    ///
+    /// 65536 moves, a few megabytes for the usual move types. A dive that needs more grows the
+    /// stack once, and the stack keeps that capacity for every later search.
+    inline constexpr std::size_t kDiveReserveCap = std::size_t{1} << 16;
+
+    /// \brief Returns the most moves a depth-first dive over the assignment tree can keep on the stack.
+    ///
+    /// A frame at depth d holds at most one child per (unassigned vessel, berth) pair, so the
+    /// frames at depths 0..V-1 hold (V - d) * B children each and B * V * (V + 1) / 2 together.
+    /// That is O(B * V^2) even when the brancher's filters keep the frames small.
+    [[nodiscard]] constexpr std::size_t max_dive_entries(const std::size_t num_berths,
+                                                         const std::size_t num_vessels) noexcept
+    {
+        return std::max<std::size_t>(num_berths, 1) * num_vessels * (num_vessels + 1) / 2;
+    }
+
+    /// \brief Returns the stack entries a depth-first solver reserves at construction.
+    ///
+    /// \param max_dive Reserve max_dive_entries() in full, so that no search ever grows the stack.
+    ///        Otherwise the reservation is capped at kDiveReserveCap.
+    [[nodiscard]] constexpr std::size_t dive_reserve_entries(const std::size_t num_berths,
+                                                             const std::size_t num_vessels,
+                                                             const bool max_dive) noexcept
+    {
+        const std::size_t entries = max_dive_entries(num_berths, num_vessels);
+        return max_dive ? entries : std::min(entries, kDiveReserveCap);
+    }
 }
 
 #endif // LEVIATHAN_BNB_SEARCH_STACK_H_
@@ -0,0 +1,145 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include "leviathan/bnb/allocation_counter.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_stack.h"
+
+// Measures how fast SearchStack frames are filled, through the generator overload of
+// fill_frame() the solvers use and through extend() from a prepared range. One iteration
+// builds `depth` frames of `entries` moves each and then clears the stack. The erase_if()
+// benchmark sweeps such a stack once, dropping every other move as a new incumbent would.
+
+namespace
+{
+    using Move = leviathan::bnb::SearchMove<int64_t, int32_t, double>;
+    using Stack = leviathan::bnb::SearchStack<Move>;
+
+    std::vector<Move> make_children(const int64_t entries)
+    {
+        std::vector<Move> children;
+        children.reserve(static_cast<size_t>(entries));
+        for (int64_t i = 0; i < entries; ++i)
+        {
+            children.push_back(Move{static_cast<int32_t>(i), static_cast<int32_t>(i % 7), i, i + 10, 1.0,
+                                    static_cast<double>(i)});
+        }
+        return children;
+    }
+
+    void report(benchmark::State& state, const uint64_t bytes, const int64_t depth, const int64_t entries)
+    {
+        const int64_t ops = state.iterations() * depth * entries;
+        state.SetItemsProcessed(ops);
+        state.counters["bytes_per_op"] = static_cast<double>(bytes) / static_cast<double>(ops);
+    }
+
+    void BM_SearchStackFillFrame(benchmark::State& state)
+    {
+        const int64_t depth = state.range(0);
+        const int64_t entries = state.range(1);
+        const std::vector<Move> children = make_children(entries);
+        Stack stack;
+        stack.reserve(static_cast<size_t>(depth * entries), static_cast<size_t>(depth));
+
+        const uint64_t bytes_before = leviathan::bnb::testing::allocated_bytes();
+        for (auto _ : state)
+        {
+            for (int64_t d = 0; d < depth; ++d)
+            {
+                stack.fill_frame([&children](Stack& s)
+                {
+                    for (const Move& move : children)
+                    {
+                        s.push(move);
+                    }
+                });
+            }
+            benchmark::DoNotOptimize(stack.top());
+            stack.clear();
+        }
+        report(state, leviathan::bnb::testing::allocated_bytes() - bytes_before, depth, entries);
+    }
+
+    void BM_SearchStackExtend(benchmark::State& state)
+    {
+        const int64_t depth = state.range(0);
+        const int64_t entries = state.range(1);
+        const std::vector<Move> children = make_children(entries);
+        Stack stack;
+        stack.reserve(static_cast<size_t>(depth * entries), static_cast<size_t>(depth));
+
+        const uint64_t bytes_before = leviathan::bnb::testing::allocated_bytes();
+        for (auto _ : state)
+        {
+            for (int64_t d = 0; d < depth; ++d)
+            {
+                stack.push_frame();
+                stack.extend(children);
+            }
+            benchmark::DoNotOptimize(stack.top());
+            stack.clear();
+        }
+        report(state, leviathan::bnb::testing::allocated_bytes() - bytes_before, depth, entries);
+    }
+
+    void BM_SearchStackEraseIf(benchmark::State& state)
+    {
+        const int64_t depth = state.range(0);
+        const int64_t entries = state.range(1);
+        const std::vector<Move> children = make_children(entries);
+        Stack stack;
+        stack.reserve(static_cast<size_t>(depth * entries), static_cast<size_t>(depth));
+
+        const uint64_t bytes_before = leviathan::bnb::testing::allocated_bytes();
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            stack.clear();
+            for (int64_t d = 0; d < depth; ++d)
+            {
+                stack.push_frame();
+                stack.extend(children);
+            }
+            state.ResumeTiming();
+
+            const double incumbent = static_cast<double>(entries) / 2.0;
+            benchmark::DoNotOptimize(stack.erase_if([incumbent](const Move& move)
+            {
+                return move.lower_bound >= incumbent;
+            }));
+        }
+        report(state, leviathan::bnb::testing::allocated_bytes() - bytes_before, depth, entries);
+    }
+}
+
+BENCHMARK(BM_SearchStackFillFrame)
+    ->ArgNames({"depth", "entries"})
+    ->ArgsProduct({{50, 500, 2000}, {1, 16, 500}});
+BENCHMARK(BM_SearchStackExtend)
+    ->ArgNames({"depth", "entries"})
+    ->ArgsProduct({{50, 500, 2000}, {1, 16, 500}});
+BENCHMARK(BM_SearchStackEraseIf)
+    ->ArgNames({"depth", "entries"})
+    ->ArgsProduct({{50, 500, 2000}, {16, 500}});
@@ -21,6 +21,7 @@
 
 #include "leviathan/bnb/search_stack.h"
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <ranges>
 #include <vector>
 #include <array>
@@ -164,6 +165,40 @@ TEST(SearchStackTest, FillFrameWithCapacityHint)
     EXPECT_EQ(stack.current_frame_entries().size(), 1000);
 }
 
+TEST(SearchStackTest, FrameEntriesByIndex)
+{
+    leviathan::bnb::SearchStack<int> stack;
+    stack.fill_frame({1, 2, 3});
+    stack.fill_frame({4});
+    stack.fill_frame({5, 6});
+
+    EXPECT_EQ(stack.size(), 6);
+    ASSERT_EQ(stack.frame_entries(0).size(), 3);
+    EXPECT_EQ(stack.frame_entries(0)[2], 3);
+    ASSERT_EQ(stack.frame_entries(1).size(), 1);
+    EXPECT_EQ(stack.frame_entries(1)[0], 4);
+    ASSERT_EQ(stack.frame_entries(2).size(), 2);
+    EXPECT_EQ(stack.frame_entries(2)[0], 5);
+}
+
+TEST(SearchStackTest, EraseEntryShiftsUpperFrames)
+{
+    leviathan::bnb::SearchStack<int> stack;
+    stack.fill_frame({1, 2, 3});
+    stack.fill_frame({4, 5});
+
+    stack.erase_entry(0, 0);
+
+    EXPECT_EQ(stack.size(), 4);
+    ASSERT_EQ(stack.frame_entries(0).size(), 2);
+    EXPECT_EQ(stack.frame_entries(0)[0], 2);
+    ASSERT_EQ(stack.current_frame_size(), 2);
+    EXPECT_EQ(stack.current_frame_entries()[0], 4);
+
+    stack.pop_frame();
+    EXPECT_EQ(stack.top(), 3);
+}
+
 TEST(SearchStackTest, ClearRetainsMemory)
 {
     leviathan::bnb::SearchStack<int> stack(500, 50);
@@ -285,3 +320,62 @@ TEST(SearchStackTest, InitializerListSyntax)
     EXPECT_EQ(stack.current_frame_size(), 3);
     EXPECT_EQ(stack.top(), "Vessel3");
 }
+
+TEST(SearchStackTest, EraseIfCompactsAllFrames)
+{
+    leviathan::bnb::SearchStack<int> stack;
+    stack.fill_frame({1, 8, 2});
+    stack.fill_frame({9, 9});
+    stack.fill_frame({3, 7, 4, 9});
+    stack.fill_frame({5});
+
+    EXPECT_EQ(stack.erase_if([](const int value) { return value > 6; }), 5);
+
+    ASSERT_EQ(stack.depth(), 4);
+    EXPECT_EQ(stack.size(), 5);
+    EXPECT_TRUE(std::ranges::equal(stack.frame_entries(0), std::vector<int>{1, 2}));
+    EXPECT_TRUE(stack.frame_entries(1).empty());
+    EXPECT_TRUE(std::ranges::equal(stack.frame_entries(2), std::vector<int>{3, 4}));
+    EXPECT_TRUE(std::ranges::equal(stack.current_frame_entries(), std::vector<int>{5}));
+
+    // The stack keeps working normally afterwards.
+    stack.push(6);
+    stack.pop_frame();
+    stack.pop_frame();
+    EXPECT_TRUE(stack.frame_entries(1).empty());
+    EXPECT_EQ(stack.current_frame_size(), 0);
+    stack.pop_frame();
+    EXPECT_EQ(stack.top(), 2);
+}
+
+TEST(SearchStackTest, EraseIfWithoutMatchesKeepsEverything)
+{
+    leviathan::bnb::SearchStack<int> stack;
+    EXPECT_EQ(stack.erase_if([](int) { return true; }), 0);
+
+    stack.fill_frame({1, 2});
+    stack.fill_frame({});
+    stack.fill_frame({3});
+    EXPECT_EQ(stack.erase_if([](int) { return false; }), 0);
+    EXPECT_EQ(stack.size(), 3);
+    EXPECT_EQ(stack.frame_entries(2)[0], 3);
+
+    EXPECT_EQ(stack.erase_if([](int) { return true; }), 3);
+    EXPECT_EQ(stack.depth(), 3);
+    EXPECT_EQ(stack.size(), 0);
+}
+
+TEST(SearchStackTest, DiveReserveIsCappedUnlessRequested)
+{
+    using leviathan::bnb::dive_reserve_entries;
+    using leviathan::bnb::kDiveReserveCap;
+    using leviathan::bnb::max_dive_entries;
+
+    EXPECT_EQ(max_dive_entries(3, 4), 3u * 10u);
+    EXPECT_EQ(max_dive_entries(0, 4), 10u) << "a berthless instance still gets one child per vessel";
+    EXPECT_EQ(dive_reserve_entries(3, 4, false), 30u);
+
+    EXPECT_EQ(max_dive_entries(500, 100), 2'525'000u);
+    EXPECT_EQ(dive_reserve_entries(500, 100, false), kDiveReserveCap);
+    EXPECT_EQ(dive_reserve_entries(500, 100, true), 2'525'000u);
+}
@@ -22,10 +22,21 @@
 #ifndef LEVIATHAN_BNB_SEARCH_STATE_H_
 #define LEVIATHAN_BNB_SEARCH_STATE_H_
 
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
 #include <vector>
 #include <concepts>
 #include "absl/log/check.h"
 #include "leviathan/base/config.h"
+#include "leviathan/base/hash.h"
+#include "leviathan/base/varint.h"
+#include "leviathan/bnb/reversible_sparse_set.h"
+#include "leviathan/bnb/tournament_tree.h"
 
 namespace leviathan::bnb
 {
@@ -62,6 +73,7 @@ namespace leviathan::bnb
             berth_free_times.assign(num_berths, 0);
             vessel_assignments.assign(num_vessels, kUnassignedVessel);
             vessel_start_times.assign(num_vessels, 0);
+            assigned_bits_.assign(word_count(num_vessels), 0);
         }
 
         /// \brief Constructs a state from existing collections (e.g., a warm start).
@@ -77,6 +89,7 @@ namespace leviathan::bnb
               vessel_start_times(std::forward<StartTimes>(start_times))
         {
             DCHECK_EQ(vessel_assignments.size(), vessel_start_times.size());
+            rebuild_assigned_bits();
         }
 
         /// \brief Checks if a vessel is currently assigned to a berth.
@@ -126,11 +139,30 @@ namespace leviathan::bnb
         {
             DCHECK(!is_assigned(v_idx));
 
+            if (has_zobrist_hash())
+            {
+                zobrist_hash_ ^= zobrist_vessel_keys_[v_idx] ^ berth_hash_term(b_idx, berth_free_times[b_idx]) ^
+                    berth_hash_term(b_idx, finish_time);
+            }
             berth_free_times[b_idx] = finish_time;
+            if (has_berth_tree())
+            {
+                berth_tree_.update(b_idx, finish_time);
+            }
             vessel_assignments[v_idx] = b_idx;
+            assigned_bits_[static_cast<size_t>(v_idx) / 64] |= std::uint64_t{1} << (v_idx % 64);
+            if (has_unassigned_set())
+            {
+                unassigned_set_.remove(v_idx);
+            }
             vessel_start_times[v_idx] = start_time;
             current_objective += cost_delta;
             last_assigned_vessel = v_idx;
+            if (has_remaining_cost_bound())
+            {
+                set_bound_leaf(v_idx, false);
+                refresh_remaining_cost_bound();
+            }
         }
 
         /// \brief Backtracks a move (called by SearchTrail).
@@ -147,11 +179,683 @@ namespace leviathan::bnb
                                                    const TimeType old_berth_free_time, const CostType old_objective,
                                                    const IndexType old_last_vessel)
         {
+            if (has_zobrist_hash())
+            {
+                zobrist_hash_ ^= zobrist_vessel_keys_[v_idx] ^ berth_hash_term(b_idx, berth_free_times[b_idx]) ^
+                    berth_hash_term(b_idx, old_berth_free_time);
+            }
             berth_free_times[b_idx] = old_berth_free_time;
+            if (has_berth_tree())
+            {
+                berth_tree_.update(b_idx, old_berth_free_time);
+            }
             vessel_assignments[v_idx] = kUnassignedVessel;
+            assigned_bits_[static_cast<size_t>(v_idx) / 64] &= ~(std::uint64_t{1} << (v_idx % 64));
+            if (has_unassigned_set())
+            {
+                unassigned_set_.restore(v_idx);
+            }
             current_objective = old_objective;
             last_assigned_vessel = old_last_vessel;
+            if (has_remaining_cost_bound())
+            {
+                set_bound_leaf(v_idx, true);
+                refresh_remaining_cost_bound();
+            }
         }
+
+        /// \name Assigned vessel set
+        ///
+        /// Next to `vessel_assignments`, the state keeps the set of assigned vessels as packed
+        /// 64-bit words (bit v % 64 of word v / 64), updated by apply_move and backtrack_move.
+        /// Finding the unassigned vessels then touches one word per 64 vessels instead of every
+        /// assignment. Code that edits `vessel_assignments` directly must call
+        /// rebuild_assigned_bits() afterwards.
+        /// @{
+
+        /// \brief Returns the packed words of the assigned vessel set. Bits past the last vessel are zero.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const std::uint64_t> assigned_words() const noexcept
+        {
+            return assigned_bits_;
+        }
+
+        /// \brief Returns the number of berths.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_t num_berths() const noexcept
+        {
+            return berth_free_times.size();
+        }
+
+        /// \brief Returns the number of vessels.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_t num_vessels() const noexcept
+        {
+            return vessel_assignments.size();
+        }
+
+        /// \brief Returns the number of assigned vessels (a popcount per word).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_t num_assigned() const noexcept
+        {
+            size_t count = 0;
+            for (const std::uint64_t word : assigned_bits_)
+            {
+                count += static_cast<size_t>(std::popcount(word));
+            }
+            return count;
+        }
+
+        /// \brief Returns the number of vessels that still need a berth.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_t num_unassigned() const noexcept
+        {
+            if (has_unassigned_set())
+            {
+                return unassigned_set_.size();
+            }
+            return vessel_assignments.size() - num_assigned();
+        }
+
+        /// \brief Calls `f(v)` for every unassigned vessel.
+        ///
+        /// Vessels are visited in increasing index order, or in the order of the unassigned set
+        /// if it is enabled. If `f` returns \c bool, iteration stops at the first \c false.
+        ///
+        /// \return \c false if `f` stopped the iteration, \c true otherwise.
+        template <typename F>
+            requires std::invocable<F&, IndexType>
+        LEVIATHAN_FORCE_INLINE bool for_each_unassigned(F&& f) const
+        {
+            if (has_unassigned_set())
+            {
+                for (const IndexType v : unassigned_set_.values())
+                {
+                    if (!visit_unassigned(f, v))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            const size_t num_vessels = vessel_assignments.size();
+            for (size_t w = 0; w < assigned_bits_.size(); ++w)
+            {
+                std::uint64_t open = ~assigned_bits_[w];
+                if (w + 1 == assigned_bits_.size() && num_vessels % 64 != 0)
+                {
+                    open &= (std::uint64_t{1} << (num_vessels % 64)) - 1;
+                }
+                for (; open != 0; open &= open - 1)
+                {
+                    const auto v = static_cast<IndexType>(w * 64 + static_cast<size_t>(std::countr_zero(open)));
+                    if (!visit_unassigned(f, v))
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        /// \brief Rebuilds the assigned vessel set, and the unassigned set if enabled, from `vessel_assignments`.
+        void rebuild_assigned_bits()
+        {
+            if (has_unassigned_set())
+            {
+                build_unassigned_set();
+            }
+            assigned_bits_.assign(word_count(vessel_assignments.size()), 0);
+            for (size_t v = 0; v < vessel_assignments.size(); ++v)
+            {
+                if (vessel_assignments[v] != kUnassignedVessel)
+                {
+                    assigned_bits_[v / 64] |= std::uint64_t{1} << (v % 64);
+                }
+            }
+        }
+
+        /// @}
+
+        /// \name Unassigned vessel set
+        ///
+        /// Optionally, the state also keeps the unassigned vessels in a ReversibleSparseSet.
+        /// apply_move removes the vessel and backtrack_move restores it; since a search
+        /// backtracks in reverse order, restoring only moves the set's boundary back, and the
+        /// move itself is all the undo information the set needs. The order of the unassigned
+        /// vessels depends on the move history. for_each_unassigned then
+        /// touches exactly the remaining vessels, contiguously in memory, instead of one bit
+        /// per vessel.
+        /// @{
+
+        /// \brief Enables the unassigned vessel set and fills it from the current assignments.
+        void enable_unassigned_set()
+        {
+            unassigned_set_enabled_ = true;
+            build_unassigned_set();
+        }
+
+        /// \brief Returns true if the unassigned vessel set is maintained.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool has_unassigned_set() const noexcept
+        {
+            return unassigned_set_enabled_;
+        }
+
+        /// \brief Returns the unassigned vessels as a contiguous span, in no particular order.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::span<const IndexType> unassigned_vessels() const noexcept
+        {
+            DCHECK(has_unassigned_set());
+            return unassigned_set_.values();
+        }
+
+        /// @}
+
+        /// \name Berth tree
+        ///
+        /// Optionally, the state keeps a TournamentTree over `berth_free_times`, so the berth
+        /// that frees up first is known without scanning every berth. apply_move and
+        /// backtrack_move update one leaf in O(log berths); the old free time that
+        /// backtrack_move receives anyway is all the undo information needed. The remaining
+        /// cost bound reads its earliest free time from the tree when both are enabled.
+        /// Code that edits `berth_free_times` directly must call enable_berth_tree() again.
+        /// @{
+
+        /// \brief Enables the berth tree and builds it from the current free times.
+        void enable_berth_tree()
+        {
+            berth_tree_.assign(berth_free_times);
+            berth_tree_enabled_ = true;
+        }
+
+        /// \brief Returns true if the berth tree is maintained.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool has_berth_tree() const noexcept
+        {
+            return berth_tree_enabled_;
+        }
+
+        /// \brief Returns the berth with the earliest free time (the smallest index on ties), in O(1).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE IndexType earliest_free_berth() const noexcept
+        {
+            DCHECK(has_berth_tree());
+            return berth_tree_.min_index();
+        }
+
+        /// \brief Writes the `out.size()` berths that free up first to `out`, earliest first.
+        ///
+        /// \return The number of berths written, `min(out.size(), number of berths)`.
+        size_t earliest_free_berths(const std::span<IndexType> out) const
+        {
+            DCHECK(has_berth_tree());
+            return berth_tree_.smallest(out);
+        }
+
+        /// @}
+
+        /// \name Remaining cost bound
+        ///
+        /// Optionally, the state maintains a lower bound on the cost the unassigned vessels will
+        /// still add under the weighted flow time objective `weight * (finish - ready)`. No
+        /// vessel can start before the earliest berth free time t, nor finish faster than its
+        /// shortest processing time, so each unassigned vessel contributes
+        /// `weight * (min_processing + max(0, t - ready))`.
+        ///
+        /// The per-vessel constants live in a sum tree whose leaves are ordered by ready time, so
+        /// the total is the root's base cost plus `t * W - WR` over the prefix of vessels ready
+        /// before t. apply_move and backtrack_move update one leaf and rescan the berth free times,
+        /// which costs O(berths + log vessels). Because every inner node is recomputed from its
+        /// children, the bound depends only on the set of unassigned vessels and the free times and
+        /// is restored exactly by backtracking, without floating point drift.
+        /// @{
+
+        /// \brief Enables the remaining cost bound and builds it for the current assignments.
+        ///
+        /// \param ready_times The ready time of every vessel.
+        /// \param weights The non-negative cost weight of every vessel.
+        /// \param min_processing_times The shortest processing time of every vessel over all berths.
+        void enable_remaining_cost_bound(const std::span<const TimeType> ready_times,
+                                         const std::span<const CostType> weights,
+                                         const std::span<const TimeType> min_processing_times)
+        {
+            const size_t num_vessels = vessel_assignments.size();
+            DCHECK_EQ(ready_times.size(), num_vessels);
+            DCHECK_EQ(weights.size(), num_vessels);
+            DCHECK_EQ(min_processing_times.size(), num_vessels);
+
+            bound_leaf_count_ = std::max<size_t>(std::bit_ceil(num_vessels), 1);
+            bound_ready_times_.resize(num_vessels);
+            bound_leaf_of_.resize(num_vessels);
+            bound_terms_.resize(num_vessels);
+            bound_tree_.assign(2 * bound_leaf_count_, BoundSums{});
+
+            std::vector<IndexType> order(num_vessels);
+            for (size_t v = 0; v < num_vessels; ++v)
+            {
+                order[v] = static_cast<IndexType>(v);
+            }
+            std::ranges::stable_sort(order, [&ready_times](const IndexType a, const IndexType b)
+            {
+                return ready_times[a] < ready_times[b];
+            });
+
+            for (size_t position = 0; position < num_vessels; ++position)
+            {
+                const IndexType v = order[position];
+                const auto weight = static_cast<CostType>(weights[v]);
+                DCHECK_GE(weight, CostType{0});
+                bound_ready_times_[position] = ready_times[v];
+                bound_leaf_of_[v] = position;
+                bound_terms_[v] = BoundSums{
+                    weight,
+                    weight * static_cast<CostType>(ready_times[v]),
+                    weight * static_cast<CostType>(min_processing_times[v])
+                };
+                if (vessel_assignments[v] == kUnassignedVessel)
+                {
+                    bound_tree_[bound_leaf_count_ + position] = bound_terms_[v];
+                }
+            }
+            for (size_t node = bound_leaf_count_ - 1; node > 0; --node)
+            {
+                bound_tree_[node] = bound_tree_[2 * node] + bound_tree_[2 * node + 1];
+            }
+            refresh_remaining_cost_bound();
+        }
+
+        /// \brief Returns true if the remaining cost bound is maintained.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool has_remaining_cost_bound() const noexcept
+        {
+            return bound_leaf_count_ != 0;
+        }
+
+        /// \brief Returns the lower bound on the cost still to be added by the unassigned vessels.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType remaining_cost_bound() const noexcept
+        {
+            DCHECK(has_remaining_cost_bound());
+            return remaining_cost_bound_;
+        }
+
+        /// \brief Returns current_objective plus the remaining cost bound.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType lower_bound() const noexcept
+        {
+            return current_objective + remaining_cost_bound();
+        }
+
+        /// \brief Returns the contribution of an unassigned vessel to remaining_cost_bound().
+        ///
+        /// Subtracting it gives a valid bound for the other unassigned vessels in any child state,
+        /// since free times never decrease along a path. Branchers use this to bound a child in O(1).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType remaining_cost_term(const IndexType v_idx) const noexcept
+        {
+            DCHECK(has_remaining_cost_bound());
+            DCHECK(!is_assigned(v_idx));
+            const BoundSums& term = bound_terms_[v_idx];
+            if (bound_ready_times_[bound_leaf_of_[v_idx]] < earliest_berth_free_time_)
+            {
+                return term.base_cost +
+                    static_cast<CostType>(earliest_berth_free_time_) * term.weight - term.weighted_ready;
+            }
+            return term.base_cost;
+        }
+
+        /// @}
+
+        /// \name Zobrist hash
+        ///
+        /// Optionally, the state maintains a 64-bit hash of the set of assigned vessels and the
+        /// berth free times, which together determine every completion of the state. Every vessel
+        /// and every berth has a random key, and the hash is the XOR of the keys of the assigned
+        /// vessels and of one mixed (berth key, free time) term per berth. apply_move and
+        /// backtrack_move toggle one vessel key and replace one berth term, which is O(1).
+        ///
+        /// Start times, the objective and the move order are not hashed, so different orders that
+        /// reach the same assignment set and free times get the same hash.
+        /// @{
+
+        /// \brief Enables the Zobrist hash and computes it for the current state.
+        ///
+        /// \param seed Seed of the random keys. States hashed with different seeds are not comparable.
+        void enable_zobrist_hash(const std::uint64_t seed = 0)
+        {
+            std::uint64_t key = seed;
+            zobrist_vessel_keys_.resize(vessel_assignments.size());
+            for (std::uint64_t& vessel_key : zobrist_vessel_keys_)
+            {
+                vessel_key = leviathan::hash::mix64(key += leviathan::hash::kGoldenGamma);
+            }
+            zobrist_berth_keys_.resize(berth_free_times.size());
+            for (std::uint64_t& berth_key : zobrist_berth_keys_)
+            {
+                berth_key = leviathan::hash::mix64(key += leviathan::hash::kGoldenGamma);
+            }
+            zobrist_enabled_ = true;
+            zobrist_hash_ = compute_zobrist_hash();
+        }
+
+        /// \brief Returns true if the Zobrist hash is maintained.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool has_zobrist_hash() const noexcept
+        {
+            return zobrist_enabled_;
+        }
+
+        /// \brief Returns the incrementally maintained Zobrist hash.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::uint64_t zobrist_hash() const noexcept
+        {
+            DCHECK(has_zobrist_hash());
+            return zobrist_hash_;
+        }
+
+        /// \brief Recomputes the Zobrist hash from scratch, in O(berths + vessels).
+        [[nodiscard]] std::uint64_t compute_zobrist_hash() const noexcept
+        {
+            DCHECK(has_zobrist_hash());
+            std::uint64_t hash = 0;
+            for (size_t v = 0; v < vessel_assignments.size(); ++v)
+            {
+                if (vessel_assignments[v] != kUnassignedVessel)
+                {
+                    hash ^= zobrist_vessel_keys_[v];
+                }
+            }
+            for (size_t b = 0; b < berth_free_times.size(); ++b)
+            {
+                hash ^= berth_hash_term(static_cast<IndexType>(b), berth_free_times[b]);
+            }
+            return hash;
+        }
+
+        /// \brief Recomputes the maintained hash after the state was edited directly. Allocates nothing.
+        LEVIATHAN_FORCE_INLINE void refresh_zobrist_hash() noexcept
+        {
+            zobrist_hash_ = compute_zobrist_hash();
+        }
+
+        /// @}
+
+        /// \name Snapshots
+        ///
+        /// A snapshot is a compact byte image of the state, for shipping a node to another
+        /// worker without replaying its decision path. Integers are LEB128 varints, signed ones
+        /// zigzag-encoded:
+        ///
+        /// - number of berths, number of vessels, number of assigned vessels;
+        /// - `last_assigned_vessel`, then `current_objective` as raw bytes;
+        /// - the berth free times;
+        /// - for every assigned vessel in index order: the gap to the previous assigned
+        ///   vessel, its berth and its start time.
+        ///
+        /// Start times of unassigned vessels are not stored; like after backtrack_move, they
+        /// keep whatever value the restoring state had. The optional
+        /// structures (unassigned set, berth tree, remaining cost bound, Zobrist hash) are
+        /// not stored either; the restoring state rebuilds the ones it has enabled.
+        /// @{
+
+        /// \brief Returns a buffer size that fits the snapshot of any state of these dimensions.
+        [[nodiscard]] size_t max_snapshot_size() const noexcept
+        {
+            return (4 + berth_free_times.size() + 3 * vessel_assignments.size()) * leviathan::varint::kMaxBytes +
+                sizeof(CostType);
+        }
+
+        /// \brief Writes a snapshot of the state into `buffer`, which must hold max_snapshot_size() bytes.
+        ///
+        /// \return The number of bytes written.
+        size_t save_snapshot(const std::span<std::byte> buffer) const noexcept
+        {
+            DCHECK_GE(buffer.size(), max_snapshot_size());
+            std::byte* out = buffer.data();
+            out += leviathan::varint::encode(berth_free_times.size(), out);
+            out += leviathan::varint::encode(vessel_assignments.size(), out);
+            out += leviathan::varint::encode(num_assigned(), out);
+            out += leviathan::varint::encode(leviathan::varint::zigzag_encode(last_assigned_vessel), out);
+            std::memcpy(out, &current_objective, sizeof(CostType));
+            out += sizeof(CostType);
+            for (const TimeType free_time : berth_free_times)
+            {
+                out += leviathan::varint::encode(leviathan::varint::zigzag_encode(free_time), out);
+            }
+
+            size_t next = 0;
+            for (size_t w = 0; w < assigned_bits_.size(); ++w)
+            {
+                for (std::uint64_t word = assigned_bits_[w]; word != 0; word &= word - 1)
+                {
+                    const size_t v = w * 64 + static_cast<size_t>(std::countr_zero(word));
+                    out += leviathan::varint::encode(v - next, out);
+                    out += leviathan::varint::encode(static_cast<std::uint64_t>(vessel_assignments[v]), out);
+                    out += leviathan::varint::encode(leviathan::varint::zigzag_encode(vessel_start_times[v]), out);
+                    next = v + 1;
+                }
+            }
+            return static_cast<size_t>(out - buffer.data());
+        }
+
+        /// \brief Restores the state from a snapshot taken of a state with the same dimensions.
+        ///
+        /// Reuses the existing storage and does not allocate. Enabled optional structures are
+        /// rebuilt from the restored values, which costs O(berths + vessels).
+        ///
+        /// A snapshot is malformed if it is truncated, names a berth or vessel out of range, or
+        /// has a last assigned vessel that is neither kUnassignedVessel nor an assigned vessel.
+        ///
+        /// \return false if the snapshot is malformed or has other dimensions. The state is
+        ///         unspecified afterwards and must be restored again before it is used.
+        bool restore_snapshot(const std::span<const std::byte> snapshot)
+        {
+            const size_t num_berths = berth_free_times.size();
+            const size_t num_vessels = vessel_assignments.size();
+            const std::byte* cursor = snapshot.data();
+            const std::byte* const end = cursor + snapshot.size();
+            std::uint64_t berths = 0;
+            std::uint64_t vessels = 0;
+            std::uint64_t assigned = 0;
+            std::uint64_t last = 0;
+            if (!leviathan::varint::decode(cursor, end, berths) || berths != num_berths ||
+                !leviathan::varint::decode(cursor, end, vessels) || vessels != num_vessels ||
+                !leviathan::varint::decode(cursor, end, assigned) || assigned > num_vessels ||
+                !leviathan::varint::decode(cursor, end, last) ||
+                static_cast<size_t>(end - cursor) < sizeof(CostType))
+            {
+                return false;
+            }
+            const std::int64_t last_vessel = leviathan::varint::zigzag_decode(last);
+            std::memcpy(&current_objective, cursor, sizeof(CostType));
+            cursor += sizeof(CostType);
+
+            std::uint64_t value = 0;
+            for (TimeType& free_time : berth_free_times)
+            {
+                if (!leviathan::varint::decode(cursor, end, value))
+                {
+                    return false;
+                }
+                free_time = static_cast<TimeType>(leviathan::varint::zigzag_decode(value));
+            }
+
+            std::ranges::fill(vessel_assignments, kUnassignedVessel);
+            std::ranges::fill(assigned_bits_, std::uint64_t{0});
+            size_t next = 0;
+            for (std::uint64_t i = 0; i < assigned; ++i)
+            {
+                std::uint64_t gap = 0;
+                std::uint64_t berth = 0;
+                if (!leviathan::varint::decode(cursor, end, gap) || gap >= num_vessels - next ||
+                    !leviathan::varint::decode(cursor, end, berth) || berth >= num_berths ||
+                    !leviathan::varint::decode(cursor, end, value))
+                {
+                    return false;
+                }
+                const size_t v = next + gap;
+                vessel_assignments[v] = static_cast<IndexType>(berth);
+                vessel_start_times[v] = static_cast<TimeType>(leviathan::varint::zigzag_decode(value));
+                assigned_bits_[v / 64] |= std::uint64_t{1} << (v % 64);
+                next = v + 1;
+            }
+            if (last_vessel != kUnassignedVessel &&
+                (last_vessel < 0 || static_cast<std::uint64_t>(last_vessel) >= num_vessels ||
+                    vessel_assignments[static_cast<size_t>(last_vessel)] == kUnassignedVessel))
+            {
+                return false;
+            }
+            last_assigned_vessel = static_cast<IndexType>(last_vessel);
+
+            rebuild_optional_structures();
+            return true;
+        }
+
+        /// @}
+
+    private:
+        void rebuild_optional_structures()
+        {
+            if (has_unassigned_set())
+            {
+                build_unassigned_set();
+            }
+            if (has_berth_tree())
+            {
+                berth_tree_.assign(berth_free_times);
+            }
+            if (has_remaining_cost_bound())
+            {
+                for (size_t v = 0; v < vessel_assignments.size(); ++v)
+                {
+                    bound_tree_[bound_leaf_count_ + bound_leaf_of_[v]] =
+                        vessel_assignments[v] == kUnassignedVessel ? bound_terms_[v] : BoundSums{};
+                }
+                for (size_t node = bound_leaf_count_ - 1; node > 0; --node)
+                {
+                    bound_tree_[node] = bound_tree_[2 * node] + bound_tree_[2 * node + 1];
+                }
+                refresh_remaining_cost_bound();
+            }
+            if (has_zobrist_hash())
+            {
+                zobrist_hash_ = compute_zobrist_hash();
+            }
+        }
+
+        template <typename F>
+        static LEVIATHAN_FORCE_INLINE bool visit_unassigned(F& f, const IndexType v)
+        {
+            if constexpr (std::is_same_v<std::invoke_result_t<F&, IndexType>, bool>)
+            {
+                return f(v);
+            }
+            else
+            {
+                f(v);
+                return true;
+            }
+        }
+
+        void build_unassigned_set()
+        {
+            if (unassigned_set_.universe() == vessel_assignments.size())
+            {
+                unassigned_set_.reset();
+            }
+            else
+            {
+                unassigned_set_ = ReversibleSparseSet<IndexType>(vessel_assignments.size());
+            }
+            for (size_t v = 0; v < vessel_assignments.size(); ++v)
+            {
+                if (vessel_assignments[v] != kUnassignedVessel)
+                {
+                    unassigned_set_.remove(static_cast<IndexType>(v));
+                }
+            }
+        }
+
+        [[nodiscard]] static LEVIATHAN_FORCE_INLINE size_t word_count(const size_t num_vessels) noexcept
+        {
+            return (num_vessels + 63) / 64;
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::uint64_t berth_hash_term(const IndexType b_idx,
+                                                                           const TimeType free_time) const noexcept
+        {
+            return leviathan::hash::mix64(zobrist_berth_keys_[b_idx] ^ static_cast<std::uint64_t>(free_time));
+        }
+
+        /// \brief Sums over a set of vessels: weights, weighted ready times and weighted best-case costs.
+        struct BoundSums
+        {
+            CostType weight = 0;
+            CostType weighted_ready = 0;
+            CostType base_cost = 0;
+
+            [[nodiscard]] LEVIATHAN_FORCE_INLINE friend BoundSums operator+(const BoundSums& a,
+                                                                            const BoundSums& b) noexcept
+            {
+                return BoundSums{a.weight + b.weight, a.weighted_ready + b.weighted_ready, a.base_cost + b.base_cost};
+            }
+        };
+
+        LEVIATHAN_FORCE_INLINE void set_bound_leaf(const IndexType v_idx, const bool unassigned) noexcept
+        {
+            size_t node = bound_leaf_count_ + bound_leaf_of_[v_idx];
+            bound_tree_[node] = unassigned ? bound_terms_[v_idx] : BoundSums{};
+            for (node /= 2; node > 0; node /= 2)
+            {
+                bound_tree_[node] = bound_tree_[2 * node] + bound_tree_[2 * node + 1];
+            }
+        }
+
+        LEVIATHAN_FORCE_INLINE void refresh_remaining_cost_bound() noexcept
+        {
+            if (berth_free_times.empty())
+            {
+                earliest_berth_free_time_ = TimeType{0};
+            }
+            else
+            {
+                earliest_berth_free_time_ = has_berth_tree()
+                                                ? berth_tree_.min_value()
+                                                : std::ranges::min(berth_free_times);
+            }
+
+            // Vessels ready strictly before the earliest free time have to wait for a berth.
+            const auto waiting = static_cast<size_t>(std::ranges::lower_bound(
+                bound_ready_times_, earliest_berth_free_time_) - bound_ready_times_.begin());
+
+            BoundSums prefix{};
+            size_t lo = bound_leaf_count_;
+            size_t hi = bound_leaf_count_ + waiting;
+            while (lo < hi)
+            {
+                if (lo & 1)
+                {
+                    prefix = prefix + bound_tree_[lo++];
+                }
+                if (hi & 1)
+                {
+                    prefix = prefix + bound_tree_[--hi];
+                }
+                lo /= 2;
+                hi /= 2;
+            }
+
+            remaining_cost_bound_ = bound_tree_[1].base_cost +
+                static_cast<CostType>(earliest_berth_free_time_) * prefix.weight - prefix.weighted_ready;
+        }
+
+        std::vector<std::uint64_t> assigned_bits_;
+
+        bool berth_tree_enabled_ = false;
+        TournamentTree<TimeType, IndexType> berth_tree_;
+
+        bool unassigned_set_enabled_ = false;
+        ReversibleSparseSet<IndexType> unassigned_set_;
+
+        size_t bound_leaf_count_ = 0;
+        std::vector<TimeType> bound_ready_times_;
+        std::vector<size_t> bound_leaf_of_;
+        std::vector<BoundSums> bound_terms_;
+        std::vector<BoundSums> bound_tree_;
+        TimeType earliest_berth_free_time_ = 0;
+        CostType remaining_cost_bound_ = 0;
+
+        bool zobrist_enabled_ = false;
+        std::uint64_t zobrist_hash_ = 0;
+        std::vector<std::uint64_t> zobrist_vessel_keys_;
+        std::vector<std::uint64_t> zobrist_berth_keys_;
     };
 }
 
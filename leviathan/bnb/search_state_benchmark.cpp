@@ -0,0 +1,235 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "leviathan/bnb/fixed_search_state.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_state.h"
+
+// Measures the ways a worker can take over a node `depth` decisions below the root of a
+// 16-berth, 512-vessel instance: replaying the decision path onto a copy of the root,
+// restoring a snapshot of the node, and copy-assigning the node itself. With `bound` set,
+// both states maintain the remaining cost bound, as the solvers' states usually do; replay
+// then pays for it on every move and restore once per node.
+//
+// The dive and copy benchmarks compare SearchState with FixedSearchState on an 8-berth,
+// 48-vessel instance. One dive assigns the first unassigned vessel to the earliest free
+// berth until every vessel is placed, then backtracks to the root; the copy benchmarks
+// copy-construct a half-assigned state, as handing a node to another worker does.
+
+namespace
+{
+    using State = leviathan::bnb::SearchState<int64_t, int32_t, double>;
+    using Move = leviathan::bnb::SearchMove<int64_t, int32_t, double>;
+
+    constexpr size_t kBerths = 16;
+    constexpr size_t kVessels = 512;
+
+    State make_root(const bool bounded)
+    {
+        State root(kBerths, kVessels);
+        if (bounded)
+        {
+            std::vector<int64_t> ready(kVessels);
+            std::vector<double> weights(kVessels);
+            std::vector<int64_t> min_processing(kVessels, 5);
+            for (size_t v = 0; v < kVessels; ++v)
+            {
+                ready[v] = static_cast<int64_t>(v * 37 % 1000);
+                weights[v] = 1.0 + static_cast<double>(v % 3);
+            }
+            root.enable_remaining_cost_bound(ready, weights, min_processing);
+        }
+        return root;
+    }
+
+    std::vector<Move> make_path(const int64_t depth)
+    {
+        std::mt19937 rng(7);
+        State state(kBerths, kVessels);
+        std::vector<Move> path;
+        for (int64_t i = 0; i < depth; ++i)
+        {
+            const auto v = static_cast<int32_t>(i * 7 % static_cast<int64_t>(kVessels));
+            const auto b = static_cast<int32_t>(rng() % kBerths);
+            const int64_t start = state.berth_free_times[b];
+            const int64_t finish = start + 5 + static_cast<int64_t>(rng() % 30);
+            const double delta = static_cast<double>(finish);
+            path.push_back(Move{v, b, start, finish, delta, state.current_objective + delta});
+            state.apply_move(v, b, start, finish, delta);
+        }
+        return path;
+    }
+
+    State replay(const State& root, const std::vector<Move>& path)
+    {
+        State state = root;
+        for (const Move& move : path)
+        {
+            state.apply_move(move.vessel, move.berth, move.start_time, move.finish_time, move.cost_delta);
+        }
+        return state;
+    }
+
+    template <typename DiveState>
+    void dive(benchmark::State& state)
+    {
+        constexpr size_t kDiveBerths = 8;
+        constexpr size_t kDiveVessels = 48;
+        struct Undo
+        {
+            int32_t vessel;
+            int32_t berth;
+            int64_t free_time;
+            double objective;
+            int32_t last;
+        };
+        DiveState node(kDiveBerths, kDiveVessels);
+        std::vector<Undo> trail;
+        trail.reserve(kDiveVessels);
+        for (auto _ : state)
+        {
+            for (size_t depth = 0; depth < kDiveVessels; ++depth)
+            {
+                int32_t vessel = -1;
+                node.for_each_unassigned([&vessel](const int32_t v)
+                {
+                    vessel = v;
+                    return false;
+                });
+                const auto berth = static_cast<int32_t>(
+                    std::ranges::min_element(node.berth_free_times) - node.berth_free_times.begin());
+                const int64_t start = node.berth_free_times[berth];
+                const int64_t finish = start + 3 + vessel % 11;
+                trail.push_back({vessel, berth, start, node.current_objective, node.last_assigned_vessel});
+                node.apply_move(vessel, berth, start, finish, static_cast<double>(finish));
+            }
+            benchmark::DoNotOptimize(node.current_objective);
+            while (!trail.empty())
+            {
+                const Undo& u = trail.back();
+                node.backtrack_move(u.vessel, u.berth, u.free_time, u.objective, u.last);
+                trail.pop_back();
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kDiveVessels));
+    }
+
+    void BM_SearchStateDive(benchmark::State& state)
+    {
+        dive<State>(state);
+    }
+
+    void BM_FixedSearchStateDive(benchmark::State& state)
+    {
+        dive<leviathan::bnb::FixedSearchState<8, 48, int64_t, int32_t, double>>(state);
+    }
+
+    template <typename CopyState>
+    void copy_construct(benchmark::State& state)
+    {
+        CopyState node(8, 48);
+        for (int32_t v = 0; v < 24; ++v)
+        {
+            node.apply_move(v, v % 8, v, v + 5, 1.0);
+        }
+        for (auto _ : state)
+        {
+            CopyState copy = node;
+            benchmark::DoNotOptimize(copy);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_SearchStateCopyConstruct(benchmark::State& state)
+    {
+        copy_construct<State>(state);
+    }
+
+    void BM_FixedSearchStateCopyConstruct(benchmark::State& state)
+    {
+        copy_construct<leviathan::bnb::FixedSearchState<8, 48, int64_t, int32_t, double>>(state);
+    }
+
+    void BM_SearchStateReplayPath(benchmark::State& state)
+    {
+        const std::vector<Move> path = make_path(state.range(0));
+        const State root = make_root(state.range(1) != 0);
+        State target = root;
+        for (auto _ : state)
+        {
+            target = root;
+            for (const Move& move : path)
+            {
+                target.apply_move(move.vessel, move.berth, move.start_time, move.finish_time, move.cost_delta);
+            }
+            benchmark::DoNotOptimize(target.current_objective);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_SearchStateSnapshotRestore(benchmark::State& state)
+    {
+        const State node = replay(make_root(state.range(1) != 0), make_path(state.range(0)));
+        State target = make_root(state.range(1) != 0);
+        std::vector<std::byte> buffer(node.max_snapshot_size());
+        size_t size = 0;
+        for (auto _ : state)
+        {
+            size = node.save_snapshot(buffer);
+            benchmark::DoNotOptimize(target.restore_snapshot(std::span(buffer).first(size)));
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.counters["snapshot_bytes"] = static_cast<double>(size);
+    }
+
+    void BM_SearchStateCopy(benchmark::State& state)
+    {
+        const State node = replay(make_root(state.range(1) != 0), make_path(state.range(0)));
+        State target = make_root(state.range(1) != 0);
+        for (auto _ : state)
+        {
+            target = node;
+            benchmark::DoNotOptimize(target.current_objective);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+BENCHMARK(BM_SearchStateReplayPath)
+    ->ArgNames({"depth", "bound"})
+    ->ArgsProduct({{16, 128, 512}, {0, 1}});
+BENCHMARK(BM_SearchStateSnapshotRestore)
+    ->ArgNames({"depth", "bound"})
+    ->ArgsProduct({{16, 128, 512}, {0, 1}});
+BENCHMARK(BM_SearchStateCopy)
+    ->ArgNames({"depth", "bound"})
+    ->ArgsProduct({{16, 128, 512}, {0, 1}});
+BENCHMARK(BM_SearchStateDive);
+BENCHMARK(BM_FixedSearchStateDive);
+BENCHMARK(BM_SearchStateCopyConstruct);
+BENCHMARK(BM_FixedSearchStateCopyConstruct);
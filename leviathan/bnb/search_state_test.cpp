@@ -20,7 +20,11 @@
 // WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <random>
 #include <vector>
+#include "leviathan/base/varint.h"
 #include "leviathan/bnb/search_state.h"
 
 // Standard types for BAP
@@ -113,6 +117,490 @@ TEST(SearchStateTest, SequentialMovesAndPartialBacktrack)
     EXPECT_EQ(state.last_assigned_vessel, 2);
 }
 
+namespace
+{
+    // Recomputes the remaining cost bound from its definition.
+    Cost reference_remaining_bound(const State& state, const std::vector<Time>& ready,
+                                   const std::vector<Cost>& weights, const std::vector<Time>& min_processing)
+    {
+        const Time earliest = *std::ranges::min_element(state.berth_free_times);
+        Cost total = 0;
+        for (size_t v = 0; v < ready.size(); ++v)
+        {
+            if (!state.is_assigned(static_cast<Index>(v)))
+            {
+                total += weights[v] * static_cast<Cost>(min_processing[v] + std::max<Time>(0, earliest - ready[v]));
+            }
+        }
+        return total;
+    }
+}
+
+TEST(SearchStateTest, RemainingCostBoundIsDisabledByDefault)
+{
+    const State state(2, 3);
+    EXPECT_FALSE(state.has_remaining_cost_bound());
+}
+
+TEST(SearchStateTest, RemainingCostBoundFollowsApplyAndBacktrack)
+{
+    constexpr size_t num_berths = 3;
+    constexpr size_t num_vessels = 9;
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<Time> time(0, 50);
+    std::uniform_int_distribution<int> weight(1, 5);
+
+    std::vector<Time> ready(num_vessels);
+    std::vector<Cost> weights(num_vessels);
+    std::vector<Time> min_processing(num_vessels);
+    for (size_t v = 0; v < num_vessels; ++v)
+    {
+        ready[v] = time(rng);
+        weights[v] = weight(rng) * 0.5;
+        min_processing[v] = time(rng) + 1;
+    }
+
+    State state(num_berths, num_vessels);
+    state.enable_remaining_cost_bound(ready, weights, min_processing);
+    ASSERT_TRUE(state.has_remaining_cost_bound());
+    const Cost root_bound = state.remaining_cost_bound();
+    EXPECT_DOUBLE_EQ(root_bound, reference_remaining_bound(state, ready, weights, min_processing));
+
+    struct Undo
+    {
+        Index vessel;
+        Index berth;
+        Time old_free;
+        Cost old_objective;
+        Index old_last;
+    };
+    std::vector<Undo> undo;
+    Time clock = 0;
+    for (Index v = 0; v < static_cast<Index>(num_vessels); ++v)
+    {
+        const auto b = static_cast<Index>(rng() % num_berths);
+        const Time start = std::max(ready[v], state.berth_free_times[b]);
+        const Time finish = start + min_processing[v] + (clock++ % 3);
+        const Cost term = state.remaining_cost_term(v);
+        const Cost before = state.remaining_cost_bound();
+
+        undo.push_back({v, b, state.berth_free_times[b], state.current_objective, state.last_assigned_vessel});
+        state.apply_move(v, b, start, finish, weights[v] * static_cast<Cost>(finish - ready[v]));
+
+        EXPECT_DOUBLE_EQ(state.remaining_cost_bound(), reference_remaining_bound(state, ready, weights, min_processing));
+        EXPECT_GE(state.remaining_cost_bound() + 1e-9, before - term);
+    }
+    EXPECT_EQ(state.remaining_cost_bound(), 0.0);
+
+    while (!undo.empty())
+    {
+        const Undo& u = undo.back();
+        state.backtrack_move(u.vessel, u.berth, u.old_free, u.old_objective, u.old_last);
+        undo.pop_back();
+        EXPECT_DOUBLE_EQ(state.remaining_cost_bound(), reference_remaining_bound(state, ready, weights, min_processing));
+    }
+    // Restored bit for bit, not just approximately.
+    EXPECT_EQ(state.remaining_cost_bound(), root_bound);
+    EXPECT_EQ(state.lower_bound(), root_bound);
+}
+
+TEST(SearchStateTest, RemainingCostBoundSkipsAlreadyAssignedVessels)
+{
+    State state(1, 2);
+    state.apply_move(0, 0, 0, 10, 10.0);
+    state.enable_remaining_cost_bound(std::vector<Time>{0, 4}, std::vector<Cost>{1.0, 2.0},
+                                      std::vector<Time>{10, 3});
+
+    // Vessel 1 waits from 4 until the berth frees at 10, then needs 3: 2 * (3 + 6).
+    EXPECT_DOUBLE_EQ(state.remaining_cost_bound(), 18.0);
+    EXPECT_DOUBLE_EQ(state.lower_bound(), 28.0);
+}
+
+TEST(SearchStateTest, ZobristHashFollowsApplyAndBacktrack)
+{
+    constexpr size_t num_berths = 3;
+    constexpr size_t num_vessels = 8;
+    std::mt19937 rng(5);
+
+    State state(num_berths, num_vessels);
+    EXPECT_FALSE(state.has_zobrist_hash());
+    state.enable_zobrist_hash();
+    ASSERT_TRUE(state.has_zobrist_hash());
+    const uint64_t root_hash = state.zobrist_hash();
+
+    struct Undo
+    {
+        Index vessel;
+        Index berth;
+        Time old_free;
+        Cost old_objective;
+        Index old_last;
+    };
+    std::vector<Undo> undo;
+    std::vector<uint64_t> hashes;
+    for (Index v = 0; v < static_cast<Index>(num_vessels); ++v)
+    {
+        const auto b = static_cast<Index>(rng() % num_berths);
+        const Time start = state.berth_free_times[b] + static_cast<Time>(rng() % 4);
+        undo.push_back({v, b, state.berth_free_times[b], state.current_objective, state.last_assigned_vessel});
+        hashes.push_back(state.zobrist_hash());
+        state.apply_move(v, b, start, start + 5, 1.0);
+        EXPECT_EQ(state.zobrist_hash(), state.compute_zobrist_hash());
+        EXPECT_NE(state.zobrist_hash(), hashes.back());
+    }
+
+    while (!undo.empty())
+    {
+        const Undo& u = undo.back();
+        state.backtrack_move(u.vessel, u.berth, u.old_free, u.old_objective, u.old_last);
+        EXPECT_EQ(state.zobrist_hash(), hashes.back());
+        undo.pop_back();
+        hashes.pop_back();
+    }
+    EXPECT_EQ(state.zobrist_hash(), root_hash);
+}
+
+TEST(SearchStateTest, ZobristHashIgnoresMoveOrder)
+{
+    State a(2, 2);
+    State b(2, 2);
+    a.enable_zobrist_hash();
+    b.enable_zobrist_hash();
+    EXPECT_EQ(a.zobrist_hash(), b.zobrist_hash());
+
+    // Same assignment set and free times, reached in different orders with different objectives.
+    a.apply_move(0, 0, 0, 10, 10.0);
+    a.apply_move(1, 1, 0, 7, 7.0);
+    b.apply_move(1, 1, 2, 7, 5.0);
+    b.apply_move(0, 0, 3, 10, 20.0);
+    EXPECT_EQ(a.zobrist_hash(), b.zobrist_hash());
+
+    // A different free time or vessel set changes the hash.
+    State c(2, 2);
+    c.enable_zobrist_hash();
+    c.apply_move(0, 0, 0, 11, 11.0);
+    c.apply_move(1, 1, 0, 7, 7.0);
+    EXPECT_NE(a.zobrist_hash(), c.zobrist_hash());
+
+    State d(2, 2);
+    d.enable_zobrist_hash();
+    d.apply_move(0, 0, 0, 10, 10.0);
+    EXPECT_NE(a.zobrist_hash(), d.zobrist_hash());
+}
+
+TEST(SearchStateTest, AssignedSetFollowsApplyAndBacktrack)
+{
+    // 130 vessels span three words, the last one partially filled.
+    constexpr size_t num_vessels = 130;
+    State state(3, num_vessels);
+    ASSERT_EQ(state.assigned_words().size(), 3u);
+    EXPECT_EQ(state.num_unassigned(), num_vessels);
+
+    std::mt19937 rng(7);
+    std::vector<Index> order(num_vessels);
+    for (size_t v = 0; v < num_vessels; ++v)
+    {
+        order[v] = static_cast<Index>(v);
+    }
+    std::ranges::shuffle(order, rng);
+
+    struct Undo
+    {
+        Index vessel;
+        Index berth;
+        Time free_time;
+        Cost objective;
+        Index last;
+    };
+    std::vector<Undo> trail;
+    const auto check = [&]
+    {
+        std::vector<Index> expected;
+        for (Index v = 0; v < static_cast<Index>(num_vessels); ++v)
+        {
+            if (!state.is_assigned(v))
+            {
+                expected.push_back(v);
+            }
+        }
+        std::vector<Index> visited;
+        EXPECT_TRUE(state.for_each_unassigned([&](const Index v) { visited.push_back(v); }));
+        EXPECT_EQ(visited, expected);
+        EXPECT_EQ(state.num_unassigned(), expected.size());
+        EXPECT_EQ(state.num_assigned(), num_vessels - expected.size());
+    };
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        const Index v = order[i];
+        const auto b = static_cast<Index>(i % 3);
+        trail.push_back({v, b, state.berth_free_times[b], state.current_objective, state.last_assigned_vessel});
+        const Time start = state.berth_free_times[b];
+        state.apply_move(v, b, start, start + 1, 1.0);
+        if (i % 17 == 0)
+        {
+            check();
+        }
+    }
+    check();
+    while (!trail.empty())
+    {
+        const Undo& u = trail.back();
+        state.backtrack_move(u.vessel, u.berth, u.free_time, u.objective, u.last);
+        trail.pop_back();
+        if (trail.size() % 13 == 0)
+        {
+            check();
+        }
+    }
+    EXPECT_EQ(state.num_unassigned(), num_vessels);
+}
+
+TEST(SearchStateTest, ForEachUnassignedStopsWhenCallbackReturnsFalse)
+{
+    State state(1, 70);
+    state.apply_move(1, 0, 0, 1, 1.0);
+
+    std::vector<Index> visited;
+    const bool completed = state.for_each_unassigned([&](const Index v)
+    {
+        visited.push_back(v);
+        return v < 65;
+    });
+    EXPECT_FALSE(completed);
+    ASSERT_EQ(visited.size(), 65u);
+    EXPECT_EQ(visited.front(), 0);
+    EXPECT_EQ(visited[1], 2);
+    EXPECT_EQ(visited.back(), 65);
+}
+
+TEST(SearchStateTest, WarmStartBuildsAssignedSet)
+{
+    std::vector<Time> free_times{5, 0};
+    std::vector<Index> assignments(66, State::kUnassignedVessel);
+    std::vector<Time> starts(66, 0);
+    assignments[0] = 0;
+    assignments[65] = 0;
+    const State state(std::move(free_times), std::move(assignments), std::move(starts));
+
+    EXPECT_EQ(state.num_assigned(), 2u);
+    EXPECT_EQ(state.assigned_words()[0], std::uint64_t{1});
+    EXPECT_EQ(state.assigned_words()[1], std::uint64_t{2});
+}
+
+TEST(SearchStateTest, UnassignedSetFollowsApplyAndBacktrack)
+{
+    State state(2, 5);
+    state.apply_move(3, 0, 0, 4, 4.0);
+    EXPECT_FALSE(state.has_unassigned_set());
+    state.enable_unassigned_set();
+    ASSERT_TRUE(state.has_unassigned_set());
+
+    const auto sorted_unassigned = [&]
+    {
+        std::vector<Index> values(state.unassigned_vessels().begin(), state.unassigned_vessels().end());
+        std::ranges::sort(values);
+        return values;
+    };
+    EXPECT_EQ(sorted_unassigned(), (std::vector<Index>{0, 1, 2, 4}));
+
+    state.apply_move(1, 1, 0, 6, 6.0);
+    state.apply_move(4, 0, 4, 9, 9.0);
+    EXPECT_EQ(sorted_unassigned(), (std::vector<Index>{0, 2}));
+    EXPECT_EQ(state.num_unassigned(), 2u);
+
+    std::vector<Index> visited;
+    state.for_each_unassigned([&](const Index v) { visited.push_back(v); });
+    EXPECT_EQ(visited, std::vector<Index>(state.unassigned_vessels().begin(), state.unassigned_vessels().end()));
+
+    state.backtrack_move(4, 0, 4, 10.0, 1);
+    state.backtrack_move(1, 1, 0, 4.0, 3);
+    EXPECT_EQ(sorted_unassigned(), (std::vector<Index>{0, 1, 2, 4}));
+    EXPECT_EQ(state.num_unassigned(), 4u);
+}
+
+TEST(SearchStateTest, BerthTreeFollowsApplyAndBacktrack)
+{
+    State state(4, 4);
+    state.berth_free_times = {8, 3, 5, 3};
+    state.enable_berth_tree();
+    ASSERT_TRUE(state.has_berth_tree());
+    EXPECT_EQ(state.earliest_free_berth(), 1);
+
+    state.apply_move(0, 1, 3, 9, 9.0);
+    EXPECT_EQ(state.earliest_free_berth(), 3);
+    state.apply_move(1, 3, 3, 12, 12.0);
+    EXPECT_EQ(state.earliest_free_berth(), 2);
+
+    std::vector<Index> order(4);
+    ASSERT_EQ(state.earliest_free_berths(order), 4u);
+    EXPECT_EQ(order, (std::vector<Index>{2, 0, 1, 3}));
+    std::vector<Index> first_two(2);
+    ASSERT_EQ(state.earliest_free_berths(first_two), 2u);
+    EXPECT_EQ(first_two, (std::vector<Index>{2, 0}));
+
+    state.backtrack_move(1, 3, 3, 9.0, 0);
+    EXPECT_EQ(state.earliest_free_berth(), 3);
+    state.backtrack_move(0, 1, 3, 0.0, State::kUnassignedVessel);
+    EXPECT_EQ(state.earliest_free_berth(), 1);
+}
+
+TEST(SearchStateTest, RemainingCostBoundIsTheSameWithBerthTree)
+{
+    const std::vector<Time> ready{0, 4, 9, 2, 15};
+    const std::vector<Cost> weights{1.0, 2.0, 0.5, 3.0, 1.5};
+    const std::vector<Time> min_processing{3, 5, 2, 4, 6};
+    State plain(3, 5);
+    State treed(3, 5);
+    treed.enable_berth_tree();
+    for (State* s : {&plain, &treed})
+    {
+        s->enable_remaining_cost_bound(ready, weights, min_processing);
+    }
+
+    std::mt19937 rng(5);
+    for (Index v = 0; v < 5; ++v)
+    {
+        const auto b = static_cast<Index>(rng() % 3);
+        const Time start = std::max(ready[v], plain.berth_free_times[b]);
+        for (State* s : {&plain, &treed})
+        {
+            s->apply_move(v, b, start, start + min_processing[v] + 1, 1.0);
+        }
+        EXPECT_DOUBLE_EQ(treed.remaining_cost_bound(), plain.remaining_cost_bound());
+    }
+}
+
+TEST(SearchStateTest, SnapshotRoundTrip)
+{
+    // 70 vessels so the assigned set spans two words.
+    constexpr size_t num_vessels = 70;
+    State source(3, num_vessels);
+    source.berth_free_times = {-5, 0, 1000000};
+    std::mt19937 rng(17);
+    for (Index v = 0; v < static_cast<Index>(num_vessels); v += 3)
+    {
+        const auto b = static_cast<Index>(rng() % 3);
+        const Time start = source.berth_free_times[b];
+        source.apply_move(v, b, start, start + 1 + static_cast<Time>(rng() % 40), 0.25 * v);
+    }
+
+    std::vector<std::byte> buffer(source.max_snapshot_size());
+    const size_t size = source.save_snapshot(buffer);
+    EXPECT_LT(size, buffer.size());
+
+    State target(3, num_vessels);
+    target.apply_move(1, 0, 0, 3, 3.0);
+    const Index* assignments = target.vessel_assignments.data();
+    ASSERT_TRUE(target.restore_snapshot(std::span(buffer).first(size)));
+    EXPECT_EQ(target.vessel_assignments.data(), assignments);
+
+    EXPECT_EQ(target.berth_free_times, source.berth_free_times);
+    EXPECT_EQ(target.vessel_assignments, source.vessel_assignments);
+    EXPECT_EQ(target.last_assigned_vessel, source.last_assigned_vessel);
+    EXPECT_EQ(target.current_objective, source.current_objective);
+    EXPECT_EQ(target.num_unassigned(), source.num_unassigned());
+    for (Index v = 0; v < static_cast<Index>(num_vessels); ++v)
+    {
+        if (source.is_assigned(v))
+        {
+            EXPECT_EQ(target.get_start_time(v), source.get_start_time(v));
+        }
+    }
+}
+
+TEST(SearchStateTest, SnapshotRestoreRebuildsEnabledStructures)
+{
+    const std::vector<Time> ready{0, 4, 9, 2, 15};
+    const std::vector<Cost> weights{1.0, 2.0, 0.5, 3.0, 1.5};
+    const std::vector<Time> min_processing{3, 5, 2, 4, 6};
+    const auto enable_all = [&](State& s)
+    {
+        s.enable_remaining_cost_bound(ready, weights, min_processing);
+        s.enable_zobrist_hash();
+        s.enable_berth_tree();
+        s.enable_unassigned_set();
+    };
+
+    State source(2, 5);
+    enable_all(source);
+    source.apply_move(3, 1, 2, 8, 18.0);
+    source.apply_move(0, 0, 0, 3, 3.0);
+    std::vector<std::byte> buffer(source.max_snapshot_size());
+    const size_t size = source.save_snapshot(buffer);
+
+    State target(2, 5);
+    enable_all(target);
+    target.apply_move(4, 0, 15, 21, 9.0);
+    ASSERT_TRUE(target.restore_snapshot(std::span(buffer).first(size)));
+
+    EXPECT_DOUBLE_EQ(target.remaining_cost_bound(), source.remaining_cost_bound());
+    EXPECT_EQ(target.zobrist_hash(), source.zobrist_hash());
+    EXPECT_EQ(target.earliest_free_berth(), source.earliest_free_berth());
+    std::vector<Index> unassigned(target.unassigned_vessels().begin(), target.unassigned_vessels().end());
+    std::ranges::sort(unassigned);
+    EXPECT_EQ(unassigned, (std::vector<Index>{1, 2, 4}));
+
+    // The restored state keeps searching like the source.
+    for (State* s : {&source, &target})
+    {
+        s->apply_move(2, 0, 9, 11, 1.0);
+    }
+    EXPECT_DOUBLE_EQ(target.remaining_cost_bound(), source.remaining_cost_bound());
+    EXPECT_EQ(target.zobrist_hash(), source.zobrist_hash());
+}
+
+TEST(SearchStateTest, SnapshotRestoreRejectsBadInput)
+{
+    State source(2, 4);
+    source.apply_move(2, 1, 0, 5, 5.0);
+    std::vector<std::byte> buffer(source.max_snapshot_size());
+    const size_t size = source.save_snapshot(buffer);
+
+    State other_dimensions(2, 5);
+    EXPECT_FALSE(other_dimensions.restore_snapshot(std::span(buffer).first(size)));
+
+    State target(2, 4);
+    for (size_t cut = 0; cut < size; ++cut)
+    {
+        EXPECT_FALSE(target.restore_snapshot(std::span(buffer).first(cut))) << "cut " << cut;
+    }
+    EXPECT_TRUE(target.restore_snapshot(std::span(buffer).first(size)));
+    EXPECT_EQ(target.get_assigned_berth(2), 1);
+}
+
+TEST(SearchStateTest, SnapshotRestoreRejectsBadLastVessel)
+{
+    State source(2, 4);
+    source.apply_move(2, 1, 0, 5, 5.0);
+    std::vector<std::byte> buffer(source.max_snapshot_size());
+    const size_t size = source.save_snapshot(buffer);
+
+    // The header is berths, vessels, assigned count and the zigzag last vessel, one varint each.
+    constexpr size_t kLastOffset = 3;
+    const auto with_last = [&](const int64_t last)
+    {
+        std::vector<std::byte> patched(buffer.begin(), buffer.begin() + kLastOffset);
+        patched.resize(kLastOffset + leviathan::varint::kMaxBytes);
+        const size_t written = leviathan::varint::encode(leviathan::varint::zigzag_encode(last),
+                                                         patched.data() + kLastOffset);
+        patched.resize(kLastOffset + written);
+        patched.insert(patched.end(), buffer.begin() + kLastOffset + 1, buffer.begin() + size);
+        return patched;
+    };
+
+    State target(2, 4);
+    ASSERT_TRUE(target.restore_snapshot(with_last(2)));
+    EXPECT_EQ(target.last_assigned_vessel, 2);
+    ASSERT_TRUE(target.restore_snapshot(with_last(State::kUnassignedVessel)));
+    EXPECT_EQ(target.last_assigned_vessel, State::kUnassignedVessel);
+
+    EXPECT_FALSE(target.restore_snapshot(with_last(0))) << "vessel 0 is not assigned";
+    EXPECT_FALSE(target.restore_snapshot(with_last(4))) << "out of range";
+    EXPECT_FALSE(target.restore_snapshot(with_last(-2))) << "negative";
+    EXPECT_FALSE(target.restore_snapshot(with_last((int64_t{1} << 32) + 2))) << "narrows to vessel 2";
+}
+
 #ifndef NDEBUG
 TEST(SearchStateDeathTest, AccessUnassignedVessel)
 {
@@ -0,0 +1,76 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_SEARCH_STATISTICS_H_
+#define LEVIATHAN_BNB_SEARCH_STATISTICS_H_
+
+#include <cstdint>
+
+namespace leviathan::bnb
+{
+    /// \brief The outcome of a search.
+    enum class SearchStatus
+    {
+        /// The tree was exhausted and the incumbent is proven optimal.
+        kOptimal,
+        /// The tree was exhausted without finding a solution better than the initial upper bound.
+        kInfeasible,
+        /// The search stopped early; the incumbent is feasible but not proven optimal.
+        kFeasible,
+        /// The search stopped early without finding any solution.
+        kLimitReached,
+    };
+
+    /// \brief Counters collected while searching.
+    struct SearchStatistics
+    {
+        /// Number of moves applied (nodes entered).
+        std::uint64_t nodes = 0;
+        /// Number of stack entries discarded because their bound reached the incumbent.
+        std::uint64_t pruned = 0;
+        /// Number of improving solutions found.
+        std::uint64_t solutions = 0;
+        /// Maximum number of simultaneously applied moves.
+        std::uint64_t max_depth = 0;
+        /// Maximum number of simultaneously open nodes (best-first search only).
+        std::uint64_t max_open_nodes = 0;
+        /// Number of subtrees received from other workers (parallel search only).
+        std::uint64_t steals = 0;
+        /// Number of transposition table lookups (depth-first search with a table only).
+        std::uint64_t transposition_probes = 0;
+        /// Number of lookups that found the state already searched with an objective at least as good.
+        std::uint64_t transposition_hits = 0;
+        /// Bytes held by the transposition table.
+        std::uint64_t transposition_bytes = 0;
+        /// Number of entered nodes whose NodeBound reached the incumbent (depth-first search with a bound only).
+        std::uint64_t bound_cuts = 0;
+
+        /// \brief Returns the fraction of transposition table lookups that cut a subtree.
+        [[nodiscard]] double transposition_hit_rate() const noexcept
+        {
+            return transposition_probes == 0
+                       ? 0.0
+                       : static_cast<double>(transposition_hits) / static_cast<double>(transposition_probes);
+        }
+    };
+}
+
+#endif // LEVIATHAN_BNB_SEARCH_STATISTICS_H_
@@ -0,0 +1,82 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include "leviathan/bnb/allocation_counter.h"
+#include "leviathan/bnb/search_move.h"
+#include "leviathan/bnb/search_trail.h"
+
+// Measures SearchTrail::backtrack at realistic search depths. Only the unwinding is timed;
+// refilling the trail between iterations happens with the timer paused.
+
+namespace
+{
+    using Undo = leviathan::bnb::SearchUndo<int64_t, int32_t, double>;
+    using Trail = leviathan::bnb::SearchTrail<Undo>;
+
+    void fill(Trail& trail, const int64_t depth, const int64_t entries_per_frame)
+    {
+        for (int64_t d = 0; d < depth; ++d)
+        {
+            trail.push_frame();
+            for (int64_t e = 0; e < entries_per_frame; ++e)
+            {
+                trail.emplace(static_cast<int32_t>(d), static_cast<int32_t>(e), d, static_cast<double>(d),
+                              static_cast<int32_t>(d - 1));
+            }
+        }
+    }
+
+    void BM_SearchTrailBacktrack(benchmark::State& state)
+    {
+        const int64_t depth = state.range(0);
+        const int64_t entries_per_frame = state.range(1);
+        Trail trail(static_cast<size_t>(depth * entries_per_frame), static_cast<size_t>(depth));
+        int64_t checksum = 0;
+
+        const uint64_t bytes_before = leviathan::bnb::testing::allocated_bytes();
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            fill(trail, depth, entries_per_frame);
+            state.ResumeTiming();
+
+            while (!trail.empty())
+            {
+                trail.backtrack([&checksum](const Undo& undo)
+                {
+                    checksum += undo.old_berth_free_time;
+                });
+            }
+            benchmark::DoNotOptimize(checksum);
+        }
+        const uint64_t bytes = leviathan::bnb::testing::allocated_bytes() - bytes_before;
+
+        const int64_t ops = state.iterations() * depth;
+        state.SetItemsProcessed(ops);
+        state.counters["bytes_per_op"] = static_cast<double>(bytes) / static_cast<double>(ops);
+    }
+}
+
+BENCHMARK(BM_SearchTrailBacktrack)
+    ->ArgNames({"depth", "entries"})
+    ->ArgsProduct({{50, 200, 500, 2000}, {1, 8}});
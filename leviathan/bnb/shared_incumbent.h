@@ -0,0 +1,222 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_SHARED_INCUMBENT_H_
+#define LEVIATHAN_BNB_SHARED_INCUMBENT_H_
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <thread>
+#include <vector>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+#include "leviathan/bnb/search_state.h"
+
+namespace leviathan::bnb
+{
+    /// \brief A lock-free incumbent shared by any number of search threads.
+    ///
+    /// The objective is a single atomic that is lowered with compare-and-swap. Pruning only
+    /// needs objective(), which is one relaxed atomic load, and a stored improvement is visible
+    /// to every other core as soon as the cache line is invalidated.
+    ///
+    /// The schedule is kept in a sequence-numbered snapshot (a seqlock). Writers serialize on the
+    /// odd/even sequence, readers copy optimistically and retry if the sequence moved. A snapshot
+    /// is only overwritten by a strictly better schedule, so a slow writer can never replace a
+    /// newer incumbent with an older one.
+    template <typename TimeType, typename IndexType, typename CostType>
+    class SharedIncumbent
+    {
+    public:
+        using state_type = SearchState<TimeType, IndexType, CostType>;
+        using size_type = std::size_t;
+
+        static_assert(std::atomic<CostType>::is_always_lock_free,
+                      "SharedIncumbent requires a lock-free atomic CostType.");
+
+        static constexpr CostType kNoSolution = std::numeric_limits<CostType>::max();
+
+        /// \brief Constructs an empty incumbent.
+        ///
+        /// \param num_vessels The number of vessels of the instance.
+        /// \param upper_bound The initial objective; only strictly better schedules are accepted.
+        explicit SharedIncumbent(const size_type num_vessels, const CostType upper_bound = kNoSolution)
+            : assignments_(num_vessels),
+              start_times_(num_vessels)
+        {
+            reset(upper_bound);
+        }
+
+        SharedIncumbent(const SharedIncumbent&) = delete;
+        SharedIncumbent& operator=(const SharedIncumbent&) = delete;
+
+        /// \brief Returns the current objective bound. This is the hot-loop pruning check.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE CostType objective() const noexcept
+        {
+            return objective_.load(std::memory_order_relaxed);
+        }
+
+        /// \brief Returns the snapshot sequence number; it grows by two with every published schedule.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE std::uint64_t sequence() const noexcept
+        {
+            return sequence_.load(std::memory_order_acquire);
+        }
+
+        /// \brief Returns true if a schedule has been published since the last reset().
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool has_solution() const noexcept
+        {
+            return (sequence() >> 1) != 0;
+        }
+
+        /// \brief Lowers the objective bound without publishing a schedule.
+        ///
+        /// \return true if `objective` was strictly better than the current bound.
+        LEVIATHAN_FORCE_INLINE bool try_improve(const CostType objective) noexcept
+        {
+            CostType current = objective_.load(std::memory_order_relaxed);
+            while (objective < current)
+            {
+                if (objective_.compare_exchange_weak(current, objective, std::memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// \brief Offers a complete schedule; publishes it if it beats the current bound.
+        ///
+        /// \return true if the state became the new incumbent.
+        LEVIATHAN_FORCE_INLINE bool try_improve(const state_type& state)
+        {
+            return try_improve(state.current_objective, state.vessel_assignments, state.vessel_start_times);
+        }
+
+        /// \brief Offers a complete schedule given as flat arrays; publishes it if it beats the current bound.
+        ///
+        /// \param objective The objective of the schedule.
+        /// \param assignments The berth of every vessel.
+        /// \param start_times The start time of every vessel.
+        /// \return true if the schedule became the new incumbent.
+        bool try_improve(const CostType objective, const std::span<const IndexType> assignments,
+                         const std::span<const TimeType> start_times)
+        {
+            DCHECK_EQ(assignments.size(), assignments_.size());
+            DCHECK_EQ(start_times.size(), start_times_.size());
+            if (!try_improve(objective))
+            {
+                return false;
+            }
+
+            const std::uint64_t sequence = lock();
+            if (objective < snapshot_objective_.load(std::memory_order_relaxed))
+            {
+                for (size_type i = 0; i < assignments_.size(); ++i)
+                {
+                    assignments_[i].store(assignments[i], std::memory_order_relaxed);
+                    start_times_[i].store(start_times[i], std::memory_order_relaxed);
+                }
+                snapshot_objective_.store(objective, std::memory_order_relaxed);
+                sequence_.store(sequence + 2, std::memory_order_release);
+            }
+            else
+            {
+                // A better schedule was published while we were waiting for the lock.
+                sequence_.store(sequence, std::memory_order_release);
+            }
+            return true;
+        }
+
+        /// \brief Copies the latest published schedule.
+        ///
+        /// \param assignments Receives the berth of every vessel.
+        /// \param start_times Receives the start time of every vessel.
+        /// \return The objective of the copied schedule (kNoSolution-like bound if none was published).
+        CostType read(const std::span<IndexType> assignments, const std::span<TimeType> start_times) const
+        {
+            DCHECK_EQ(assignments.size(), assignments_.size());
+            DCHECK_EQ(start_times.size(), start_times_.size());
+            while (true)
+            {
+                const std::uint64_t before = sequence_.load(std::memory_order_acquire);
+                if (before & 1)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (size_type i = 0; i < assignments_.size(); ++i)
+                {
+                    assignments[i] = assignments_[i].load(std::memory_order_relaxed);
+                    start_times[i] = start_times_[i].load(std::memory_order_relaxed);
+                }
+                const CostType objective = snapshot_objective_.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence_.load(std::memory_order_relaxed) == before)
+                {
+                    return objective;
+                }
+            }
+        }
+
+        /// \brief Forgets the schedule and restarts from an upper bound.
+        ///
+        /// Not thread-safe: must not be called while a search uses the incumbent.
+        void reset(const CostType upper_bound = kNoSolution) noexcept
+        {
+            objective_.store(upper_bound, std::memory_order_relaxed);
+            snapshot_objective_.store(upper_bound, std::memory_order_relaxed);
+            for (size_type i = 0; i < assignments_.size(); ++i)
+            {
+                assignments_[i].store(state_type::kUnassignedVessel, std::memory_order_relaxed);
+                start_times_[i].store(0, std::memory_order_relaxed);
+            }
+            sequence_.store(0, std::memory_order_release);
+        }
+
+    private:
+        /// \brief Acquires the writer side of the seqlock and returns the (even) sequence it held.
+        std::uint64_t lock() noexcept
+        {
+            std::uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+            while (true)
+            {
+                if ((sequence & 1) == 0 &&
+                    sequence_.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire))
+                {
+                    std::atomic_thread_fence(std::memory_order_release);
+                    return sequence;
+                }
+                std::this_thread::yield();
+                sequence = sequence_.load(std::memory_order_relaxed);
+            }
+        }
+
+        alignas(LEVIATHAN_CACHE_LINE_SIZE) std::atomic<CostType> objective_;
+        alignas(LEVIATHAN_CACHE_LINE_SIZE) std::atomic<std::uint64_t> sequence_{0};
+        std::atomic<CostType> snapshot_objective_;
+        std::vector<std::atomic<IndexType>> assignments_;
+        std::vector<std::atomic<TimeType>> start_times_;
+    };
+}
+
+#endif // LEVIATHAN_BNB_SHARED_INCUMBENT_H_
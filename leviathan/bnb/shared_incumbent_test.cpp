@@ -0,0 +1,127 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "leviathan/bnb/shared_incumbent.h"
+
+using Time = int64_t;
+using Index = int32_t;
+using Cost = double;
+using State = leviathan::bnb::SearchState<Time, Index, Cost>;
+using Incumbent = leviathan::bnb::SharedIncumbent<Time, Index, Cost>;
+
+TEST(SharedIncumbentTest, InitialState)
+{
+    const Incumbent incumbent(3);
+    EXPECT_EQ(incumbent.objective(), Incumbent::kNoSolution);
+    EXPECT_FALSE(incumbent.has_solution());
+    EXPECT_EQ(incumbent.sequence(), 0);
+}
+
+TEST(SharedIncumbentTest, ObjectiveOnlyDecreases)
+{
+    Incumbent incumbent(1, 100.0);
+
+    EXPECT_TRUE(incumbent.try_improve(50.0));
+    EXPECT_FALSE(incumbent.try_improve(60.0));
+    EXPECT_FALSE(incumbent.try_improve(50.0));
+    EXPECT_EQ(incumbent.objective(), 50.0);
+
+    // Bound-only improvements do not publish a schedule.
+    EXPECT_FALSE(incumbent.has_solution());
+}
+
+TEST(SharedIncumbentTest, PublishAndReadSnapshot)
+{
+    Incumbent incumbent(2);
+    State state(2, 2);
+    state.apply_move(0, 1, 5, 10, 10.0);
+    state.apply_move(1, 0, 0, 7, 7.0);
+
+    ASSERT_TRUE(incumbent.try_improve(state));
+    EXPECT_TRUE(incumbent.has_solution());
+    EXPECT_EQ(incumbent.sequence(), 2);
+    EXPECT_EQ(incumbent.objective(), 17.0);
+
+    std::vector<Index> assignments(2);
+    std::vector<Time> start_times(2);
+    EXPECT_EQ(incumbent.read(assignments, start_times), 17.0);
+    EXPECT_EQ(assignments[0], 1);
+    EXPECT_EQ(assignments[1], 0);
+    EXPECT_EQ(start_times[0], 5);
+    EXPECT_EQ(start_times[1], 0);
+
+    // A worse schedule is rejected and leaves the snapshot untouched.
+    State worse(2, 2);
+    worse.apply_move(0, 0, 0, 50, 50.0);
+    worse.apply_move(1, 1, 0, 50, 50.0);
+    EXPECT_FALSE(incumbent.try_improve(worse));
+    EXPECT_EQ(incumbent.sequence(), 2);
+}
+
+TEST(SharedIncumbentTest, ResetForgetsSchedule)
+{
+    Incumbent incumbent(1);
+    State state(1, 1);
+    state.apply_move(0, 0, 0, 3, 3.0);
+    ASSERT_TRUE(incumbent.try_improve(state));
+
+    incumbent.reset(10.0);
+    EXPECT_FALSE(incumbent.has_solution());
+    EXPECT_EQ(incumbent.objective(), 10.0);
+}
+
+TEST(SharedIncumbentTest, ConcurrentImprovementsKeepBestSnapshot)
+{
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 200;
+    Incumbent incumbent(1);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&incumbent, t]
+        {
+            State state(kThreads, 1);
+            for (int i = kPerThread; i > 0; --i)
+            {
+                // Encode the objective in the start time so the snapshot can be checked for consistency.
+                const Cost objective = static_cast<Cost>(i * kThreads + t);
+                state.apply_move(0, t, static_cast<Time>(objective), static_cast<Time>(objective) + 1, objective);
+                incumbent.try_improve(state);
+                state.backtrack_move(0, t, 0, 0.0, State::kUnassignedVessel);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(incumbent.objective(), static_cast<Cost>(kThreads));
+    std::vector<Index> assignments(1);
+    std::vector<Time> start_times(1);
+    EXPECT_EQ(incumbent.read(assignments, start_times), static_cast<Cost>(kThreads));
+    EXPECT_EQ(assignments[0], 0);
+    EXPECT_EQ(start_times[0], kThreads);
+}
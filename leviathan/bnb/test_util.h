@@ -0,0 +1,184 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef LEVIATHAN_BNB_TEST_UTIL_H_
+#define LEVIATHAN_BNB_TEST_UTIL_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <random>
+#include <vector>
+#include "leviathan/bnb/berth_timeline.h"
+#include "leviathan/bnb/problem.h"
+#include "leviathan/bnb/search_move.h"
+
+namespace leviathan::bnb::testing
+{
+    using Time = int64_t;
+    using Index = int32_t;
+    using Cost = double;
+    using TestProblem = Problem<Time, Index, Cost>;
+
+    /// \brief Builds a small random instance with one maintenance gap per berth.
+    inline TestProblem make_random_problem(const uint32_t seed, const size_t num_vessels, const size_t num_berths)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<Time> ready_dist(0, 40);
+        std::uniform_int_distribution<Time> proc_dist(3, 15);
+        std::uniform_int_distribution<int> weight_dist(1, 4);
+        std::uniform_int_distribution<Time> gap_dist(10, 60);
+
+        std::vector<Time> ready(num_vessels);
+        std::vector<Cost> weights(num_vessels);
+        std::vector<Time> processing(num_vessels * num_berths);
+        for (size_t v = 0; v < num_vessels; ++v)
+        {
+            ready[v] = ready_dist(rng);
+            weights[v] = static_cast<Cost>(weight_dist(rng));
+            for (size_t b = 0; b < num_berths; ++b)
+            {
+                processing[v * num_berths + b] = proc_dist(rng);
+            }
+        }
+
+        std::vector<BerthTimeline<Time>> timelines;
+        for (size_t b = 0; b < num_berths; ++b)
+        {
+            const Time gap_start = gap_dist(rng);
+            std::vector<AvailableWindow<Time>> windows = {{0, gap_start}, {gap_start + 5, 100000}};
+            timelines.emplace_back(windows);
+        }
+
+        return TestProblem(std::move(ready), std::move(weights), std::move(processing), std::move(timelines));
+    }
+
+    namespace internal
+    {
+        inline void brute_force(const TestProblem& problem, std::vector<Time>& free_times,
+                                std::vector<bool>& assigned, const size_t remaining, const Cost objective,
+                                Cost& best)
+        {
+            if (remaining == 0)
+            {
+                best = std::min(best, objective);
+                return;
+            }
+            for (Index v = 0; v < static_cast<Index>(problem.num_vessels()); ++v)
+            {
+                if (assigned[v])
+                {
+                    continue;
+                }
+                for (Index b = 0; b < static_cast<Index>(problem.num_berths()); ++b)
+                {
+                    const Time duration = problem.processing_time(v, b);
+                    const std::optional<Time> start = problem.timeline(b).find_earliest_start(
+                        std::max(problem.ready_time(v), free_times[b]), duration);
+                    if (!start)
+                    {
+                        continue;
+                    }
+                    const Time old_free = free_times[b];
+                    free_times[b] = *start + duration;
+                    assigned[v] = true;
+                    brute_force(problem, free_times, assigned, remaining - 1,
+                                objective + problem.cost(v, *start + duration), best);
+                    assigned[v] = false;
+                    free_times[b] = old_free;
+                }
+            }
+        }
+    }
+
+    /// \brief Enumerates every vessel order and berth choice and returns the optimal objective.
+    inline Cost brute_force_optimum(const TestProblem& problem)
+    {
+        std::vector<Time> free_times(problem.num_berths(), 0);
+        std::vector<bool> assigned(problem.num_vessels(), false);
+        Cost best = std::numeric_limits<Cost>::max();
+        internal::brute_force(problem, free_times, assigned, problem.num_vessels(), 0.0, best);
+        return best;
+    }
+
+    /// \brief Enumerates every completion of a partial schedule and returns the optimal objective.
+    template <typename State>
+    Cost completion_optimum(const TestProblem& problem, const State& state)
+    {
+        std::vector<Time> free_times(state.berth_free_times.begin(), state.berth_free_times.end());
+        std::vector<bool> assigned(problem.num_vessels());
+        size_t remaining = 0;
+        for (Index v = 0; v < static_cast<Index>(problem.num_vessels()); ++v)
+        {
+            assigned[v] = state.is_assigned(v);
+            remaining += assigned[v] ? 0 : 1;
+        }
+        Cost best = std::numeric_limits<Cost>::max();
+        internal::brute_force(problem, free_times, assigned, remaining, state.current_objective, best);
+        return best;
+    }
+
+    /// \brief Picks a uniformly random feasible move for an unassigned vessel, or none if no vessel fits anywhere.
+    template <typename State>
+    std::optional<SearchMove<Time, Index, Cost>> random_move(const TestProblem& problem, const State& state,
+                                                             std::mt19937& rng)
+    {
+        std::vector<SearchMove<Time, Index, Cost>> moves;
+        for (Index v = 0; v < static_cast<Index>(problem.num_vessels()); ++v)
+        {
+            if (state.is_assigned(v))
+            {
+                continue;
+            }
+            for (Index b = 0; b < static_cast<Index>(problem.num_berths()); ++b)
+            {
+                const Time duration = problem.processing_time(v, b);
+                const std::optional<Time> start = problem.timeline(b).find_earliest_start(
+                    std::max(problem.ready_time(v), state.berth_free_times[b]), duration);
+                if (start)
+                {
+                    const Time finish = *start + duration;
+                    moves.push_back({v, b, *start, finish, problem.cost(v, finish), 0.0});
+                }
+            }
+        }
+        if (moves.empty())
+        {
+            return std::nullopt;
+        }
+        return moves[std::uniform_int_distribution<size_t>(0, moves.size() - 1)(rng)];
+    }
+
+    /// \brief Recomputes the objective of a complete schedule from scratch.
+    template <typename Assignments, typename StartTimes>
+    Cost evaluate_schedule(const TestProblem& problem, const Assignments& assignments, const StartTimes& start_times)
+    {
+        Cost total = 0.0;
+        for (Index v = 0; v < static_cast<Index>(problem.num_vessels()); ++v)
+        {
+            total += problem.cost(v, start_times[v] + problem.processing_time(v, assignments[v]));
+        }
+        return total;
+    }
+}
+
+#endif // LEVIATHAN_BNB_TEST_UTIL_H_
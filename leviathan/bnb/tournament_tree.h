@@ -0,0 +1,218 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef LEVIATHAN_BNB_TOURNAMENT_TREE_H_
+#define LEVIATHAN_BNB_TOURNAMENT_TREE_H_
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include "absl/log/check.h"
+#include "leviathan/base/config.h"
+
+namespace leviathan::bnb
+{
+    /// \brief A min tournament tree over an indexed array of values.
+    ///
+    /// The leaves are padded to a power of two and every internal node stores the index of
+    /// the smallest value below it, ties going to the smaller index. update() replays the
+    /// matches on one root path in O(log n), the minimum is read from the root in O(1), and
+    /// smallest() lists the k smallest values in O(k log n) by walking the tree best-first.
+    ///
+    /// The tree keeps its own copy of the values. Restoring an old value is just another
+    /// update(), so a search can undo changes without recording anything beyond the old value.
+    ///
+    /// \tparam T The value type. Padding leaves hold `std::numeric_limits<T>::max()`.
+    /// \tparam IndexType The integral type of the value indices.
+    template <typename T, std::integral IndexType = std::uint32_t>
+        requires std::totally_ordered<T>
+    class TournamentTree
+    {
+    public:
+        using value_type = T;
+        using index_type = IndexType;
+        using size_type = std::size_t;
+
+        TournamentTree() = default;
+
+        /// \brief Builds the tree over `values` in O(n).
+        explicit TournamentTree(const std::span<const T> values)
+        {
+            assign(values);
+        }
+
+        /// \brief Copies the tree; the copy reserves its own smallest() frontier.
+        TournamentTree(const TournamentTree& other)
+            : size_(other.size_),
+              leaf_count_(other.leaf_count_),
+              values_(other.values_),
+              winners_(other.winners_)
+        {
+            frontier_.reserve(leaf_count_);
+        }
+
+        /// \brief Copies the tree, reusing this tree's buffers where they are large enough.
+        TournamentTree& operator=(const TournamentTree& other)
+        {
+            size_ = other.size_;
+            leaf_count_ = other.leaf_count_;
+            values_ = other.values_;
+            winners_ = other.winners_;
+            frontier_.reserve(leaf_count_);
+            return *this;
+        }
+
+        TournamentTree(TournamentTree&&) noexcept = default;
+        TournamentTree& operator=(TournamentTree&&) noexcept = default;
+
+        /// \brief Rebuilds the tree over `values` in O(n).
+        void assign(const std::span<const T> values)
+        {
+            size_ = values.size();
+            leaf_count_ = std::bit_ceil(std::max<size_type>(size_, 1));
+            values_.assign(leaf_count_, std::numeric_limits<T>::max());
+            std::ranges::copy(values, values_.begin());
+            winners_.resize(2 * leaf_count_);
+            for (size_type i = 0; i < leaf_count_; ++i)
+            {
+                winners_[leaf_count_ + i] = static_cast<IndexType>(i);
+            }
+            for (size_type node = leaf_count_ - 1; node > 0; --node)
+            {
+                winners_[node] = play(winners_[2 * node], winners_[2 * node + 1]);
+            }
+            // The frontier of smallest() holds disjoint subtrees, so at most leaf_count_ of them.
+            frontier_.reserve(leaf_count_);
+        }
+
+        /// \brief Returns the number of values.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type size() const noexcept
+        {
+            return size_;
+        }
+
+        /// \brief Returns true if the tree holds no values.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        /// \brief Returns the value at `index`.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const T& value(const IndexType index) const noexcept
+        {
+            DCHECK_GE(index, 0);
+            DCHECK_LT(static_cast<size_type>(index), size_);
+            return values_[index];
+        }
+
+        /// \brief Sets the value at `index` and replays its matches up to the root.
+        LEVIATHAN_FORCE_INLINE void update(const IndexType index, const T& value) noexcept
+        {
+            DCHECK_GE(index, 0);
+            DCHECK_LT(static_cast<size_type>(index), size_);
+            values_[index] = value;
+            for (size_type node = (leaf_count_ + static_cast<size_type>(index)) / 2; node > 0; node /= 2)
+            {
+                winners_[node] = play(winners_[2 * node], winners_[2 * node + 1]);
+            }
+        }
+
+        /// \brief Returns the index of the smallest value (the smallest such index on ties).
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE IndexType min_index() const noexcept
+        {
+            DCHECK(!empty());
+            return winners_[1];
+        }
+
+        /// \brief Returns the smallest value.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE const T& min_value() const noexcept
+        {
+            DCHECK(!empty());
+            return values_[winners_[1]];
+        }
+
+        /// \brief Writes the indices of the `out.size()` smallest values to `out`, smallest first.
+        ///
+        /// Ties are ordered by index. Runs in O(k log n) and does not allocate, also on copies.
+        ///
+        /// \return The number of indices written, `min(out.size(), size())`.
+        size_type smallest(const std::span<IndexType> out) const
+        {
+            const size_type k = std::min(out.size(), size_);
+            if (k == 0)
+            {
+                return 0;
+            }
+            // Min-heap of subtree roots keyed by their winner. Popping a subtree reports its
+            // winner; the subtrees that lost to it on the way down become new candidates.
+            const auto later = [this](const size_type a, const size_type b)
+            {
+                return beats(winners_[b], winners_[a]);
+            };
+            out[0] = winners_[1];
+            frontier_.clear();
+            size_type node = 1;
+            for (size_type written = 1; written < k; ++written)
+            {
+                const IndexType winner = winners_[node];
+                while (node < leaf_count_)
+                {
+                    const size_type left = 2 * node;
+                    const bool winner_left = winners_[left] == winner;
+                    frontier_.push_back(winner_left ? left + 1 : left);
+                    std::ranges::push_heap(frontier_, later);
+                    node = winner_left ? left : left + 1;
+                }
+                std::ranges::pop_heap(frontier_, later);
+                node = frontier_.back();
+                frontier_.pop_back();
+                out[written] = winners_[node];
+            }
+            return k;
+        }
+
+    private:
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE bool beats(const IndexType a, const IndexType b) const noexcept
+        {
+            return values_[a] < values_[b] || (!(values_[b] < values_[a]) && a < b);
+        }
+
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE IndexType play(const IndexType left, const IndexType right) const noexcept
+        {
+            // Left leaves have smaller indices, so the left winner keeps ties.
+            return values_[right] < values_[left] ? right : left;
+        }
+
+        size_type size_ = 0;
+        size_type leaf_count_ = 0;
+        std::vector<T> values_;
+        std::vector<IndexType> winners_;
+        mutable std::vector<size_type> frontier_;
+    };
+}
+
+#endif // LEVIATHAN_BNB_TOURNAMENT_TREE_H_
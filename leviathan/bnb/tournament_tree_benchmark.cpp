@@ -0,0 +1,121 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "leviathan/bnb/tournament_tree.h"
+
+// Measures the earliest-free-berth query as a search would issue it: one berth's free time
+// moves forward, then the earliest berth is requested. The linear scan is what the state did
+// before it had a berth tree; the tree pays O(log berths) per update and O(1) per query.
+
+namespace
+{
+    using Tree = leviathan::bnb::TournamentTree<int64_t, int32_t>;
+
+    struct Updates
+    {
+        std::vector<int32_t> berths;
+        std::vector<int64_t> deltas;
+    };
+
+    Updates make_updates(const int64_t berths)
+    {
+        constexpr size_t kUpdates = 4096;
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int32_t> berth(0, static_cast<int32_t>(berths - 1));
+        std::uniform_int_distribution<int64_t> delta(1, 50);
+        Updates updates;
+        for (size_t i = 0; i < kUpdates; ++i)
+        {
+            updates.berths.push_back(berth(rng));
+            updates.deltas.push_back(delta(rng));
+        }
+        return updates;
+    }
+
+    void BM_EarliestBerthLinearScan(benchmark::State& state)
+    {
+        const int64_t berths = state.range(0);
+        const Updates updates = make_updates(berths);
+        std::vector<int64_t> free_times(static_cast<size_t>(berths), 0);
+
+        size_t i = 0;
+        for (auto _ : state)
+        {
+            const int32_t b = updates.berths[i];
+            free_times[b] += updates.deltas[i];
+            benchmark::DoNotOptimize(std::ranges::min_element(free_times) - free_times.begin());
+            i = (i + 1) % updates.berths.size();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_EarliestBerthTournamentTree(benchmark::State& state)
+    {
+        const int64_t berths = state.range(0);
+        const Updates updates = make_updates(berths);
+        std::vector<int64_t> free_times(static_cast<size_t>(berths), 0);
+        Tree tree(free_times);
+
+        size_t i = 0;
+        for (auto _ : state)
+        {
+            const int32_t b = updates.berths[i];
+            free_times[b] += updates.deltas[i];
+            tree.update(b, free_times[b]);
+            benchmark::DoNotOptimize(tree.min_index());
+            i = (i + 1) % updates.berths.size();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_TournamentTreeSmallest(benchmark::State& state)
+    {
+        const int64_t berths = state.range(0);
+        const int64_t k = state.range(1);
+        const Updates updates = make_updates(berths);
+        std::vector<int64_t> free_times(static_cast<size_t>(berths), 0);
+        Tree tree(free_times);
+        std::vector<int32_t> out(static_cast<size_t>(k));
+
+        size_t i = 0;
+        for (auto _ : state)
+        {
+            const int32_t b = updates.berths[i];
+            free_times[b] += updates.deltas[i];
+            tree.update(b, free_times[b]);
+            benchmark::DoNotOptimize(tree.smallest(out));
+            i = (i + 1) % updates.berths.size();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+BENCHMARK(BM_EarliestBerthLinearScan)->ArgName("berths")->Arg(8)->Arg(32)->Arg(128)->Arg(512);
+BENCHMARK(BM_EarliestBerthTournamentTree)->ArgName("berths")->Arg(8)->Arg(32)->Arg(128)->Arg(512);
+BENCHMARK(BM_TournamentTreeSmallest)
+    ->ArgNames({"berths", "k"})
+    ->ArgsProduct({{32, 128, 512}, {1, 4, 16}});
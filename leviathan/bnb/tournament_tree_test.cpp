@@ -0,0 +1,133 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "leviathan/bnb/allocation_counter.h"
+#include "leviathan/bnb/tournament_tree.h"
+
+using Tree = leviathan::bnb::TournamentTree<int64_t, int32_t>;
+
+namespace
+{
+    // Indices of the k smallest values, ties by index.
+    std::vector<int32_t> reference_smallest(const std::vector<int64_t>& values, const size_t k)
+    {
+        std::vector<int32_t> order(values.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::stable_sort(order, [&](const int32_t a, const int32_t b) { return values[a] < values[b]; });
+        order.resize(std::min(k, order.size()));
+        return order;
+    }
+}
+
+TEST(TournamentTreeTest, SingleValue)
+{
+    Tree tree(std::vector<int64_t>{7});
+    EXPECT_EQ(tree.size(), 1u);
+    EXPECT_EQ(tree.min_index(), 0);
+    EXPECT_EQ(tree.min_value(), 7);
+    tree.update(0, 3);
+    EXPECT_EQ(tree.min_value(), 3);
+    EXPECT_TRUE(Tree().empty());
+}
+
+TEST(TournamentTreeTest, TiesGoToTheSmallerIndex)
+{
+    Tree tree(std::vector<int64_t>{5, 2, 9, 2, 2});
+    EXPECT_EQ(tree.min_index(), 1);
+    tree.update(1, 4);
+    EXPECT_EQ(tree.min_index(), 3);
+
+    std::vector<int32_t> out(4);
+    ASSERT_EQ(tree.smallest(out), 4u);
+    EXPECT_EQ(out, (std::vector<int32_t>{3, 4, 1, 0}));
+}
+
+TEST(TournamentTreeTest, MatchesLinearScanUnderRandomUpdates)
+{
+    std::mt19937 rng(11);
+    for (const size_t n : {1u, 2u, 3u, 7u, 16u, 100u, 129u})
+    {
+        std::uniform_int_distribution<int64_t> value(0, 50);
+        std::vector<int64_t> values(n);
+        for (int64_t& v : values)
+        {
+            v = value(rng);
+        }
+        Tree tree(values);
+        std::vector<int32_t> out(n + 2);
+
+        for (int step = 0; step < 300; ++step)
+        {
+            const auto i = static_cast<int32_t>(rng() % n);
+            values[i] = value(rng);
+            tree.update(i, values[i]);
+
+            const auto expected_min = reference_smallest(values, 1);
+            ASSERT_EQ(tree.min_index(), expected_min[0]) << "n " << n << " step " << step;
+            ASSERT_EQ(tree.min_value(), values[expected_min[0]]);
+            ASSERT_EQ(tree.value(i), values[i]);
+
+            const size_t k = rng() % (n + 3);
+            const size_t written = tree.smallest(std::span(out).first(std::min(k, out.size())));
+            const auto expected = reference_smallest(values, std::min(k, out.size()));
+            ASSERT_EQ(written, expected.size());
+            ASSERT_TRUE(std::equal(expected.begin(), expected.end(), out.begin())) << "n " << n << " k " << k;
+        }
+    }
+}
+
+TEST(TournamentTreeTest, UpdateRestoresThePreviousWinner)
+{
+    const std::vector<int64_t> values{30, 10, 20, 40, 15, 25};
+    Tree tree(values);
+    tree.update(3, 5);
+    tree.update(0, 1);
+    EXPECT_EQ(tree.min_index(), 0);
+    tree.update(0, values[0]);
+    EXPECT_EQ(tree.min_index(), 3);
+    tree.update(3, values[3]);
+    EXPECT_EQ(tree.min_index(), 1);
+    EXPECT_EQ(tree.min_value(), 10);
+}
+
+TEST(TournamentTreeTest, CopiesListTheSmallestWithoutAllocating)
+{
+    const std::vector<int64_t> values{30, 10, 20, 40, 15, 25, 5, 35, 45};
+    const Tree original(values);
+    const Tree copied(original);
+    Tree assigned;
+    assigned = original;
+
+    std::vector<int32_t> out(values.size());
+    const uint64_t allocations = leviathan::bnb::testing::allocation_count();
+    ASSERT_EQ(copied.smallest(out), values.size());
+    EXPECT_EQ(out[0], 6);
+    ASSERT_EQ(assigned.smallest(out), values.size());
+    EXPECT_EQ(out[1], 1);
+    EXPECT_EQ(leviathan::bnb::testing::allocation_count(), allocations);
+}
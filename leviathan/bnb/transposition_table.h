@@ -0,0 +1,144 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef LEVIATHAN_BNB_TRANSPOSITION_TABLE_H_
+#define LEVIATHAN_BNB_TRANSPOSITION_TABLE_H_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "leviathan/base/config.h"
+#include "leviathan/base/hash.h"
+
+namespace leviathan::bnb
+{
+    /// \brief Fixed-size table of the best objective seen per search state signature.
+    ///
+    /// Different assignment orders often reach the same set of assigned vessels with the same
+    /// berth free times (see SearchState::zobrist_hash()). Those states have the same
+    /// completions, so once one of them has been searched, revisiting it with an objective that
+    /// is not better cannot lead to a better solution.
+    ///
+    /// The table is an array of cache-line sized buckets, so a lookup touches a single cache line.
+    /// A bucket holds as many (hash, objective) entries as fit; a new signature is inserted at the
+    /// front and the least recently stored entry of the bucket is evicted. The size is fixed at
+    /// construction and the table never allocates afterwards.
+    ///
+    /// Signatures are compared by their full 64-bit hash. A collision between different states
+    /// could cut a subtree that should have been searched, but with 64-bit Zobrist hashes that is
+    /// far less likely than a hardware fault.
+    ///
+    /// Keys are salted with a generation that clear() advances, so clearing costs O(1) instead of
+    /// a pass over the whole table: entries of earlier generations no longer match any lookup and
+    /// are evicted like any other entry.
+    ///
+    /// \tparam CostType The objective type.
+    template <typename CostType>
+    class TranspositionTable
+    {
+    public:
+        using size_type = std::size_t;
+
+        /// \brief One stored signature. A key of 0 marks an empty entry.
+        struct Entry
+        {
+            std::uint64_t key = 0;
+            CostType objective = CostType{0};
+        };
+
+        /// \brief Number of entries per bucket.
+        static constexpr size_type kWays = std::max<size_type>(LEVIATHAN_CACHE_LINE_SIZE / sizeof(Entry), 1);
+
+        /// \brief A cache line of entries, most recently stored first.
+        struct alignas(LEVIATHAN_CACHE_LINE_SIZE) Bucket
+        {
+            std::array<Entry, kWays> entries{};
+        };
+
+        /// \brief Allocates the largest power-of-two number of buckets that fits in `memory_bytes` (at least one).
+        explicit TranspositionTable(const size_type memory_bytes)
+            : buckets_(std::bit_floor(std::max<size_type>(memory_bytes / sizeof(Bucket), 1))),
+              mask_(buckets_.size() - 1)
+        {
+        }
+
+        /// \brief Looks up a state and records it unless it is dominated.
+        ///
+        /// \param hash The Zobrist hash of the state.
+        /// \param objective The objective of the partial schedule that reached the state.
+        /// \return \c true if the state was stored with an objective at most `objective`; its
+        ///         subtree can then be skipped. Otherwise the entry now holds `objective`.
+        LEVIATHAN_FORCE_INLINE bool probe_and_store(const std::uint64_t hash, const CostType objective) noexcept
+        {
+            const std::uint64_t salted = hash ^ generation_;
+            const std::uint64_t key = salted == 0 ? 1 : salted;
+            std::array<Entry, kWays>& entries = buckets_[hash & mask_].entries;
+
+            size_type way = 0;
+            while (way < kWays - 1 && entries[way].key != key)
+            {
+                ++way;
+            }
+            if (entries[way].key == key)
+            {
+                if (entries[way].objective <= objective)
+                {
+                    return true;
+                }
+            }
+            // Either a better objective for a known signature or a new one (evicting the last way).
+            std::move_backward(entries.begin(), entries.begin() + static_cast<std::ptrdiff_t>(way),
+                               entries.begin() + static_cast<std::ptrdiff_t>(way) + 1);
+            entries[0] = Entry{key, objective};
+            return false;
+        }
+
+        /// \brief Forgets every entry by starting a new generation; touches no bucket.
+        LEVIATHAN_FORCE_INLINE void clear() noexcept
+        {
+            generation_ += leviathan::hash::kGoldenGamma;
+        }
+
+        /// \brief Returns the number of entries the table can hold.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type capacity() const noexcept
+        {
+            return buckets_.size() * kWays;
+        }
+
+        /// \brief Returns the total bytes allocated by the table.
+        [[nodiscard]] LEVIATHAN_FORCE_INLINE size_type allocated_memory_bytes() const noexcept
+        {
+            return buckets_.capacity() * sizeof(Bucket);
+        }
+
+    private:
+        std::vector<Bucket> buckets_;
+        size_type mask_;
+        // Salt of the current generation; distinct for the first 2^64 clears since the gamma is odd.
+        std::uint64_t generation_ = 0;
+    };
+}
+
+#endif // LEVIATHAN_BNB_TRANSPOSITION_TABLE_H_
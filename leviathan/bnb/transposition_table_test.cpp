@@ -0,0 +1,101 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "leviathan/bnb/transposition_table.h"
+
+using Table = leviathan::bnb::TranspositionTable<double>;
+
+TEST(TranspositionTableTest, SizeIsAPowerOfTwoOfBuckets)
+{
+    static_assert(sizeof(Table::Bucket) == LEVIATHAN_CACHE_LINE_SIZE);
+
+    const Table table(10 * sizeof(Table::Bucket));
+    EXPECT_EQ(table.allocated_memory_bytes(), 8 * sizeof(Table::Bucket));
+    EXPECT_EQ(table.capacity(), 8 * Table::kWays);
+
+    const Table tiny(1);
+    EXPECT_EQ(tiny.capacity(), Table::kWays);
+}
+
+TEST(TranspositionTableTest, CutsOnlyDominatedRevisits)
+{
+    Table table(1 << 12);
+    EXPECT_FALSE(table.probe_and_store(42, 10.0));
+    EXPECT_TRUE(table.probe_and_store(42, 10.0));
+    EXPECT_TRUE(table.probe_and_store(42, 12.0));
+
+    // A cheaper revisit is searched and becomes the new reference.
+    EXPECT_FALSE(table.probe_and_store(42, 8.0));
+    EXPECT_TRUE(table.probe_and_store(42, 9.0));
+
+    EXPECT_FALSE(table.probe_and_store(43, 100.0));
+    EXPECT_FALSE(table.probe_and_store(0, 1.0));
+    EXPECT_TRUE(table.probe_and_store(0, 1.0));
+}
+
+TEST(TranspositionTableTest, EvictsTheOldestEntryOfAFullBucket)
+{
+    Table table(1);
+    for (std::uint64_t key = 1; key <= Table::kWays; ++key)
+    {
+        EXPECT_FALSE(table.probe_and_store(key, 1.0));
+    }
+    for (std::uint64_t key = 1; key <= Table::kWays; ++key)
+    {
+        EXPECT_TRUE(table.probe_and_store(key, 1.0));
+    }
+
+    EXPECT_FALSE(table.probe_and_store(Table::kWays + 1, 1.0));
+    EXPECT_FALSE(table.probe_and_store(1, 1.0)) << "the first entry was evicted";
+    EXPECT_TRUE(table.probe_and_store(Table::kWays + 1, 1.0));
+}
+
+TEST(TranspositionTableTest, ClearForgetsEverything)
+{
+    Table table(1 << 10);
+    EXPECT_FALSE(table.probe_and_store(7, 3.0));
+    table.clear();
+    EXPECT_FALSE(table.probe_and_store(7, 3.0));
+    EXPECT_TRUE(table.probe_and_store(7, 3.0)) << "the new generation keeps what it stores";
+}
+
+TEST(TranspositionTableTest, StaleEntriesAreEvictedAfterClear)
+{
+    Table table(sizeof(Table::Bucket));
+    for (size_t i = 0; i < Table::kWays; ++i)
+    {
+        EXPECT_FALSE(table.probe_and_store(i + 1, 1.0));
+    }
+    table.clear();
+
+    // A full bucket of stale entries takes a whole bucket of new ones.
+    for (size_t i = 0; i < Table::kWays; ++i)
+    {
+        EXPECT_FALSE(table.probe_and_store(i + 1, 1.0));
+    }
+    for (size_t i = 0; i < Table::kWays; ++i)
+    {
+        EXPECT_TRUE(table.probe_and_store(i + 1, 1.0));
+    }
+}